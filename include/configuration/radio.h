@@ -18,6 +18,19 @@
 #define UHF_TRANSPARENT_MODE_DATA_FIELD_1_LENGTH 1        // byte
 #define UHF_TRANSPARENT_MODE_DATA_FIELD_2_MAX_LENGTH 128  // bytes
 
+// Over the air, the radio frames each MPDU with a preamble, sync word and
+// length field in front and a CRC-16 and postamble behind
+#define UHF_PREAMBLE_LENGTH 16                            // bytes
+#define UHF_SYNCWORD_LENGTH 1                             // byte
+#define UHF_LENGTH_FIELD_LENGTH 1                         // byte
+#define UHF_CRC16_LENGTH 2                                // bytes
+#define UHF_POSTAMBLE_LENGTH 10                           // bytes
+#define UHF_FRAME_OVERHEAD_LENGTH (UHF_PREAMBLE_LENGTH + UHF_SYNCWORD_LENGTH + \
+  UHF_LENGTH_FIELD_LENGTH + UHF_CRC16_LENGTH + UHF_POSTAMBLE_LENGTH)
+
+// The MPDU header user packet length field is 12 bits
+#define MAC_MAX_USER_PACKET_LENGTH 4095                   // bytes
+
 // S-band Radio
 
 
@@ -26,6 +26,8 @@ typedef enum {
     FEC_STATE_ERROR,
 } fec_state_t;
 
+/* On a complete packet, *data is a block of sdr_packet_pool that the caller
+   must return with os_pool_free */
 int fec_mpdu_to_data(mac_t *my_mac, const uint8_t *mpdu, uint8_t **data, int mtu);
     
 mac_t *fec_create(rf_mode_number_t rfmode, error_correction_scheme_t error_correction_scheme);
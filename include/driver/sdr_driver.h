@@ -3,7 +3,9 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include "bufferPool.h"
 #include "osal.h"
+#include "radio.h"
 #include "sdr_sband.h"
 
 #ifdef __cplusplus
@@ -24,6 +26,37 @@ typedef enum {
 #define SDR_UHF_MAX_MTU 128
 #define SDR_SBAND_MAX_MTU 128
 
+/* Received MPDUs and reassembled packets are held in static pools. The ISR
+   of each interface assembles an MPDU in a pool buffer and queues a pointer
+   to it for the RX task, which returns the buffer to the pool once decoded.
+   Up to SDR_RX_QUEUE_DEPTH MPDUs can wait while the task is busy, so each
+   interface needs that many buffers plus the ones the ISR and task hold.
+   Each interface hands one packet at a time to its RX callback. */
+#ifndef SDR_MAX_INTERFACES
+#define SDR_MAX_INTERFACES 2
+#endif
+#ifndef SDR_RX_QUEUE_DEPTH
+#define SDR_RX_QUEUE_DEPTH 8
+#endif
+#define SDR_MPDU_BUFFER_COUNT ((SDR_RX_QUEUE_DEPTH + 2) * SDR_MAX_INTERFACES)
+#define SDR_PACKET_BUFFER_COUNT SDR_MAX_INTERFACES
+
+/* MPDUs are sent no faster than the radio can put them on the air. Airtime
+   not used while the transmitter is idle is saved up to this many full
+   frames, so a packet sent after a quiet spell goes out without waiting. */
+#ifndef SDR_UHF_TX_BURST_FRAMES
+#define SDR_UHF_TX_BURST_FRAMES 1
+#endif
+
+/* Unpaced interfaces that can send several MPDUs at once are given the MPDUs
+   of a packet this many at a time */
+#ifndef SDR_TX_BATCH_MPDUS
+#define SDR_TX_BATCH_MPDUS 16
+#endif
+
+extern os_pool_t sdr_mpdu_pool;
+extern os_pool_t sdr_packet_pool;
+
 typedef enum {
     SDR_ERR_NONE,
     SDR_ERR_NOMEM,
@@ -41,6 +74,17 @@ typedef enum {
 */
 typedef int (*sdr_tx_t)(int fd, const void * data, size_t data_length);
 
+/**
+   sdr_txv_t - Send several MPDU frames at once (optional, implemented by driver).
+
+   @param[in] fd interface file descriptor
+   @param[in] mpdus the MPDUs to send, in order
+   @param[in] mpdu_len length of each MPDU
+   @param[in] count number of MPDUs, at most SDR_TX_BATCH_MPDUS
+   @return 0 on success, otherwise an error code.
+*/
+typedef int (*sdr_txv_t)(int fd, const uint8_t *const *mpdus, size_t mpdu_len, size_t count);
+
 /**
    sdr_rx_callback - user provided callback to receive a data packet
 
@@ -71,14 +115,25 @@ typedef struct sdr_interface_data {
     uintptr_t fd;
     /** Low Level Transmit Function */
     sdr_tx_t tx_func;
+    /** Low Level Transmit Function for several MPDUs, NULL if there is none */
+    sdr_txv_t txv_func;
     /** Low level Receive function */
     os_queue_handle_t rx_queue;
     void *mac_data;
     sdr_conf_t *sdr_conf;
     /** Low level buffer state */
     uint16_t rx_mpdu_index;
+    /** Transceiver status messages the frame being assembled can't be */
+    uint8_t rx_status_mismatch;
+    /** MPDUs lost because the RX queue was full or no buffer was free */
+    uint32_t rx_mpdu_dropped;
     uint8_t *rx_mpdu;
     OS_TickType last_rx;
+    /** Over the air bit rate that transmission is paced to, 0 if unpaced */
+    uint32_t tx_bit_rate;
+    /** Airtime the transmitter has been idle for and can spend on frames */
+    int64_t tx_credit_us;
+    OS_TickType tx_last_ms;
 } sdr_interface_data_t;
 
 #define SDR_IF_UHF_NAME "UHF"
@@ -92,6 +147,9 @@ int sdr_gnuradio_driver_init(sdr_interface_data_t *ifdata);
 
 int sdr_uhf_tx(sdr_interface_data_t *ifdata, uint8_t *data, uint16_t len);
 
+/* Over the air bit rate of a UHF baud rate, 0 for interfaces with no radio */
+uint32_t sdr_uhf_baud_bit_rate(sdr_uhf_baud_rate_t uhf_baudrate);
+
 void sdr_rx_isr(void *cb_data, uint8_t *buf, size_t len, void *pxTaskWoken);
 
 os_task_return_t sdr_rx_task(void *param);
@@ -0,0 +1,190 @@
+/*!
+ * @file CCSDSLDPC.hpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details The CCSDS AR4JA LDPC FEC codec for k = 1024 information bits and
+ * rates 1/2, 2/3 and 4/5, i.e., codewords of 2048, 1536 and 1280 bits.
+ *
+ * The parity check matrix is built from M x M blocks, each a sum of
+ * identities and the permutations PI_k defined in CCSDS 131.0-B, with
+ * M = 512, 256 and 128 for the three rates. Each PI_k is a 4 x 4 array of
+ * M/4 x M/4 circulants, so the code is quasi-cyclic with circulant size
+ * Z = M/4 and is stored as a list of circulants the same way as for QCLDPC.
+ *
+ * The last M columns of the parity check matrix are punctured, i.e., not
+ * transmitted.
+ *
+ * Encoding is systematic. The parity is found from the block structure of
+ * the last three block columns: with u the syndrome of the information bits,
+ * the punctured block is p4 = (I + PI_78 PI_234)^-1 (u3 + PI_78 u2), where
+ * PI_78 = PI_7 + PI_8 and so on, then p3 = u2 + PI_234 p4 and
+ * p2 = u1 + (I + PI_1) p4. Only the M x M inverse is dense.
+ *
+ * Decoding is layered min-sum using the kernels in LDPCMinSum.hpp, with each
+ * block row of circulants a layer. The punctured bits start with zero LLRs
+ * and are recovered along with the rest.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#ifndef EX2_SDR_ERROR_CONTROL_CCSDS_LDPC_H_
+#define EX2_SDR_ERROR_CONTROL_CCSDS_LDPC_H_
+
+#include <stdexcept>
+
+#include "FEC.hpp"
+#include "LDPCMinSum.hpp"
+
+namespace ex2 {
+  namespace sdr {
+
+    /*!
+     * @brief The CCSDS AR4JA LDPC forward error correction scheme.
+     */
+    class CCSDSLDPC : public FEC {
+    public:
+
+      CCSDSLDPC(ErrorCorrection::ErrorCorrectionScheme ecScheme);
+
+      ~CCSDSLDPC();
+
+      /*!
+       * @brief Encode a payload
+       *
+       * @param[in] payload The payload of getMessageLen()/8 bytes
+       * @return The systematic codeword of getCodewordLen()/8 bytes; the
+       * message bits followed by the unpunctured parity bits, msb first
+       * @throws FECException if @p payload is the wrong length
+       */
+      std::vector<uint8_t> encode(const std::vector<uint8_t>& payload);
+
+      /*!
+       * @brief Decode a hard decision codeword
+       *
+       * @details The hard decisions are converted to log-likelihood ratios
+       * assuming BPSK over an AWGN channel at @p snrEstimate and decoded as
+       * per @p decodeLLR.
+       *
+       * @param[in] encodedPayload The codeword of getCodewordLen()/8 bytes, msb first
+       * @param[in] snrEstimate Estimated Es/N0 in dB
+       * @param[out] decodedPayload The payload of getMessageLen()/8 bytes
+       * @return The number of codeword bits corrected, or UINT32_MAX if
+       * @p encodedPayload is the wrong length
+       */
+      uint32_t decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+        std::vector<uint8_t>& decodedPayload);
+
+      /*!
+       * @brief Decode a soft decision codeword
+       *
+       * @param[in] llrs One log-likelihood ratio, log(P(0)/P(1)), per
+       * transmitted codeword bit
+       * @param[out] decodedPayload The payload of getMessageLen()/8 bytes
+       * @return The number of codeword bits whose hard decision was corrected,
+       * or UINT32_MAX if @p llrs is the wrong length
+       */
+      uint32_t decodeLLR(const std::vector<float>& llrs, std::vector<uint8_t>& decodedPayload);
+
+      // Punctured variable nodes need more iterations than the 802.11n codes
+      static const uint32_t DEFAULT_MAX_ITERATIONS = 50;
+      static constexpr float DEFAULT_NORMALIZATION = 0.75f;
+
+      /*!
+       * @brief Set the maximum number of decoding iterations.
+       */
+      void setMaxIterations(uint32_t maxIterations) { m_maxIterations = maxIterations; }
+      uint32_t maxIterations() const { return m_maxIterations; }
+
+      /*!
+       * @brief Choose the min-sum variant
+       *
+       * @param[in] variant Normalized or offset min-sum
+       * @param[in] factor The normalization factor, or the offset in the same
+       * units as the LLRs
+       */
+      void setMinSumVariant(MinSumVariant variant, float factor);
+
+      /*!
+       * @brief The number of iterations the last decode took.
+       */
+      uint32_t lastIterations() const { return m_lastIterations; }
+
+      /*!
+       * @brief True if the last decode ended with a zero syndrome.
+       */
+      bool lastConverged() const { return m_lastConverged; }
+
+      /*!
+       * @brief The parity check matrix block size M; the last M codeword bits
+       * are punctured.
+       */
+      uint16_t submatrixSize() const { return m_M; }
+
+      /*!
+       * @brief Check a full codeword, including the punctured bits
+       *
+       * @param[in] codeword (getCodewordLen() + submatrixSize())/8 bytes, msb first
+       * @return The number of unsatisfied parity checks
+       */
+      uint32_t unsatisfiedChecks(const std::vector<uint8_t>& codeword) const;
+
+      /*!
+       * @brief The full codeword of the last encode, including the punctured
+       * bits, (getCodewordLen() + submatrixSize())/8 bytes, msb first.
+       */
+      std::vector<uint8_t> lastFullCodeword() const;
+
+    private:
+      ErrorCorrection *m_errorCorrection = 0;
+
+      uint16_t m_M;          // parity check matrix block size
+      uint16_t m_z;          // circulant size, M/4
+      uint16_t m_zPadded;    // rounded up to a whole number of SIMD vectors
+      uint16_t m_infoCols;   // circulant columns of information bits
+      uint16_t m_blockCols;  // circulant columns, including the punctured ones
+      uint16_t m_layers;     // circulant rows
+      uint32_t m_n;          // codeword length, including the punctured bits
+
+      // The non-zero circulants, block column and shift, of each layer in
+      // order; layer r uses edges m_layerStart[r] to m_layerStart[r+1]-1
+      std::vector<uint16_t> m_layerStart;
+      std::vector<uint16_t> m_edgeCol;
+      std::vector<uint8_t> m_edgeShift;
+
+      // (I + PI_78 PI_234)^-1, M rows of M/64 words, bit j of row i in word
+      // j/64 at bit j%64
+      std::vector<uint64_t> m_coreInverse;
+
+      // The codeword bits of the last encode and the decoder's hard
+      // decisions, one per byte
+      std::vector<uint8_t> m_bits;
+      std::vector<uint8_t> m_hardDecisions;
+
+      // Decoder configuration and status
+      uint32_t m_maxIterations = DEFAULT_MAX_ITERATIONS;
+      float m_normalization = DEFAULT_NORMALIZATION;
+      float m_offset = 0.0f;
+      uint32_t m_lastIterations = 0;
+      bool m_lastConverged = false;
+
+      // Decoder working storage: the posterior LLRs, the check to variable
+      // messages for each edge, and a layer's posteriors gathered into
+      // circulant row order, m_zPadded floats per edge
+      std::vector<float> m_posterior;
+      std::vector<float> m_checkMessages;
+      std::vector<float> m_layerPosterior;
+
+      void m_addEdge(uint16_t layer, uint16_t col, uint8_t shift);
+      void m_invertCore();
+      void m_permute(uint16_t k, const uint8_t *x, uint8_t *y) const;
+      bool m_syndromeIsZero();
+    };
+
+  } /* namespace sdr */
+} /* namespace ex2 */
+
+#endif /* EX2_SDR_ERROR_CONTROL_CCSDS_LDPC_H_ */
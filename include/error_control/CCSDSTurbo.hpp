@@ -0,0 +1,171 @@
+/*!
+ * @file CCSDSTurbo.hpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details The CCSDS Turbo FEC codec for information blocks of k = 1784,
+ * 3568, 7136 and 8920 bits and rates 1/2, 1/3, 1/4 and 1/6, as per
+ * CCSDS 131.0-B.
+ *
+ * Two 16 state recursive systematic component encoders, feedback
+ * G0 = 1 + D^3 + D^4 and forward G1 = 1 + D + D^3 + D^4, G2 = 1 + D^2 + D^4
+ * and G3 = 1 + D + D^2 + D^3 + D^4, encode the block and its CCSDS
+ * permutation respectively. Each is then terminated with 4 more steps. Per
+ * step the transmitted outputs are
+ *
+ *   rate 1/2: 0a, then 1a on even steps and 1b on odd steps
+ *   rate 1/3: 0a, 1a, 1b
+ *   rate 1/4: 0a, 2a, 3a, 1b
+ *   rate 1/6: 0a, 1a, 2a, 3a, 1b, 3b
+ *
+ * so a codeword is (k + 4)/r bits, zero-padded to a whole number of bytes
+ * for rate 1/3. The permutation is computed once at construction.
+ *
+ * Decoding is iterative max-log-MAP. The forward and backward recursions
+ * work on all 16 trellis states at once with the best SIMD kernel for the
+ * host CPU (see cpuFeatures.hpp). Decoding stops early once the hard
+ * decisions are the same for two iterations in a row.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#ifndef EX2_SDR_ERROR_CONTROL_CCSDS_TURBO_H_
+#define EX2_SDR_ERROR_CONTROL_CCSDS_TURBO_H_
+
+#include <stdexcept>
+
+#include "FEC.hpp"
+
+namespace ex2 {
+  namespace sdr {
+
+    /*!
+     * @brief The CCSDS Turbo forward error correction scheme.
+     */
+    class CCSDSTurbo : public FEC {
+    public:
+
+      CCSDSTurbo(ErrorCorrection::ErrorCorrectionScheme ecScheme);
+
+      ~CCSDSTurbo();
+
+      /*!
+       * @brief Encode a payload
+       *
+       * @param[in] payload The payload of getMessageLen()/8 bytes
+       * @return The codeword of getCodewordLen()/8 bytes, msb first
+       * @throws FECException if @p payload is the wrong length
+       */
+      std::vector<uint8_t> encode(const std::vector<uint8_t>& payload);
+
+      /*!
+       * @brief Decode a hard decision codeword
+       *
+       * @details The hard decisions are converted to log-likelihood ratios
+       * assuming BPSK over an AWGN channel at @p snrEstimate and decoded as
+       * per @p decodeLLR.
+       *
+       * @param[in] encodedPayload The codeword of getCodewordLen()/8 bytes, msb first
+       * @param[in] snrEstimate Estimated Es/N0 in dB
+       * @param[out] decodedPayload The payload of getMessageLen()/8 bytes
+       * @return The number of codeword bits corrected, or UINT32_MAX if
+       * @p encodedPayload is the wrong length
+       */
+      uint32_t decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+        std::vector<uint8_t>& decodedPayload);
+
+      /*!
+       * @brief Decode a soft decision codeword
+       *
+       * @param[in] llrs One log-likelihood ratio, log(P(0)/P(1)), per
+       * codeword bit, (k + 4)/r of them; padding bits are not included
+       * @param[out] decodedPayload The payload of getMessageLen()/8 bytes
+       * @return The number of codeword bits whose hard decision was
+       * corrected, or UINT32_MAX if @p llrs is the wrong length
+       */
+      uint32_t decodeLLR(const std::vector<float>& llrs, std::vector<uint8_t>& decodedPayload);
+
+      static const uint32_t DEFAULT_MAX_ITERATIONS = 10;
+
+      // Scaling the extrinsic information recovers most of the loss of
+      // max-log-MAP compared to log-MAP
+      static constexpr float DEFAULT_EXTRINSIC_SCALE = 0.75f;
+
+      /*!
+       * @brief Set the maximum number of decoding iterations.
+       */
+      void setMaxIterations(uint32_t maxIterations) { m_maxIterations = maxIterations; }
+      uint32_t maxIterations() const { return m_maxIterations; }
+
+      /*!
+       * @brief The number of iterations the last decode took.
+       */
+      uint32_t lastIterations() const { return m_lastIterations; }
+
+      /*!
+       * @brief True if the last decode stopped because its hard decisions
+       * were stable.
+       */
+      bool lastConverged() const { return m_lastConverged; }
+
+      /*!
+       * @brief The information block length k in bits.
+       */
+      uint16_t informationLen() const { return m_k; }
+
+      /*!
+       * @brief The number of codeword bits, (k + 4)/r, not including padding.
+       */
+      uint32_t codewordBits() const { return (m_k + TAIL_STEPS) * m_outputsPerStep; }
+
+      /*!
+       * @brief The CCSDS permutation; bit i of the permuted block, counting
+       * from 0, is bit permutation()[i] of the information block.
+       */
+      const std::vector<uint16_t>& permutation() const { return m_permutation; }
+
+      /*!
+       * @brief The name of the max-log-MAP kernel in use, e.g., "avx2"
+       */
+      static const char *sisoKernelName();
+
+    private:
+      static const uint32_t TAIL_STEPS = 4;
+
+      ErrorCorrection *m_errorCorrection = 0;
+
+      uint16_t m_k;
+      uint16_t m_outputsPerStep;  // 1/r
+
+      // The outputs sent on even and odd steps, see @p m_output
+      uint8_t m_pattern[2][6];
+
+      std::vector<uint16_t> m_permutation;
+
+      // Decoder configuration and status
+      uint32_t m_maxIterations = DEFAULT_MAX_ITERATIONS;
+      uint32_t m_lastIterations = 0;
+      bool m_lastConverged = false;
+
+      // Decoder working storage. Each component decoder has a systematic LLR
+      // and 4 parity LLRs (the last unused) per step; the extrinsic LLRs of
+      // both are kept in information block order
+      std::vector<float> m_systematicA;
+      std::vector<float> m_systematicB;
+      std::vector<float> m_parityA;
+      std::vector<float> m_parityB;
+      std::vector<float> m_channelSystematic;
+      std::vector<float> m_extrinsicA;
+      std::vector<float> m_extrinsicB;
+      std::vector<float> m_siso;
+      std::vector<float> m_alpha;
+      std::vector<uint8_t> m_hardDecisions;
+    };
+
+  } /* namespace sdr */
+} /* namespace ex2 */
+
+#endif /* EX2_SDR_ERROR_CONTROL_CCSDS_TURBO_H_ */
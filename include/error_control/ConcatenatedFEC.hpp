@@ -0,0 +1,117 @@
+/*!
+ * @file ConcatenatedFEC.hpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details A composite FEC codec chaining an outer and an inner codec with a
+ * symbol (byte) block interleaver between them.
+ *
+ * Encoding splits the payload into interleaving depth D outer messages,
+ * encodes each with the outer codec, interleaves the D outer codewords byte
+ * by byte, i.e., byte j of outer codeword d is sent at j D + d, and encodes
+ * the result with the inner codec. Decoding reverses this, so a burst of
+ * inner decoder errors is spread over the D outer codewords.
+ *
+ * The inner codec must accept the whole interleaved block as one message, as
+ * the convolutional codecs do.
+ *
+ * The CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2 scheme is the classic CCSDS
+ * concatenation of CCSDS 131.0-B: Reed-Solomon (255,223) outer, depth 4,
+ * and the K=7 rate 1/2 convolutional code inner.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#ifndef EX2_SDR_ERROR_CONTROL_CONCATENATED_FEC_H_
+#define EX2_SDR_ERROR_CONTROL_CONCATENATED_FEC_H_
+
+#include "FEC.hpp"
+
+namespace ex2 {
+  namespace sdr {
+
+    /*!
+     * @brief An outer and an inner forward error correction scheme in series.
+     */
+    class ConcatenatedFEC : public FEC {
+    public:
+
+      /*!
+       * @brief Construct one of the concatenated schemes
+       *
+       * @param[in] ecScheme A concatenated scheme
+       * @throws FECException if @p ecScheme is not a concatenated scheme
+       */
+      ConcatenatedFEC(ErrorCorrection::ErrorCorrectionScheme ecScheme);
+
+      /*!
+       * @brief Construct any concatenation
+       *
+       * @param[in] ecScheme The scheme this codec is known by
+       * @param[in] outerScheme The outer scheme; it must have a fixed message
+       * and codeword length
+       * @param[in] innerScheme The inner scheme
+       * @param[in] depth The interleaving depth, the number of outer codewords
+       * per inner message
+       * @throws FECException if either scheme has no codec
+       */
+      ConcatenatedFEC(ErrorCorrection::ErrorCorrectionScheme ecScheme,
+        ErrorCorrection::ErrorCorrectionScheme outerScheme,
+        ErrorCorrection::ErrorCorrectionScheme innerScheme,
+        uint16_t depth);
+
+      ~ConcatenatedFEC();
+
+      /*!
+       * @brief Encode a payload
+       *
+       * @param[in] payload The payload of @p messageLen() bytes
+       * @return The inner codeword
+       * @throws FECException if @p payload is the wrong length
+       */
+      std::vector<uint8_t> encode(const std::vector<uint8_t>& payload);
+
+      /*!
+       * @brief Decode an inner codeword
+       *
+       * @param[in] encodedPayload The inner codeword
+       * @param[in] snrEstimate Passed to the inner codec
+       * @param[out] decodedPayload The payload of @p messageLen() bytes
+       * @return The number of bits the outer codec corrected, or UINT32_MAX
+       * if either codec could not decode its input
+       */
+      uint32_t decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+        std::vector<uint8_t>& decodedPayload);
+
+      uint16_t interleavingDepth() const { return m_depth; }
+
+      /*!
+       * @brief The payload length in bytes, the outer message length times
+       * the interleaving depth.
+       */
+      uint32_t messageLen() const { return m_outerMessageLen * m_depth; }
+
+    private:
+      FEC *m_outer = 0;
+      FEC *m_inner = 0;
+      uint16_t m_depth;
+      uint32_t m_outerMessageLen;   // bytes
+      uint32_t m_outerCodewordLen;  // bytes
+
+      // Working storage kept between calls so encoding and decoding do not
+      // allocate once warmed up
+      std::vector<uint8_t> m_outerMessage;
+      std::vector<uint8_t> m_outerCodeword;
+      std::vector<uint8_t> m_interleaved;
+
+      void m_construct(ErrorCorrection::ErrorCorrectionScheme outerScheme,
+        ErrorCorrection::ErrorCorrectionScheme innerScheme, uint16_t depth);
+    };
+
+  } /* namespace sdr */
+} /* namespace ex2 */
+
+#endif /* EX2_SDR_ERROR_CONTROL_CONCATENATED_FEC_H_ */
@@ -6,6 +6,10 @@
  * @details The Convolutional Codec provides convolutional encoding and
  * hard-decision decoding for the CCSDS schemes defined in @p error_correction.hpp
  *
+ * Rates 2/3, 3/4, 5/6, and 7/8 are made by puncturing the rate 1/2 mother
+ * code according to CCSDS 131.0-B-3, Table 3-1. Punctured bits are treated as
+ * erasures when decoding.
+ *
  * @copyright AlbertaSat 2021
  *
  * @license
@@ -38,9 +42,53 @@ namespace ex2 {
       uint32_t decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
         std::vector<uint8_t>& decodedPayload);
 
+      /*!
+       * @brief Decode to the most likely message and up to @p listSize - 1
+       * alternatives that differ from it by one error event.
+       *
+       * @details The first candidate is the maximum likelihood decoding of
+       * the whole codeword, which may differ from the result of @p decode
+       * when that truncates the traceback.
+       */
+      uint32_t decodeList(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+        unsigned int listSize, std::vector<std::vector<uint8_t>>& decodedPayloads);
+
+      bool supportsListDecoding() const { return true; }
+
     private:
       ErrorCorrection *m_errorCorrection = 0;
       ViterbiCodec *m_codec = 0;
+
+      // The puncture pattern applied to the serialized rate 1/2 mother code
+      // output, i.e., C1(1) C2(1) C1(2) C2(2)... An entry of 1 means the bit
+      // is transmitted. Empty for rate 1/2 (no puncturing).
+      std::vector<uint8_t> m_puncturePattern;
+      // The number of transmitted bits per puncture pattern period
+      uint32_t m_punctureKeptBits = 0;
+
+      // The received codeword, 1 bit per byte
+      ViterbiCodec::bitarr_t m_received;
+
+      /*!
+       * @brief Puncture a packed rate 1/2 mother codeword
+       *
+       * @param[in] motherCodeword The packed, 8 bits per byte, mother codeword
+       * @return The packed punctured codeword, zero-padded to a whole byte
+       */
+      std::vector<uint8_t> m_puncture(const std::vector<uint8_t>& motherCodeword) const;
+
+      /*!
+       * @brief Reinsert punctured bit positions as erasures
+       *
+       * @details The number of message bits is the largest multiple of 8 that
+       * could have produced @p received, which is unambiguous because the
+       * punctured codeword is padded by fewer than 8 bits.
+       *
+       * @param[in] received The punctured codeword, 1 bit per byte
+       * @return The rate 1/2 mother codeword, 1 bit per byte, with punctured
+       * positions set to @p ViterbiCodec::ERASED_BIT
+       */
+      ViterbiCodec::bitarr_t m_depuncture(const ViterbiCodec::bitarr_t& received) const;
     };
 
   } /* namespace sdr */
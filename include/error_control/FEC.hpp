@@ -66,6 +66,30 @@ namespace ex2 {
       virtual uint32_t decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
         std::vector<uint8_t>& decodedPayload) = 0;
 
+      /*!
+       * @brief Decode a payload to a list of candidate payloads
+       *
+       * @details For schemes that can produce more than one likely decoding,
+       * e.g., a list Viterbi decoder, so an outer check such as a packet CRC
+       * can pick the correct candidate when the most likely one is wrong. The
+       * default is the single result of @p decode.
+       *
+       * @param[in] encodedPayload The encoded payload
+       * @param[in] snrEstimate An estimate of the SNR for FEC schemes that need it.
+       * @param[in] listSize The maximum number of candidates
+       * @param[out] decodedPayloads The candidates, most likely first
+       * @return The number of bit errors from the decoding process
+       */
+      virtual uint32_t decodeList(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+        unsigned int listSize, std::vector<std::vector<uint8_t>>& decodedPayloads);
+
+      /*!
+       * @brief Whether @p decodeList can return more than one candidate
+       *
+       * @return true if @p decodeList is overridden with a list decoder
+       */
+      virtual bool supportsListDecoding() const { return false; }
+
     private:
       ErrorCorrection::ErrorCorrectionScheme m_ecScheme;
     };
@@ -0,0 +1,57 @@
+/*!
+ * @file LDPCMinSum.hpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Min-sum check node kernels shared by the layered LDPC decoders.
+ *
+ * Both the IEEE 802.11n and the CCSDS AR4JA codes are quasi-cyclic, so a
+ * layer's check node update is done across the Z rows of its circulants at
+ * once, using the best SIMD kernel for the host CPU (see cpuFeatures.hpp).
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#ifndef EX2_SDR_ERROR_CONTROL_LDPC_MIN_SUM_H_
+#define EX2_SDR_ERROR_CONTROL_LDPC_MIN_SUM_H_
+
+#include <cstdint>
+
+#include "cpuFeatures.hpp"
+
+namespace ex2 {
+  namespace sdr {
+
+    enum class MinSumVariant : uint16_t {
+      NORMALIZED = 0x0000, // check messages are scaled by a factor < 1
+      OFFSET     = 0x0001  // check messages are reduced by an offset
+    };
+
+    // Circulant rows are processed in groups of this many lanes, so a
+    // decoder's circulant size must be padded to a multiple of it
+    const uint16_t MIN_SUM_LANES = 8;
+    const uint16_t MIN_SUM_MAX_Z_PADDED = 128;
+
+    /*!
+     * @brief Min-sum check node update for one layer
+     *
+     * @details Done for all circulant rows (lanes) at once. posterior and
+     * check hold degree rows of zPadded floats; row k is the layer's k-th
+     * circulant in circulant row order. For each lane, the variable to check
+     * message is q = posterior - check, the new check message is the product
+     * of the signs of the other q times the max(normalization * min|q| -
+     * offset, 0) over the other q, and the posterior becomes q plus the new
+     * check message. All implementations give identical results.
+     */
+    typedef void (*MinSumLayerFn)(float *posterior, float *check, uint16_t degree,
+      uint16_t zPadded, float normalization, float offset);
+
+    extern const DispatchedKernel<MinSumLayerFn> minSumLayerKernel;
+
+  } /* namespace sdr */
+} /* namespace ex2 */
+
+#endif /* EX2_SDR_ERROR_CONTROL_LDPC_MIN_SUM_H_ */
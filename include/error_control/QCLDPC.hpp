@@ -3,7 +3,20 @@
  * @author StevenKnudsen
  * @date Sept 27, 2021
  *
- * @details A passthrough FEC codec.
+ * @details The IEEE 802.11n quasi-cyclic LDPC FEC codec.
+ *
+ * Encoding is systematic and works directly on packed bits using the
+ * quasi-cyclic structure of the base matrix: each ZxZ circulant is applied as
+ * a rotation of a Z bit block, and the parity blocks are found by
+ * back-substitution through the dual-diagonal parity part, so no dense
+ * generator matrix is needed.
+ *
+ * Decoding is layered min-sum, either normalized or offset, with each block
+ * row of the base matrix a layer, using the kernels in LDPCMinSum.hpp.
+ * Decoding stops early once the syndrome is zero.
+ *
+ * Building with QCLDPC_FIXED_POINT defined to 1 decodes with the saturating
+ * fixed-point decoder in QCLDPCFixedPoint.hpp instead, for the OBC.
  *
  * @copyright AlbertaSat 2021
  *
@@ -17,12 +30,16 @@
 #include <stdexcept>
 
 #include "FEC.hpp"
+#include "LDPCMinSum.hpp"
+#include "bitBuffer.hpp"
+#include "QCLDPCFixedPoint.hpp"
+#include "QCLDPCMatrices.hpp"
 
 namespace ex2 {
   namespace sdr {
 
     /*!
-     * @brief Define a forward error correction scheme.
+     * @brief The IEEE 802.11n QC-LDPC forward error correction scheme.
      */
     class QCLDPC : public FEC {
     public:
@@ -31,13 +48,149 @@ namespace ex2 {
 
       ~QCLDPC();
 
+      /*!
+       * @brief Encode a payload
+       *
+       * @details Some message lengths are not a whole number of bytes, e.g.,
+       * 324 bits for IEEE_802_11N_QCLDPC_648_R_1_2, so the payload is the
+       * floor of the message length in bytes and the remaining message bits
+       * are zero.
+       *
+       * @param[in] payload The payload of getMessageLen()/8 bytes
+       * @return The systematic codeword of getCodewordLen()/8 bytes; the
+       * message bits followed by the parity bits, msb first
+       * @throws FECException if @p payload is the wrong length
+       */
       std::vector<uint8_t> encode(const std::vector<uint8_t>& payload);
 
+      /*!
+       * @brief Decode a hard decision codeword
+       *
+       * @details The hard decisions are converted to log-likelihood ratios
+       * assuming BPSK over an AWGN channel at @p snrEstimate and decoded as
+       * per @p decodeLLR.
+       *
+       * @param[in] encodedPayload The codeword of getCodewordLen()/8 bytes, msb first
+       * @param[in] snrEstimate Estimated Es/N0 in dB
+       * @param[out] decodedPayload The payload of getMessageLen()/8 bytes
+       * @return The number of codeword bits corrected, or UINT32_MAX if
+       * @p encodedPayload is the wrong length
+       */
       uint32_t decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
         std::vector<uint8_t>& decodedPayload);
 
+      /*!
+       * @brief Decode a soft decision codeword
+       *
+       * @param[in] llrs One log-likelihood ratio, log(P(0)/P(1)), per codeword bit
+       * @param[out] decodedPayload The payload of getMessageLen()/8 bytes
+       * @return The number of codeword bits whose hard decision was corrected,
+       * or UINT32_MAX if @p llrs is the wrong length
+       */
+      uint32_t decodeLLR(const std::vector<float>& llrs, std::vector<uint8_t>& decodedPayload);
+
+      /*!
+       * @brief Encode a whole message
+       *
+       * @param[in] message The getMessageLen() message bits, e.g., all 324
+       * for IEEE_802_11N_QCLDPC_648_R_1_2
+       * @return The getCodewordLen() bit systematic codeword
+       * @throws FECException if @p message is the wrong length
+       */
+      BitBuffer encodeBits(ConstBitSpan message);
+
+      /*!
+       * @brief Decode a soft decision codeword to a whole message
+       *
+       * @details Unlike the payload methods, no message bits are assumed to
+       * be zero.
+       *
+       * @param[in] llrs One log-likelihood ratio, log(P(0)/P(1)), per codeword bit
+       * @param[out] decodedMessage The getMessageLen() message bits
+       * @return The number of codeword bits whose hard decision was corrected,
+       * or UINT32_MAX if @p llrs is the wrong length
+       */
+      uint32_t decodeLLR(const std::vector<float>& llrs, BitBuffer& decodedMessage);
+
+      typedef ex2::sdr::MinSumVariant MinSumVariant;
+
+      static const uint32_t DEFAULT_MAX_ITERATIONS = 20;
+      static constexpr float DEFAULT_NORMALIZATION = 0.75f;
+
+      /*!
+       * @brief Set the maximum number of decoding iterations.
+       */
+      void setMaxIterations(uint32_t maxIterations);
+      uint32_t maxIterations() const { return m_maxIterations; }
+
+      /*!
+       * @brief Choose the min-sum variant
+       *
+       * @param[in] variant Normalized or offset min-sum
+       * @param[in] factor The normalization factor, or the offset in the same
+       * units as the LLRs
+       */
+      void setMinSumVariant(MinSumVariant variant, float factor);
+
+      /*!
+       * @brief The number of iterations the last decode took.
+       */
+      uint32_t lastIterations() const { return m_lastIterations; }
+
+      /*!
+       * @brief True if the last decode ended with a zero syndrome.
+       */
+      bool lastConverged() const { return m_lastConverged; }
+
     private:
       ErrorCorrection *m_errorCorrection = 0;
+      const QCLDPCBaseMatrix& m_baseMatrix;
+
+      // Working storage for the codeword bits, lsb first in 64 bit words
+      std::vector<uint64_t> m_codewordWords;
+
+      // Decoder configuration and status
+      uint32_t m_maxIterations = DEFAULT_MAX_ITERATIONS;
+      float m_normalization = DEFAULT_NORMALIZATION;
+      float m_offset = 0.0f;
+      uint32_t m_lastIterations = 0;
+      bool m_lastConverged = false;
+
+#if QCLDPC_FIXED_POINT
+      QCLDPCFixedPoint m_fixedPoint;
+#endif
+
+      // The circulant size rounded up to a whole number of SIMD vectors
+      uint16_t m_zPadded;
+
+      // The non-zero circulants, block column and shift, of each layer in
+      // order; layer r uses edges m_layerStart[r] to m_layerStart[r+1]-1
+      std::vector<uint16_t> m_layerStart;
+      std::vector<uint16_t> m_edgeCol;
+      std::vector<uint8_t> m_edgeShift;
+
+      // Decoder working storage: the posterior LLRs, the check to variable
+      // messages for each edge, and a layer's posteriors gathered into
+      // circulant row order, m_zPadded floats per edge
+      std::vector<float> m_posterior;
+      std::vector<float> m_checkMessages;
+      std::vector<float> m_layerPosterior;
+
+      bool m_syndromeIsZero();
+
+      /*!
+       * @brief Encode into @p m_codewordWords; message bits beyond
+       * @p message are zero
+       */
+      void m_encode(ConstBitSpan message);
+
+      /*!
+       * @brief Run the decoder on @p m_posterior, taking the message bits
+       * from @p knownBits on to be zero
+       *
+       * @return The number of codeword bits corrected
+       */
+      uint32_t m_decodeLLR(const std::vector<float>& llrs, uint32_t knownBits);
     };
 
   } /* namespace sdr */
@@ -0,0 +1,186 @@
+/*!
+ * @file QCLDPCFixedPoint.hpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details A fixed-point layered min-sum decoder for the IEEE 802.11n QC-LDPC
+ * codes, intended for the OBC where a float decoder is too costly.
+ *
+ * Channel LLRs and check to variable messages are saturating int8, posterior
+ * LLRs are saturating int16. All working storage is sized at compile time for
+ * the largest code and held in the object, so decoding uses no heap and a
+ * small, bounded amount of stack. Normalization is done with a multiply and
+ * shift by a factor quantized to 1/16.
+ *
+ * Define QCLDPC_FIXED_POINT to 1 to make QCLDPC use this decoder.
+ *
+ * Decoding loss compared to the float decoder (QCLDPC with
+ * QCLDPC_FIXED_POINT 0), both normalized min-sum with factor 0.75 and at most
+ * 20 iterations, soft input quantized with DEFAULT_LLR_SCALE, hard input
+ * converted to LLRs as QCLDPC::decode does. Eb/N0 in dB for a frame error
+ * rate of 1e-2 over BPSK/AWGN, interpolated from 1000 to 2000 frames per
+ * point:
+ *
+ *                     soft input        hard input
+ *    code            float   fixed     float   fixed
+ *    n=648  R1/2     2.1     2.1       4.0     4.0
+ *    n=1944 R1/2     1.7     1.7       3.6     3.6
+ *    n=1944 R5/6     3.45    3.45      5.25    5.25
+ *
+ * i.e., the loss is below the 0.05 dB resolution of the measurement. Rounding
+ * the normalized check messages matters; truncating them instead costs about
+ * 0.2 dB at n=1944 R1/2. A coarser DEFAULT_LLR_SCALE of 2 costs about 0.1 dB.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#ifndef EX2_SDR_ERROR_CONTROL_QCLDPC_FIXED_POINT_H_
+#define EX2_SDR_ERROR_CONTROL_QCLDPC_FIXED_POINT_H_
+
+#include <cstdint>
+
+#include "QCLDPCMatrices.hpp"
+
+// Set to 1 to decode the IEEE_802_11N_QCLDPC_xxx schemes with the fixed-point
+// decoder
+#ifndef QCLDPC_FIXED_POINT
+#define QCLDPC_FIXED_POINT 0
+#endif
+
+namespace ex2 {
+  namespace sdr {
+
+    /*!
+     * @brief Fixed-point layered min-sum decoder for the 802.11n QC-LDPC codes
+     */
+    class QCLDPCFixedPoint {
+    public:
+      // Limits over all the 802.11n codes
+      static const uint16_t MAX_N = 1944;
+      static const uint16_t MAX_Z = 81;
+      static const uint16_t MAX_EDGES = 88;      // non-zero circulants
+      static const uint16_t MAX_ROW_DEGREE = 22; // non-zero circulants in a block row
+      static const uint16_t MAX_BLOCK_ROWS = 12;
+
+      static const int8_t MAX_LLR = 127;
+
+      // Channel LLR units per quantization step is 1/DEFAULT_LLR_SCALE
+      static constexpr float DEFAULT_LLR_SCALE = 8.0f;
+
+      /*!
+       * @brief Constructor
+       *
+       * @param[in] baseMatrix The code's base matrix
+       * @param[in] messageLenBits The message length; the payload methods
+       * take bits beyond the whole bytes of the message to be known zeros
+       * @param[in] maxIterations The maximum number of iterations
+       */
+      QCLDPCFixedPoint(const QCLDPCBaseMatrix& baseMatrix, uint32_t messageLenBits,
+        uint32_t maxIterations);
+
+      /*!
+       * @brief Decode a soft decision codeword
+       *
+       * @param[in] llrs baseMatrix.n LLRs, log(P(0)/P(1)), already quantized
+       * @param[out] payload messageLenBits/8 bytes, msb first
+       * @return The number of codeword bits whose hard decision was corrected
+       */
+      uint32_t decode(const int8_t *llrs, uint8_t *payload);
+
+      /*!
+       * @brief Decode a soft decision codeword
+       *
+       * @param[in] llrs baseMatrix.n LLRs, log(P(0)/P(1))
+       * @param[in] scale The LLRs are multiplied by @p scale and saturated to
+       * +/-MAX_LLR
+       * @param[out] payload messageLenBits/8 bytes, msb first
+       * @return The number of codeword bits whose hard decision was corrected
+       */
+      uint32_t decode(const float *llrs, float scale, uint8_t *payload);
+
+      /*!
+       * @brief Decode a soft decision codeword to the whole message
+       *
+       * @details Unlike the payload methods, no message bits are assumed to
+       * be zero.
+       *
+       * @param[in] llrs baseMatrix.n LLRs, log(P(0)/P(1))
+       * @param[in] scale The LLRs are multiplied by @p scale and saturated to
+       * +/-MAX_LLR
+       * @param[out] message (messageLenBits+7)/8 bytes, msb first, the bits
+       * past messageLenBits zero
+       * @return The number of codeword bits whose hard decision was corrected
+       */
+      uint32_t decodeMessage(const float *llrs, float scale, uint8_t *message);
+
+      /*!
+       * @brief Decode a hard decision codeword
+       *
+       * @param[in] codeword baseMatrix.n/8 bytes, msb first
+       * @param[in] llrMagnitude The quantized LLR magnitude for each bit
+       * @param[out] payload messageLenBits/8 bytes, msb first
+       * @return The number of codeword bits corrected
+       */
+      uint32_t decodeHard(const uint8_t *codeword, int8_t llrMagnitude, uint8_t *payload);
+
+      /*!
+       * @brief Quantize an LLR, rounding to nearest and saturating
+       */
+      static int8_t quantize(float llr, float scale);
+
+      void setMaxIterations(uint32_t maxIterations) { m_maxIterations = maxIterations; }
+
+      /*!
+       * @brief Use normalized min-sum
+       *
+       * @param[in] factor Normalization factor, quantized to 1/16
+       */
+      void setNormalization(float factor);
+
+      /*!
+       * @brief Use offset min-sum
+       *
+       * @param[in] offset Offset in quantized LLR units
+       */
+      void setOffset(uint8_t offset);
+
+      uint32_t lastIterations() const { return m_lastIterations; }
+      bool lastConverged() const { return m_lastConverged; }
+
+    private:
+      const QCLDPCBaseMatrix& m_baseMatrix;
+      const uint32_t m_messageLenBits;
+      uint32_t m_maxIterations;
+
+      // Check message magnitude is min * m_normalization / 16, rounded, less
+      // m_offset
+      uint8_t m_normalization;
+      uint8_t m_offset;
+
+      uint32_t m_lastIterations;
+      bool m_lastConverged;
+
+      // The non-zero circulants, block column and shift, of each layer in
+      // order; layer r uses edges m_layerStart[r] to m_layerStart[r+1]-1
+      uint8_t m_layerStart[MAX_BLOCK_ROWS + 1];
+      uint8_t m_edgeCol[MAX_EDGES];
+      uint8_t m_edgeShift[MAX_EDGES];
+
+      // Working storage
+      int8_t m_channel[MAX_N];
+      int16_t m_posterior[MAX_N];
+      int8_t m_checkMessages[MAX_EDGES * MAX_Z];
+      int16_t m_layerPosterior[MAX_ROW_DEGREE * MAX_Z];
+
+      uint32_t m_decode(uint8_t *out, uint32_t outBits);
+      void m_updateLayer(uint16_t layer);
+      bool m_syndromeIsZero() const;
+    };
+
+  } /* namespace sdr */
+} /* namespace ex2 */
+
+#endif /* EX2_SDR_ERROR_CONTROL_QCLDPC_FIXED_POINT_H_ */
@@ -0,0 +1,57 @@
+/*!
+ * @file QCLDPCMatrices.hpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details The IEEE 802.11n quasi-cyclic LDPC base (prototype) matrices.
+ *
+ * Each code is described by a 24 column base matrix whose entries are the
+ * right cyclic shift of a ZxZ identity matrix, or -1 for the ZxZ zero matrix.
+ * The last (24 - k_b) block columns hold the parity part: a weight 3 column
+ * followed by a dual-diagonal staircase, which allows encoding by
+ * back-substitution without a generator matrix.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#ifndef EX2_SDR_ERROR_CONTROL_QCLDPC_MATRICES_H_
+#define EX2_SDR_ERROR_CONTROL_QCLDPC_MATRICES_H_
+
+#include <cstdint>
+
+#include "error_correction.hpp"
+
+namespace ex2 {
+  namespace sdr {
+
+    /*!
+     * @brief An IEEE 802.11n QC-LDPC base matrix
+     */
+    struct QCLDPCBaseMatrix {
+      static const uint16_t BLOCK_COLS = 24;
+
+      uint16_t n;           // codeword length in bits
+      uint8_t z;            // circulant size in bits
+      uint8_t rows;         // number of block rows, m_b
+      const int8_t *shifts; // rows x BLOCK_COLS shifts, -1 for the zero matrix
+
+      uint16_t infoCols() const { return BLOCK_COLS - rows; }
+      int8_t shift(uint16_t row, uint16_t col) const { return shifts[row * BLOCK_COLS + col]; }
+
+      /*!
+       * @brief Get the base matrix for a QC-LDPC scheme
+       *
+       * @param[in] ecScheme One of the IEEE_802_11N_QCLDPC_xxx schemes
+       * @return The base matrix
+       * @throws FECException if @p ecScheme is not a QC-LDPC scheme
+       */
+      static const QCLDPCBaseMatrix& forScheme(ErrorCorrection::ErrorCorrectionScheme ecScheme);
+    };
+
+  } /* namespace sdr */
+} /* namespace ex2 */
+
+#endif /* EX2_SDR_ERROR_CONTROL_QCLDPC_MATRICES_H_ */
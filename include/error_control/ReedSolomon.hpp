@@ -0,0 +1,130 @@
+/*!
+ * @file ReedSolomon.hpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details The CCSDS Reed-Solomon (255,223) and (255,239) FEC codec with
+ * interleaving depths 1 to 8.
+ *
+ * The code is over GF(2^8) with field generator x^8 + x^7 + x^2 + x + 1 and
+ * code generator roots alpha^(11 j) for j = 128 - E to 127 + E, where E is 16
+ * for (255,223) and 8 for (255,239), as per CCSDS 131.0-B. Symbols are sent
+ * in the CCSDS dual basis (Berlekamp) representation by default; the
+ * conventional representation can be chosen instead.
+ *
+ * With interleaving depth I, each encode takes I x k bytes and produces I
+ * interleaved codewords, I x 255 bytes, so the MAC packs whole interleaved
+ * blocks into MPDUs. Byte m of the message is symbol m / I of codeword m % I
+ * and the codewords are interleaved symbol by symbol, so a burst of up to
+ * E x I bytes is correctable.
+ *
+ * Decoding computes the syndromes with the best SIMD kernel for the host CPU
+ * (see cpuFeatures.hpp), then uses Berlekamp-Massey, Chien search and Forney.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#ifndef EX2_SDR_ERROR_CONTROL_REED_SOLOMON_H_
+#define EX2_SDR_ERROR_CONTROL_REED_SOLOMON_H_
+
+#include <stdexcept>
+
+#include "FEC.hpp"
+
+namespace ex2 {
+  namespace sdr {
+
+    /*!
+     * @brief The CCSDS Reed-Solomon forward error correction scheme.
+     */
+    class ReedSolomon : public FEC {
+    public:
+
+      static const uint16_t N = 255;          // codeword symbols
+      static const uint16_t MAX_PARITY = 32;  // parity symbols of (255,223)
+
+      ReedSolomon(ErrorCorrection::ErrorCorrectionScheme ecScheme);
+
+      ~ReedSolomon();
+
+      /*!
+       * @brief Encode a payload
+       *
+       * @param[in] payload The payload of getMessageLen()/8 bytes
+       * @return The interleaved codewords, getCodewordLen()/8 bytes
+       * @throws FECException if @p payload is the wrong length
+       */
+      std::vector<uint8_t> encode(const std::vector<uint8_t>& payload);
+
+      /*!
+       * @brief Decode interleaved codewords
+       *
+       * @details A codeword with more symbol errors than can be corrected is
+       * passed through as received; see @p lastUncorrectable.
+       *
+       * @param[in] encodedPayload The interleaved codewords, getCodewordLen()/8 bytes
+       * @param[in] snrEstimate Not used
+       * @param[out] decodedPayload The payload of getMessageLen()/8 bytes
+       * @return The number of bits corrected, or UINT32_MAX if
+       * @p encodedPayload is the wrong length
+       */
+      uint32_t decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+        std::vector<uint8_t>& decodedPayload);
+
+      /*!
+       * @brief Choose the dual basis (CCSDS, the default) or conventional
+       * symbol representation.
+       */
+      void setDualBasis(bool dualBasis) { m_dualBasis = dualBasis; }
+      bool dualBasis() const { return m_dualBasis; }
+
+      uint16_t interleavingDepth() const { return m_interleavingDepth; }
+
+      /*!
+       * @brief The number of parity symbols per codeword, 2E.
+       */
+      uint16_t parityLen() const { return m_parityLen; }
+
+      /*!
+       * @brief The number of codewords the last decode could not correct.
+       */
+      uint16_t lastUncorrectable() const { return m_lastUncorrectable; }
+
+      /*!
+       * @brief Compute the syndromes of one codeword
+       *
+       * @param[in] codeword N symbols in the conventional representation
+       * @param[out] syndromes parityLen() syndromes, those for the lowest
+       * root first
+       */
+      void syndromes(const uint8_t *codeword, uint8_t *syndromes) const;
+
+      /*!
+       * @brief The name of the syndrome kernel in use, e.g., "avx2"
+       */
+      static const char *syndromeKernelName();
+
+    private:
+      ErrorCorrection *m_errorCorrection = 0;
+
+      uint16_t m_interleavingDepth;
+      uint16_t m_parityLen;
+      uint16_t m_messageLen;      // symbols per codeword
+      uint16_t m_firstRoot;       // j of the first root alpha^(11 j)
+      bool m_dualBasis = true;
+      uint16_t m_lastUncorrectable = 0;
+
+      // Generator polynomial coefficients in log form, highest degree first
+      uint8_t m_generator[MAX_PARITY + 1];
+
+      void m_encodeCodeword(const uint8_t *message, uint8_t *parity) const;
+      int16_t m_decodeCodeword(uint8_t *codeword) const;
+    };
+
+  } /* namespace sdr */
+} /* namespace ex2 */
+
+#endif /* EX2_SDR_ERROR_CONTROL_REED_SOLOMON_H_ */
@@ -5,6 +5,16 @@
  *
  * @details CRC 16 and 32 support.
  *
+ * The 16 bit CRC is CRC-16/CCITT-FALSE (polynomial 0x1021, initial value
+ * 0xFFFF, not reflected), the same as the UHF radio framing. The 32 bit CRC
+ * is the IEEE 802.3 CRC-32 (polynomial 0x04C11DB7, reflected, initial and
+ * final XOR 0xFFFFFFFF).
+ *
+ * Checksums are calculated eight bytes at a time with slice-by-8 tables, or
+ * 64 bytes at a time by folding with carry-less multiplication on x86
+ * processors that have PCLMULQDQ. A checksum can be updated as data arrives,
+ * e.g., over MPDU fragments, and is the same as one over all the data at once.
+ *
  * @copyright University of Alberta 2021
  *
  * @license
@@ -14,9 +24,9 @@
 #ifndef EX2_SDR_ERROR_CONTROL_CRC_H_
 #define EX2_SDR_ERROR_CONTROL_CRC_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
-#include <boost/crc.hpp>
 
 namespace ex2 {
   namespace sdr {
@@ -30,15 +40,93 @@ namespace ex2 {
         CRC_32_BITS = 32
       };
 
-      crc ();
+      /*!
+       * @brief Constructor for an incremental checksum
+       *
+       * @param[in] crcSize The CRC to calculate
+       */
+      crc (crc_size_t crcSize = CRC_32_BITS);
+
       virtual
       ~crc ();
 
+      crc_size_t
+      getCRCSize () const
+      {
+        return m_crcSize;
+      }
+
+      /*!
+       * @brief Start a new checksum
+       */
+      void
+      reset ()
+      {
+        m_checksum = initial(m_crcSize);
+      }
+
+      /*!
+       * @brief Add data to the checksum
+       *
+       * @param[in] data The next bytes
+       * @param[in] length The number of bytes
+       */
+      void
+      update (const uint8_t *data, size_t length)
+      {
+        m_checksum = calculate(m_crcSize, data, length, m_checksum);
+      }
+
+      void
+      update (const std::vector<uint8_t> &data)
+      {
+        update(data.data(), data.size());
+      }
+
+      /*!
+       * @brief The checksum of all the data since construction or @p reset
+       */
+      uint32_t
+      checksum () const
+      {
+        return m_checksum;
+      }
+
+      /*!
+       * @brief The checksum of no data, from which a checksum is continued
+       */
+      static uint32_t initial(crc_size_t crcSize);
+
+      /*!
+       * @brief Continue a checksum
+       *
+       * @param[in] crcSize The CRC to calculate
+       * @param[in] data The next bytes
+       * @param[in] length The number of bytes
+       * @param[in] checksum The checksum of the preceding data
+       * @return The checksum of the preceding data followed by @p data
+       */
+      static uint32_t calculate(crc_size_t crcSize, const uint8_t *data, size_t length, uint32_t checksum);
+
+      /*!
+       * @brief The checksum of @p length bytes
+       */
+      static uint32_t
+      calculate(crc_size_t crcSize, const uint8_t *data, size_t length)
+      {
+        return calculate(crcSize, data, length, initial(crcSize));
+      }
+
+      /*!
+       * @brief The name of the implementation in use, e.g., "pclmul"
+       */
+      static const char *kernelName();
+
       /*!
        * @brief Calculate the CRC syndrome and add to the PDU.
        *
-       * @details If the CRC syndrome can be calculated, it's added to the end
-       * of the PDU payload.
+       * @details The CRC syndrome is added to the end of the PDU payload,
+       * most significant byte first.
        *
        * @param[inout] pdu
        * @param[in] crcSize
@@ -57,21 +145,17 @@ namespace ex2 {
        */
       void check(std::vector<uint8_t> &pdu, crc_size_t crcSize);
 
-    private:
-
-      boost::crc_16_type m_crc16Impl;
-      boost::crc_32_type m_crc32Impl;
-
-      union dataSyndrome16_t {
-        uint8_t lastBytes[2];
-        uint16_t syndrome16;
-      };
+      /*!
+       * @brief Checks @p length bytes ending in a CRC syndrome.
+       *
+       * @return True if the syndrome matches the preceding bytes
+       */
+      static bool valid(const uint8_t *data, size_t length, crc_size_t crcSize);
 
-      union dataSyndrome32_t {
-        uint8_t lastBytes[4];
-        uint32_t syndrome32;
-      };
+    private:
 
+      crc_size_t m_crcSize;
+      uint32_t m_checksum;
     };
 
   } /* namespace sdr */
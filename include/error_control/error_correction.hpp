@@ -96,7 +96,9 @@ namespace ex2 {
 
         NO_FEC                                    = 0x0030, // No FEC
 
-        LAST                                      = 0x0031 // This gets changes if we add more schemes
+        CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2 = 0x0031, // Reed-Solomon (255,223) interleaving 4 + convolutional coding rate 1/2
+
+        LAST                                      = 0x0032 // This gets changes if we add more schemes
       };
 
       static const std::string ErrorCorrectionName(ErrorCorrectionScheme ecScheme);
@@ -0,0 +1,121 @@
+/*!
+ * @file galoisLFSR.h
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details A Galois linear feedback shift register (LFSR) of up to 64 bits.
+ *
+ * Each step shifts the register right by one bit; the bit shifted out is the
+ * output and, if it is a one, the register is XORed with the polynomial. The
+ * polynomial is written as a tap mask where bit t-1 is set for each term x^t,
+ * the constant term being implied, so 1 + x^11 + x^13 + x^14 + x^16 is
+ * 0xB400. A register of order n with a primitive polynomial and a non-zero
+ * fill repeats every 2^n - 1 steps, i.e., it generates a maximum length
+ * sequence.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#ifndef EX2_SDR_ERROR_CONTROL_GALOIS_LFSR_H_
+#define EX2_SDR_ERROR_CONTROL_GALOIS_LFSR_H_
+
+#include <cstdint>
+
+namespace ex2 {
+  namespace sdr {
+
+    class GaloisLFSR {
+    public:
+
+      /*!
+       * @brief A primitive polynomial for a register of the given order
+       *
+       * @details The taps are those of Xilinx application note XAPP052
+       * except for order 16, which is 1 + x^11 + x^13 + x^14 + x^16.
+       *
+       * @param[in] order The number of register bits in the range [2,64]
+       * @return The polynomial tap mask
+       * @throws std::runtime_error if @p order is out of range
+       */
+      static uint64_t polynomialForOrder(uint32_t order);
+
+      /*!
+       * @brief Constructor
+       *
+       * @param[in] polynomial The tap mask; its most significant set bit
+       * determines the order
+       * @param[in] initialFill The initial register contents
+       * @throws std::runtime_error if @p polynomial is zero or @p initialFill
+       * is zero or has bits beyond the order
+       */
+      GaloisLFSR(uint64_t polynomial, uint64_t initialFill);
+
+      ~GaloisLFSR();
+
+      uint64_t
+      polynomial() const
+      {
+        return m_polynomial;
+      }
+
+      uint32_t
+      order() const
+      {
+        return m_order;
+      }
+
+      /*!
+       * @brief The current register contents
+       */
+      uint64_t
+      state() const
+      {
+        return m_state;
+      }
+
+      /*!
+       * @brief Restore the initial fill
+       */
+      void
+      reset()
+      {
+        m_state = m_initialFill;
+      }
+
+      /*!
+       * @brief Step once
+       *
+       * @return The output bit
+       */
+      uint8_t
+      nextBit()
+      {
+        uint8_t bit = m_state & 0x01;
+        m_state >>= 1;
+        if (bit) {
+          m_state ^= m_polynomial;
+        }
+        return bit;
+      }
+
+      /*!
+       * @brief Step eight times
+       *
+       * @return The output bits, the first in the most significant bit
+       */
+      uint8_t nextByte();
+
+    private:
+      uint64_t m_polynomial;
+      uint64_t m_initialFill;
+      uint64_t m_state;
+      uint32_t m_order;
+    };
+
+  } /* namespace sdr */
+} /* namespace ex2 */
+
+#endif /* EX2_SDR_ERROR_CONTROL_GALOIS_LFSR_H_ */
@@ -14,9 +14,11 @@
 #ifndef EX2_SDR_ERROR_CONTROL_SCRAMBLER_H_
 #define EX2_SDR_ERROR_CONTROL_SCRAMBLER_H_
 
+#include <complex>
 #include <cstdint>
+#include <vector>
 
-#include "ppdu_u8.hpp"
+#include "phy_layer/pdu/ppdu_u8.hpp"
 #include "galoisLFSR.h"
 
 namespace ex2 {
@@ -39,6 +41,15 @@ namespace ex2 {
      * Generators, application note (xapp052.pdf)[https://www.xilinx.com/support/documentation/application_notes/xapp052.pdf]
      * for other examples, though we don't use the n=16 polynomial suggested there
      *
+     * Every call scrambles from the start of the sequence, so each frame is
+     * scrambled on its own and scrambling twice restores the original. Bits
+     * are scrambled msb first. Float and complex samples are scrambled by
+     * flipping the sign of sample i when sequence bit i is one.
+     *
+     * The sequence is generated once and kept packed, extended only when a
+     * longer frame than any before arrives, so scrambling a frame is a single
+     * pass that XORs whole words of the sequence into the data.
+     *
      * @todo insert diagram
      */
     class Scrambler {
@@ -70,44 +81,44 @@ namespace ex2 {
 
       ~Scrambler();
 
+      /*!
+       * @brief Generate the sequence for frames of up to @p length bits or
+       * samples ahead of time, so scrambling them never allocates
+       */
+      void reserve(size_t length);
+
       /*!
        * @brief Scramble (descramble) a payload
        *
        * @param[in] original Input byte vector aka payload
-       * @param[inout] scrambled Scrambled @p original
-       *
-       * @todo Should be able to scramble in-place
+       * @param[inout] scrambled Scrambled @p original; may be @p original
        */
-      void scramble(PPDU_u8::payload_t& original,
+      void scramble(const PPDU_u8::payload_t& original,
           PPDU_u8::payload_t& scrambled);
 
       /*!
        * @brief Scramble (descramble) a vector
        *
        * @param[in] original Input float vector
-       * @param[inout] scrambled Scrambled @p original
-       *
-       * @todo Should be able to scramble in-place
+       * @param[inout] scrambled Scrambled @p original; may be @p original
        */
-      void scramble(std::vector<float>& original,
+      void scramble(const std::vector<float>& original,
           std::vector<float>& scrambled);
 
       /*!
        * @brief Scramble (descramble) a vector
        *
        * @param[in] original Input complex float vector
-       * @param[inout] scrambled Scrambled @p original
-       *
-       * @todo Should be able to scramble in-place
+       * @param[inout] scrambled Scrambled @p original; may be @p original
        */
-      void scramble(std::vector<std::complex<float>>& original,
+      void scramble(const std::vector<std::complex<float>>& original,
           std::vector<std::complex<float>>& scrambled);
 
     private:
-      GaloisLFSR *m_lfsr;
+      GaloisLFSR m_lfsr;
 
-      // support for bit reversal
-      uint8_t bitReverse(uint8_t byte);
+      // The sequence generated so far, packed msb first
+      std::vector<uint8_t> m_sequence;
     };
 
   } /* namespace sdr */
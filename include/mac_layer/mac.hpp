@@ -30,6 +30,10 @@
 #define MAC_MAX_RX_BUFFERS MAC_SERVICE_QUEUE_LENGTH
 #define MAC_MAX_TX_BUFFERS MAC_SERVICE_QUEUE_LENGTH
 
+// The number of candidate decodings per codeword tried when a packet fails
+// its CRC
+#define MAC_DEFAULT_DECODE_LIST_SIZE 4
+
 
 namespace ex2
 {
@@ -104,6 +108,58 @@ namespace ex2
         m_rfModeNumber = rfModeNumber;
       }
 
+      /*!
+       * @brief Accessor
+       *
+       * @return True if packets carry a CRC-32
+       */
+      bool
+      getPacketCRC () const
+      {
+        return m_packetCRC;
+      }
+
+      /*!
+       * @brief Accessor
+       *
+       * @details When on, a CRC-32 is appended to each packet before it is
+       * encoded and checked when it is received. Packets that fail the check
+       * are retried with other candidate decodings from the FEC and are
+       * dropped if none pass. Both ends of the link must agree. Off by default.
+       *
+       * @param packetCRC True to add and check packet CRCs
+       */
+      void
+      setPacketCRC (bool packetCRC)
+      {
+        m_packetCRC = packetCRC;
+      }
+
+      /*!
+       * @brief Accessor
+       *
+       * @param decodeListSize The maximum number of candidate decodings per
+       * codeword to try when a packet fails its CRC; 1 tries none. Only FEC
+       * schemes that support list decoding are retried.
+       */
+      void
+      setDecodeListSize (unsigned int decodeListSize)
+      {
+        m_decodeListSize = decodeListSize;
+      }
+
+      /*!
+       * @brief Accessor
+       *
+       * @return The number of received packets dropped because no decoding
+       * passed the packet CRC
+       */
+      uint32_t
+      getCorruptPacketCount () const
+      {
+        return m_corruptPacketCount;
+      }
+
       /************************************************************************/
       /* Receive from PHY (UHF Radio) methods                                 */
       /************************************************************************/
@@ -179,6 +235,11 @@ namespace ex2
        * transmission by the UHF radio in transparent mode. If the method returns
        * true, then there will be raw MPDUs in the mpdu payloads buffer
        *
+       * A packet is not encoded if it needs more MPDUs than the MPDU header
+       * codeword fragment index can count, MPDUHeader::maxCodewordFragments.
+       * Low rate schemes with long codewords, e.g., the Turbo rate 1/4 and 1/6
+       * schemes, can't carry packets as long as MAC_MAX_USER_PACKET_LENGTH.
+       *
        * @param packet
        * @param len
        *
@@ -208,9 +269,29 @@ namespace ex2
       void m_updateErrorCorrection(
         ErrorCorrection::ErrorCorrectionScheme errorCorrectionScheme);
 
+      /*!
+       * @brief Reserve every buffer for the largest user packet the current
+       * FEC scheme can carry, so packets are processed without allocating
+       */
+      void m_reserveBuffers();
+
       void m_processFirstMPDU(MPDU &firstMPDU);
 
-      void m_decodePacket();
+      /*!
+       * @brief Decode the received codewords into the raw packet buffer
+       *
+       * @return False if packet CRCs are on and no decoding passed the check
+       */
+      bool m_decodePacket();
+
+      /*!
+       * @brief Look for a decoding of the received codewords that passes the
+       * packet CRC, trying each codeword's alternatives in turn
+       *
+       * @return True if one was found, in which case it is in the raw packet
+       * buffer
+       */
+      bool m_listDecodePacket();
 
       // member vars that define the MAC operation
       ErrorCorrection *m_errorCorrection = 0;
@@ -222,6 +303,14 @@ namespace ex2
       // buffers needed to fragment a packet prior to transmission
       std::vector<uint8_t> m_codewordBuffer;
       std::vector<uint8_t> m_transparentModePayloads;
+      std::vector<uint8_t> m_message;
+      std::vector<uint8_t> m_mpduPayload;
+      std::vector<uint8_t> m_crcPacket;
+
+      // buffers needed to reassemble a received packet
+      std::vector<uint8_t> m_receivedMPDU;
+      std::vector<uint8_t> m_codeword;
+      std::vector<uint8_t> m_decodedMessage;
 
       // member vars to track received packet fragments
       bool m_firstFragmentReceived;
@@ -231,6 +320,10 @@ namespace ex2
 
       float m_SNREstimate;
 
+      bool m_packetCRC = false;
+      unsigned int m_decodeListSize = MAC_DEFAULT_DECODE_LIST_SIZE;
+      uint32_t m_corruptPacketCount = 0;
+
       std::vector<uint8_t> m_rawPacket;
     };
 
@@ -101,6 +101,17 @@ namespace ex2 {
         return m_codewordFragmentIndex;
       }
 
+      /*!
+       * @brief The most MPDUs a packet can be sent in
+       *
+       * @return The number of distinct codeword fragment indices
+       */
+      static uint16_t
+      maxCodewordFragments ()
+      {
+        return 1 << k_codewordFragmentIndex;
+      }
+
       /*!
        * @brief Return the FEC scheme codeword length
        *
@@ -14,9 +14,12 @@
 #ifndef EX2_SDR_MAC_LAYER_PDU_MPDU_UTILS_H_
 #define EX2_SDR_MAC_LAYER_PDU_MPDU_UTILS_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
+#include "bitBuffer.hpp"
+
 namespace ex2
 {
   namespace sdr
@@ -35,6 +38,11 @@ namespace ex2
      *
      * In the unpacked representation, symbols bits are placed in the byte's
      * least significant bits.
+     *
+     * Packing to and from 1 bit per symbol uses the best kernel for the host
+     * CPU (see cpuFeatures.hpp); other repacking shifts whole symbols through
+     * a register. Bit reversal and rolling work on whole words of the packed
+     * bits. Nothing is reallocated unless the payload must grow.
      */
 
     class MPDUUtility
@@ -66,6 +74,72 @@ namespace ex2
        */
       static void repack(std::vector<uint8_t>& payload, BitsPerSymbol currentBps, BitsPerSymbol newBps);
 
+      /*!
+       * @brief Repack the symbols into an output vector.
+       *
+       * @details @p out is resized to fit, so reusing it avoids reallocation.
+       *
+       * @param[in] in A byte vector
+       * @param[in] currentBps Current number of bits per symbol
+       * @param[in] newBps New number of bits per symbol
+       * @param[out] out The repacked symbols
+       */
+      static void repack(const std::vector<uint8_t>& in, BitsPerSymbol currentBps, BitsPerSymbol newBps,
+        std::vector<uint8_t>& out);
+
+      /*!
+       * @brief Repack the symbols into an output buffer.
+       *
+       * @param[in] in The symbols
+       * @param[in] count The number of symbols in @p in
+       * @param[in] currentBps Current number of bits per symbol
+       * @param[in] newBps New number of bits per symbol
+       * @param[out] out At least repackedLength(count, currentBps, newBps)
+       * bytes; may be @p in, but must not otherwise overlap it
+       */
+      static void repack(const uint8_t *in, size_t count, BitsPerSymbol currentBps, BitsPerSymbol newBps,
+        uint8_t *out);
+
+      /*!
+       * @brief Repack a span of bits into symbols.
+       *
+       * @details The bits need not be a whole number of bytes or start at
+       * the beginning of a byte. A partial last symbol is left justified.
+       *
+       * @param[in] bits The bits
+       * @param[in] newBps New number of bits per symbol
+       * @param[out] out The (bits.size() + newBps - 1)/newBps symbols
+       */
+      static void repack(ConstBitSpan bits, BitsPerSymbol newBps, std::vector<uint8_t>& out);
+
+      /*!
+       * @brief Repack symbols into a bit buffer.
+       *
+       * @param[in] in The symbols
+       * @param[in] currentBps Current number of bits per symbol
+       * @param[out] out The in.size() * currentBps bits
+       */
+      static void repack(const std::vector<uint8_t>& in, BitsPerSymbol currentBps, BitBuffer& out);
+
+      /*!
+       * @brief The number of symbols after repacking.
+       *
+       * @details If the bits do not divide evenly the last symbol is partial
+       * and its bits are left justified.
+       *
+       * @param[in] count The number of symbols
+       * @param[in] currentBps Current number of bits per symbol
+       * @param[in] newBps New number of bits per symbol
+       * @return The number of symbols at @p newBps
+       */
+      static size_t repackedLength(size_t count, BitsPerSymbol currentBps, BitsPerSymbol newBps);
+
+      /*!
+       * @brief The names of the pack and unpack kernels in use, e.g., "avx2"
+       */
+      static const char *packKernelName();
+      static const char *unpackKernelName();
+
       /*!
        * @brief Reverse the order of the payload
        *
@@ -86,6 +160,26 @@ namespace ex2
        */
       static void roll(std::vector<uint8_t>& payload, BitsPerSymbol currentBps, uint32_t numBits, bool left);
 
+      /*!
+       * @brief Reverse the order of a packed bit stream in place.
+       *
+       * @param[in out] data The bits, msb first; a partial last byte is left
+       * justified
+       * @param[in] bits The number of bits in @p data
+       */
+      static void reverseBits(uint8_t *data, size_t bits);
+
+      /*!
+       * @brief Roll a packed bit stream right or left in place.
+       *
+       * @param[in out] data The bits, msb first; a partial last byte is left
+       * justified and its padding is cleared
+       * @param[in] bits The number of bits in @p data
+       * @param[in] numBits The number of bit positions to roll the bits
+       * @param[in] left If true, roll the bits left. Otherwise roll right.
+       */
+      static void rotateBits(uint8_t *data, size_t bits, size_t numBits, bool left);
+
     private:
 
 
@@ -93,11 +187,13 @@ namespace ex2
        * @brief Pack 1-bit symbols into bytes
        */
       static void pack(std::vector<uint8_t>& payload);
+      static void pack(const uint8_t *in, size_t count, uint8_t *out);
 
       /*!
        * @brief Unpack bytes into 1-bit symbols
        */
       static void unpack(std::vector<uint8_t>& payload);
+      static void unpack(const uint8_t *in, size_t count, uint8_t *out);
 
     };
 
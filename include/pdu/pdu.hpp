@@ -7,6 +7,9 @@
  * vector that is either @p uint8_t, @p uint32_t, @p float, @p complex<float>,
  * or @p complex<double>
  *
+ * The payload may also be an external buffer, which is only copied if the
+ * payload is modified, so a received frame can be wrapped without copying.
+ *
  * @copyright University of Alberta 2021
  *
  * @license
@@ -16,7 +19,10 @@
 #ifndef EX2_SDR_PDU_PDU_H_
 #define EX2_SDR_PDU_PDU_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace ex2 {
@@ -34,18 +40,25 @@ namespace ex2 {
       /*!
        * @brief Constructor
        */
-      PDU () {};
+      PDU () : m_external(nullptr), m_externalLength(0) {};
+
+      /*!
+       * @brief Constructor
+       *
+       * @param[in] payload The PDU payload, which is copied, or moved if it
+       * is an rvalue.
+       */
+      PDU (payload_t payload) :
+        m_payload(std::move(payload)), m_external(nullptr), m_externalLength(0) {};
 
       /*!
        * @brief Constructor
        *
-       * @param[in] payload The PDU payload, which is copied.
+       * @param[in] data The PDU payload, which is copied.
+       * @param[in] count The number of payload elements
        */
-      PDU (payload_t payload) {
-        m_payload.reserve(payload.size());
-        for (uint32_t i = 0; i < payload.size(); i++)
-          m_payload.push_back(payload[i]);
-      };
+      PDU (const T *data, size_t count) :
+        m_payload(data, data + count), m_external(nullptr), m_externalLength(0) {};
 
       virtual
       ~PDU () {};
@@ -53,12 +66,24 @@ namespace ex2 {
       /*!
        * @brief Accessor - payload
        *
+       * @note If the payload is an external buffer, it is copied first; use
+       * @p data and @p payloadLength to avoid that.
+       *
        * @return payload
        */
       const payload_t& getPayload() const {
+        // Owning the payload doesn't change it, so is allowed for a const PDU
+        const_cast<PDU *>(this)->m_own();
         return m_payload;
       }
 
+      /*!
+       * @brief The payload elements, wherever they are.
+       */
+      const T *data() const {
+        return m_external ? m_external : m_payload.data();
+      }
+
       /*!
        * @brief The number of payload elements.
        *
@@ -66,11 +91,88 @@ namespace ex2 {
        */
       unsigned long
       payloadLength () const {
-        return m_payload.size();
+        return m_external ? m_externalLength : m_payload.size();
+      }
+
+      /*!
+       * @brief Append elements to the payload.
+       *
+       * @param[in] data The elements, which are copied
+       * @param[in] count The number of elements
+       */
+      void
+      append (const T *data, size_t count) {
+        m_own();
+        // The elements may be in the payload itself, so grow it first
+        const size_t start = m_payload.size();
+        const bool inPayload = (start > 0) && data >= m_payload.data() && data < m_payload.data() + start;
+        const size_t offset = inPayload ? data - m_payload.data() : 0;
+        m_payload.resize(start + count);
+        if (inPayload) {
+          data = m_payload.data() + offset;
+        }
+        std::copy(data, data + count, m_payload.begin() + start);
+      }
+
+      void
+      append (const payload_t& payload) {
+        append(payload.data(), payload.size());
+      }
+
+      /*!
+       * @brief Reserve space for @p count payload elements so appends don't
+       * reallocate.
+       */
+      void
+      reserve (size_t count) {
+        m_own();
+        m_payload.reserve(count);
+      }
+
+      /*!
+       * @brief Use an external buffer as the payload without copying it.
+       *
+       * @details The buffer must stay valid and unchanged until the PDU is
+       * destroyed, another buffer is attached, or the payload is modified;
+       * modifying the payload copies the buffer first, so it is never written.
+       *
+       * @param[in] buffer The payload elements
+       * @param[in] count The number of payload elements
+       */
+      void
+      attach (const T *buffer, size_t count) {
+        m_payload.clear();
+        m_external = buffer;
+        m_externalLength = count;
+      }
+
+      /*!
+       * @brief Indicate if the payload is an external buffer.
+       */
+      bool
+      isExternal () const {
+        return m_external != nullptr;
       }
 
     protected:
       payload_t m_payload;
+
+      /*!
+       * @brief Copy an external payload buffer so @p m_payload can be
+       * used and modified.
+       */
+      void
+      m_own () {
+        if (m_external) {
+          m_payload.assign(m_external, m_external + m_externalLength);
+          m_external = nullptr;
+          m_externalLength = 0;
+        }
+      }
+
+    private:
+      const T *m_external;
+      size_t m_externalLength;
     };
 
   } /* namespace sdr */
@@ -17,6 +17,7 @@
 #include <complex>
 #include <cstdint>
 #include <functional>
+#include <utility>
 
 #include "pdu.hpp"
 
@@ -49,9 +50,17 @@ namespace ex2
       /*!
        * @brief Constructor
        *
-       * @param[in] payload Complex float data, which is copied.
+       * @param[in] payload Complex float data, which is copied, or moved if it is an rvalue.
        */
-      PPDU_cf (const payload_t& payload) : PDU(payload) { };
+      PPDU_cf (payload_t payload) : PDU(std::move(payload)) { };
+
+      /*!
+       * @brief Constructor
+       *
+       * @param[in] data Complex float data, which is copied.
+       * @param[in] count The number of elements
+       */
+      PPDU_cf (const std::complex<float> *data, size_t count) : PDU(data, count) { };
 
       virtual
       ~PPDU_cf () { };
@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <utility>
 
 #include "pdu.hpp"
 
@@ -48,9 +49,17 @@ namespace ex2
       /*!
        * @brief Constructor
        *
-       * @param[in] payload Float data, which is copied.
+       * @param[in] payload Float data, which is copied, or moved if it is an rvalue.
        */
-      PPDU_f (const payload_t& payload) : PDU(payload) { };
+      PPDU_f (payload_t payload) : PDU(std::move(payload)) { };
+
+      /*!
+       * @brief Constructor
+       *
+       * @param[in] data Float data, which is copied.
+       * @param[in] count The number of elements
+       */
+      PPDU_f (const float *data, size_t count) : PDU(data, count) { };
 
       virtual
       ~PPDU_f () { };
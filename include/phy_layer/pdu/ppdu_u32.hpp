@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <utility>
 
 #include "pdu.hpp"
 
@@ -48,9 +49,17 @@ namespace ex2
       /*!
        * @brief Constructor
        *
-       * @param[in] payload uint32_t data, which is copied.
+       * @param[in] payload uint32_t data, which is copied, or moved if it is an rvalue.
        */
-      PPDU_u32 (const payload_t& payload) : PDU(payload) { };
+      PPDU_u32 (payload_t payload) : PDU(std::move(payload)) { };
+
+      /*!
+       * @brief Constructor
+       *
+       * @param[in] data uint32_t data, which is copied.
+       * @param[in] count The number of elements
+       */
+      PPDU_u32 (const uint32_t *data, size_t count) : PDU(data, count) { };
 
       virtual
       ~PPDU_u32 () { };
@@ -16,6 +16,7 @@
 
 #include <functional>
 
+#include "bitBuffer.hpp"
 #include "pdu.hpp"
 
 namespace ex2
@@ -41,12 +42,6 @@ namespace ex2
     class PPDU_u8 :
         public PDU<uint8_t>
     {
-      /*!
-       * @details Make @p crc a friend so that we can avoid copying the payload
-       * for CRC operations.
-       */
-      friend class crc;
-
     public:
 
       /*!
@@ -79,7 +74,8 @@ namespace ex2
       /*!
        * @brief Constructor
        *
-       * @param[in] payload unsigned 8-bit data, which is copied
+       * @param[in] payload unsigned 8-bit data, which is copied, or moved if
+       * it is an rvalue
        * @param[in] bps The number of bits per symbol
        *
        * @note The default @p bps value is 8 bits per symbol. This let's you
@@ -87,19 +83,60 @@ namespace ex2
        * with a bit stream (i.e., symbols are concatenated)
        */
         PPDU_u8 (
-        const payload_t& payload,
+        payload_t payload,
+        const BitsPerSymbol bps = BitsPerSymbol::BPSymb_8);
+
+      /*!
+       * @brief Constructor
+       *
+       * @param[in] data unsigned 8-bit data, which is copied
+       * @param[in] count The number of symbols
+       * @param[in] bps The number of bits per symbol
+       */
+        PPDU_u8 (
+        const uint8_t *data,
+        size_t count,
+        const BitsPerSymbol bps = BitsPerSymbol::BPSymb_8);
+
+      /*!
+       * @brief Constructor
+       *
+       * @param[in] bits Packed bits, which are repacked into symbols; a
+       * partial last symbol is left justified
+       * @param[in] bps The number of bits per symbol
+       */
+        PPDU_u8 (
+        ConstBitSpan bits,
         const BitsPerSymbol bps = BitsPerSymbol::BPSymb_8);
 
       virtual
       ~PPDU_u8 ();
 
+      using PDU<uint8_t>::append;
+
+      /*!
+       * @brief Use an external buffer as the payload without copying it.
+       *
+       * @details As for @p PDU::attach, except that if any symbol has bits
+       * set above the bits per symbol, the buffer is copied and masked like
+       * the constructors do, so the payload never carries stray high bits.
+       *
+       * @param[in] buffer The payload symbols
+       * @param[in] count The number of payload symbols
+       */
+      void
+      attach (const uint8_t *buffer, size_t count);
+
       /*!
        * @brief Append the payload from another @p PPDU_u8 to this one.
        *
+       * @details If @p ppdu has a different number of bits per symbol, its
+       * symbols are repacked straight into this payload.
+       *
        * @param[in] ppdu A payload to append, which is copied.
        */
       void
-      append(PPDU_u8& ppdu);
+      append(const PPDU_u8& ppdu);
 
       /*!
        * @brief Bits per symbol accessor.
@@ -109,6 +146,14 @@ namespace ex2
       BitsPerSymbol
       getBps () const;
 
+      /*!
+       * @brief The payload symbols as packed bits.
+       *
+       * @return payloadLength() * getBps() bits
+       */
+      BitBuffer
+      bits () const;
+
       /*!
        * @brief Repack the symbols.
        *
@@ -149,10 +194,10 @@ namespace ex2
 
       typedef payload_t::pointer data_ptr_t;
 
-      void
-      append (
-        const uint8_t *data,
-        const size_t count);
+      /*!
+       * @brief Clear the bits above @p m_bps in each symbol
+       */
+      void m_maskSymbols();
 
       /*!
        * @brief Pack 1-bit symbols into bytes
@@ -0,0 +1,254 @@
+/*!
+ * @file bitBuffer.hpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Packed bit spans and buffers shared by the PHY, MAC and FEC.
+ *
+ * Bits are packed msb first, the same as payloads and codewords everywhere
+ * else, so a byte vector is a bit span without conversion. A span may start
+ * at any bit of its first byte and hold any number of bits, e.g., the 324
+ * bit message of IEEE_802_11N_QCLDPC_648_R_1_2.
+ *
+ * A BitSpan or ConstBitSpan does not own its bits; a BitBuffer does and keeps
+ * the unused bits of its last byte zero, so its bytes can be sent as they are.
+ * Conversion to and from symbols of other sizes, including one bit per byte,
+ * is done by MPDUUtility::repack.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#ifndef EX2_SDR_UTILITIES_BIT_BUFFER_H_
+#define EX2_SDR_UTILITIES_BIT_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace ex2 {
+  namespace sdr {
+
+    /*!
+     * @brief A non-owning view of packed bits.
+     *
+     * @details Use BitSpan to modify the bits and ConstBitSpan to read them.
+     * Bit positions count from 0 at @p offset bits into the first byte.
+     */
+    template <typename Byte>
+    class BasicBitSpan {
+    public:
+
+      BasicBitSpan() : m_data(nullptr), m_offset(0), m_size(0) {}
+
+      /*!
+       * @brief Constructor
+       *
+       * @param[in] data The first byte
+       * @param[in] size The number of bits
+       * @param[in] offset The position of the first bit in @p data, msb = 0
+       */
+      BasicBitSpan(Byte *data, size_t size, size_t offset = 0)
+      : m_data(data + offset / 8), m_offset(offset % 8), m_size(size) {}
+
+      /*!
+       * @brief All the bits of a byte vector
+       */
+      explicit BasicBitSpan(typename std::conditional<std::is_const<Byte>::value,
+        const std::vector<uint8_t>, std::vector<uint8_t> >::type& bytes)
+      : m_data(bytes.data()), m_offset(0), m_size(bytes.size() * 8) {}
+
+      /*!
+       * @brief A BitSpan is also a ConstBitSpan
+       */
+      template <typename Other, typename = typename std::enable_if<
+        std::is_const<Byte>::value && !std::is_const<Other>::value>::type>
+      BasicBitSpan(const BasicBitSpan<Other>& other)
+      : m_data(other.data()), m_offset(other.offset()), m_size(other.size()) {}
+
+      Byte *data() const { return m_data; }
+      size_t offset() const { return m_offset; }
+      size_t size() const { return m_size; }
+      bool empty() const { return m_size == 0; }
+
+      /*!
+       * @brief True if the first bit is the msb of a byte
+       */
+      bool byteAligned() const { return m_offset == 0; }
+
+      bool get(size_t pos) const
+      {
+        size_t b = m_offset + pos;
+        return (m_data[b / 8] >> (7 - b % 8)) & 0x01;
+      }
+      bool operator[](size_t pos) const { return get(pos); }
+
+      /*!
+       * @brief Get up to 64 bits as an integer
+       *
+       * @param[in] pos The first bit
+       * @param[in] count The number of bits, at most 64
+       * @return The bits, the first in bit @p count - 1 of the result
+       */
+      uint64_t extract(size_t pos, unsigned int count) const
+      {
+        if (count > 32) {
+          return (extract(pos, count - 32) << 32) | extract(pos + count - 32, 32);
+        }
+        if (count == 0) return 0;
+
+        // At most 5 bytes hold 32 bits at any offset
+        size_t first = m_offset + pos;
+        size_t last = first + count - 1;
+        const Byte *p = m_data + first / 8;
+        uint64_t v = 0;
+        for (size_t i = 0; i <= last / 8 - first / 8; i++) {
+          v = (v << 8) | p[i];
+        }
+        v >>= 7 - last % 8;
+        return v & (~0ULL >> (64 - count));
+      }
+
+      /*!
+       * @brief The bits from @p pos to @p pos + @p count - 1
+       */
+      BasicBitSpan subspan(size_t pos, size_t count) const
+      {
+        return BasicBitSpan(m_data, count, m_offset + pos);
+      }
+
+      void set(size_t pos, bool value) const
+      {
+        static_assert(!std::is_const<Byte>::value, "ConstBitSpan is read only");
+        size_t b = m_offset + pos;
+        uint8_t mask = 0x80 >> (b % 8);
+        m_data[b / 8] = value ? (m_data[b / 8] | mask) : (m_data[b / 8] & ~mask);
+      }
+
+      /*!
+       * @brief Set up to 64 bits from an integer
+       *
+       * @param[in] pos The first bit
+       * @param[in] count The number of bits, at most 64
+       * @param[in] value The bits, the first in bit @p count - 1
+       */
+      void deposit(size_t pos, unsigned int count, uint64_t value) const
+      {
+        static_assert(!std::is_const<Byte>::value, "ConstBitSpan is read only");
+        if (count > 32) {
+          deposit(pos, count - 32, value >> 32);
+          deposit(pos + count - 32, 32, value);
+          return;
+        }
+        if (count == 0) return;
+
+        size_t first = m_offset + pos;
+        size_t last = first + count - 1;
+        uint64_t mask = (~0ULL >> (64 - count)) << (7 - last % 8);
+        value = (value << (7 - last % 8)) & mask;
+        Byte *p = m_data + first / 8;
+        for (size_t i = last / 8 - first / 8 + 1; i-- > 0; ) {
+          p[i] = (uint8_t) ((p[i] & ~mask) | value);
+          mask >>= 8;
+          value >>= 8;
+        }
+      }
+
+    private:
+      Byte *m_data;
+      size_t m_offset;  // 0 to 7
+      size_t m_size;
+    };
+
+    typedef BasicBitSpan<uint8_t> BitSpan;
+    typedef BasicBitSpan<const uint8_t> ConstBitSpan;
+
+    /*!
+     * @brief A growable buffer of packed bits.
+     */
+    class BitBuffer {
+    public:
+
+      BitBuffer() : m_size(0) {}
+
+      /*!
+       * @brief A buffer of @p size zero bits
+       */
+      explicit BitBuffer(size_t size);
+
+      /*!
+       * @brief A copy of all the bits of a byte vector
+       */
+      explicit BitBuffer(const std::vector<uint8_t>& bytes);
+
+      /*!
+       * @brief A copy of the bits of a span
+       */
+      explicit BitBuffer(ConstBitSpan bits);
+
+      size_t size() const { return m_size; }
+      bool empty() const { return m_size == 0; }
+
+      /*!
+       * @brief The bytes, (size() + 7)/8 of them; unused bits of the last
+       * byte are zero
+       */
+      const std::vector<uint8_t>& bytes() const { return m_bytes; }
+      uint8_t *data() { return m_bytes.data(); }
+      const uint8_t *data() const { return m_bytes.data(); }
+
+      BitSpan span() { return BitSpan(m_bytes.data(), m_size); }
+      ConstBitSpan span() const { return ConstBitSpan(m_bytes.data(), m_size); }
+      operator ConstBitSpan() const { return span(); }
+
+      bool get(size_t pos) const { return span().get(pos); }
+      bool operator[](size_t pos) const { return get(pos); }
+      void set(size_t pos, bool value) { span().set(pos, value); }
+      uint64_t extract(size_t pos, unsigned int count) const { return span().extract(pos, count); }
+      void deposit(size_t pos, unsigned int count, uint64_t value) { span().deposit(pos, count, value); }
+
+      /*!
+       * @brief Change the number of bits; new bits are zero
+       */
+      void resize(size_t size);
+
+      /*!
+       * @brief Reserve space for @p size bits
+       */
+      void reserve(size_t size) { m_bytes.reserve((size + 7) / 8); }
+
+      void clear() { resize(0); }
+
+      void append(bool bit);
+
+      /*!
+       * @brief Append up to 64 bits from an integer
+       *
+       * @param[in] value The bits, the first in bit @p count - 1
+       * @param[in] count The number of bits, at most 64
+       */
+      void append(uint64_t value, unsigned int count);
+
+      /*!
+       * @brief Append the bits of a span, which must not be in this buffer
+       */
+      void append(ConstBitSpan bits);
+
+      bool operator==(const BitBuffer& other) const
+      {
+        return m_size == other.m_size && m_bytes == other.m_bytes;
+      }
+      bool operator!=(const BitBuffer& other) const { return !(*this == other); }
+
+    private:
+      std::vector<uint8_t> m_bytes;
+      size_t m_size;
+    };
+
+  } /* namespace sdr */
+} /* namespace ex2 */
+
+#endif /* EX2_SDR_UTILITIES_BIT_BUFFER_H_ */
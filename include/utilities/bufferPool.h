@@ -0,0 +1,103 @@
+/*!
+ * @file bufferPool.h
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Fixed-size buffer pools carved from static arenas.
+ *
+ * Every buffer the driver and MAC use on the hot path has a size bounded at
+ * build time: an MPDU is at most UHF_TRANSPARENT_MODE_DATA_FIELD_2_MAX_LENGTH
+ * bytes and a user packet at most MAC_MAX_USER_PACKET_LENGTH bytes. A pool
+ * holds a fixed number of blocks of one such size in an arena that is part of
+ * the image, so taking and returning buffers never touches the heap and the
+ * worst case memory use is known when the image is linked.
+ *
+ * Pools are defined with OS_POOL_DEFINE at file scope and need no other
+ * initialization. Blocks are handed out from the arena until it is used up
+ * and after that from a list of returned blocks, both in constant time.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#ifndef EX2_SDR_UTILITIES_BUFFER_POOL_H_
+#define EX2_SDR_UTILITIES_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Blocks are aligned for any of the scalar types the MAC and FEC use */
+#define OS_POOL_ALIGN 8
+
+#define OS_POOL_BLOCK_SIZE(size) ((((size) + OS_POOL_ALIGN - 1) / OS_POOL_ALIGN) * OS_POOL_ALIGN)
+
+typedef struct os_pool {
+    uint8_t *arena;
+    size_t block_size;
+    size_t block_count;
+    /* Blocks taken from the arena so far */
+    size_t used;
+    /* Returned blocks, each holding a pointer to the next */
+    void *free_list;
+    size_t available;
+} os_pool_t;
+
+/**
+   Define a pool and its arena.
+
+   @param name The pool, an os_pool_t
+   @param size Bytes per block
+   @param count Number of blocks
+*/
+#define OS_POOL_DEFINE(name, size, count) \
+    static uint64_t name##_arena[OS_POOL_BLOCK_SIZE(size) * (count) / sizeof(uint64_t)]; \
+    os_pool_t name = { (uint8_t *)name##_arena, OS_POOL_BLOCK_SIZE(size), (count), 0, NULL, (count) }
+
+/**
+   Take a block from a pool.
+
+   @param[in] pool The pool
+   @return A block of at least the pool's block size, or NULL if none are left
+*/
+void *os_pool_alloc(os_pool_t *pool);
+
+/**
+   Return a block to the pool it was taken from.
+
+   @param[in] pool The pool
+   @param[in] block The block, or NULL to do nothing
+*/
+void os_pool_free(os_pool_t *pool, void *block);
+
+/**
+   Take a block from a pool in an interrupt handler.
+
+   @param[in] pool The pool
+   @return A block of at least the pool's block size, or NULL if none are left
+*/
+void *os_pool_alloc_from_isr(os_pool_t *pool);
+
+/**
+   Return a block to the pool it was taken from in an interrupt handler.
+
+   @param[in] pool The pool
+   @param[in] block The block, or NULL to do nothing
+*/
+void os_pool_free_from_isr(os_pool_t *pool, void *block);
+
+/**
+   @param[in] pool The pool
+   @return The number of blocks that can still be taken
+*/
+size_t os_pool_available(const os_pool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* EX2_SDR_UTILITIES_BUFFER_POOL_H_ */
@@ -0,0 +1,170 @@
+/*!
+ * @file cpuFeatures.hpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Runtime CPU feature detection and dispatch of hot kernels.
+ *
+ * A kernel is a free function with one or more implementations, each of which
+ * may require some instruction set extensions. The best implementation that
+ * the host CPU supports is bound on first use, so a single ground binary uses
+ * AVX2 on a new laptop and SSE2 on an old rack server. Every kernel has a
+ * portable scalar implementation requiring no features, which is all that is
+ * available on non-x86 targets such as the Hercules.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#ifndef EX2_SDR_UTILITIES_CPU_FEATURES_H_
+#define EX2_SDR_UTILITIES_CPU_FEATURES_H_
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+// Kernels specific to x86 are compiled with per-function target attributes so
+// the rest of the translation unit stays at the baseline instruction set.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define EX2_SDR_X86_KERNELS 1
+#else
+#define EX2_SDR_X86_KERNELS 0
+#endif
+
+namespace ex2 {
+  namespace sdr {
+
+    /*!
+     * @brief Instruction set extensions that kernels may require.
+     *
+     * @details The methods are all static; detection happens once on first use.
+     */
+    class CPUFeatures {
+    public:
+      enum Feature : uint32_t {
+        NONE     = 0x00,
+        SSE2     = 0x01,
+        SSSE3    = 0x02,
+        AVX2     = 0x04,
+        AVX512BW = 0x08,
+        BMI2     = 0x10,
+        PCLMUL   = 0x20,
+        ALL      = 0x3F
+      };
+
+      /*!
+       * @brief The features supported by the host CPU and operating system.
+       */
+      static uint32_t detected();
+
+      /*!
+       * @brief The features kernels may use, i.e., those detected and not
+       * masked off by @p setMask.
+       */
+      static uint32_t enabled();
+
+      /*!
+       * @brief Restrict the features kernels may use.
+       *
+       * @details All kernels rebind on their next use. Mainly for testing the
+       * scalar implementations and comparing them to the accelerated ones.
+       *
+       * @param[in] mask Features to allow; CPUFeatures::ALL removes the restriction
+       */
+      static void setMask(uint32_t mask);
+
+      static bool has(Feature f) { return (enabled() & f) == f; }
+
+      /*!
+       * @brief Incremented each time the enabled features change.
+       */
+      static uint32_t generation() { return m_generation.load(std::memory_order_acquire); }
+
+      /*!
+       * @brief Human readable list of features, e.g., "SSE2 SSSE3 AVX2"
+       */
+      static std::string toString(uint32_t features);
+
+    private:
+      static std::atomic<uint32_t> m_mask;
+      static std::atomic<uint32_t> m_generation;
+    };
+
+    /*!
+     * @brief A kernel bound at run time to its best implementation.
+     *
+     * @details Implementations are listed best first; the last one must
+     * require CPUFeatures::NONE. Intended to be a function-local or namespace
+     * scope static, e.g.,
+     *
+     * @code
+     * static const DispatchedKernel<void (*)(const uint8_t*, size_t)> k({
+     *   { "avx2", CPUFeatures::AVX2, fooAVX2 },
+     *   { "scalar", CPUFeatures::NONE, fooScalar } });
+     * k.get()(buf, len);
+     * @endcode
+     */
+    template <typename Fn>
+    class DispatchedKernel {
+    public:
+      struct Implementation {
+        const char *name;
+        uint32_t required;
+        Fn fn;
+      };
+
+      DispatchedKernel(std::initializer_list<Implementation> implementations)
+      : m_implementations(implementations), m_fn(nullptr), m_index(0), m_generation(0)
+      {
+      }
+
+      /*!
+       * @brief The best implementation for the enabled CPU features.
+       */
+      Fn get() const
+      {
+        uint32_t gen = CPUFeatures::generation();
+        if (m_generation.load(std::memory_order_acquire) != gen) {
+          m_bind(gen);
+        }
+        return m_fn.load(std::memory_order_relaxed);
+      }
+
+      /*!
+       * @brief The name of the implementation @p get returns.
+       */
+      const char *name() const
+      {
+        get();
+        return m_implementations[m_index.load(std::memory_order_relaxed)].name;
+      }
+
+    private:
+      const std::vector<Implementation> m_implementations;
+      mutable std::atomic<Fn> m_fn;
+      mutable std::atomic<uint32_t> m_index;
+      mutable std::atomic<uint32_t> m_generation;
+
+      // Concurrent binds are benign; they all choose the same implementation
+      void m_bind(uint32_t gen) const
+      {
+        uint32_t features = CPUFeatures::enabled();
+        uint32_t i = 0;
+        while (i + 1 < m_implementations.size() &&
+          (m_implementations[i].required & features) != m_implementations[i].required) {
+          i++;
+        }
+        m_index.store(i, std::memory_order_relaxed);
+        m_fn.store(m_implementations[i].fn, std::memory_order_relaxed);
+        m_generation.store(gen, std::memory_order_release);
+      }
+    };
+
+  } /* namespace sdr */
+} /* namespace ex2 */
+
+#endif /* EX2_SDR_UTILITIES_CPU_FEATURES_H_ */
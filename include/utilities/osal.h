@@ -41,6 +41,14 @@ os_queue_handle_t os_queue_create(int length, size_t item_size);
 
 int os_queue_enqueue(os_queue_handle_t handle, const void * value);
 
+/**
+   Enqueue from an interrupt handler.
+
+   @param[in] task_woken Set if a task waiting on the queue should run when
+   the handler returns, may be NULL
+*/
+int os_queue_enqueue_from_isr(os_queue_handle_t handle, const void * value, void *task_woken);
+
 int os_queue_dequeue(os_queue_handle_t handle, void* buf, uint32_t timeout);
 
 typedef void* os_task_handle_t;
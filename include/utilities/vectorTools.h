@@ -14,6 +14,7 @@
 #ifndef EX2_SDR_UTILITIES_VECTOR_TOOLS_H_
 #define EX2_SDR_UTILITIES_VECTOR_TOOLS_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -47,7 +48,30 @@ namespace ex2 {
        * @param[inout] out Vector of packed uint8_t (bytes). The length is the length of
        * @p in / 8, plus one if there is a remainder
        */
-      static void floatToBytes(float threshold, bool reverseBitOrder, std::vector<float>& in, std::vector<uint8_t>& out);
+      static void floatToBytes(float threshold, bool reverseBitOrder, const std::vector<float>& in, std::vector<uint8_t>& out);
+
+      /*!
+       * @brief Convert floats to packed bytes according to the threshold.
+       *
+       * @details The same as above for @p length floats at @p in, writing
+       * (@p length + 7) / 8 bytes to @p out, which must have room for them.
+       * Eight or 32 floats are thresholded at a time with SSE2 or AVX2 when
+       * the CPU has them. Unused bits of a final partial byte are zero.
+       *
+       * @param[in] threshold Input floats greater than @p threshold are deemed a
+       * binary 1, otherwise they are deemed a binary 0
+       * @param[in] reverseBitOrder If true, the first value in each group of 8
+       * is the lsb rather than the msb
+       * @param[in] in The floats
+       * @param[in] length The number of floats
+       * @param[out] out The packed bytes
+       */
+      static void floatToBytes(float threshold, bool reverseBitOrder, const float *in, size_t length, uint8_t *out);
+
+      /*!
+       * @brief The name of the floatToBytes implementation in use, e.g., "avx2"
+       */
+      static const char *floatToBytesKernelName();
 
       /*!
        * @brief Convert a vector of packed bytes to a vector of floats.
@@ -61,7 +85,20 @@ namespace ex2 {
        * @param[in] magnitude Magnitude of the corresponding float values
        * @param[inout] out Vector of floats
        */
-      static void bytesToFloat(std::vector<uint8_t>& in, bool packed, bool lsbFirst, bool nrz, float magnitude, std::vector<float>& out);
+      static void bytesToFloat(const std::vector<uint8_t>& in, bool packed, bool lsbFirst, bool nrz, float magnitude, std::vector<float>& out);
+
+      /*!
+       * @brief Convert packed bytes to floats.
+       *
+       * @details The same as above for @p length bytes at @p in, writing
+       * 8 * @p length floats to @p out if @p packed, otherwise @p length
+       * floats. @p out must have room for them. A binary 1 is @p magnitude
+       * and a binary 0 is -@p magnitude if @p nrz, otherwise zero. Packed
+       * bytes are expanded a byte at a time with SSE2 or AVX2 when the CPU
+       * has them.
+       */
+      static void bytesToFloat(const uint8_t *in, size_t length, bool packed, bool lsbFirst, bool nrz,
+        float magnitude, float *out);
 
       /*!
        * @brief Switch the order of elements in blocks of the vector.
@@ -72,12 +109,23 @@ namespace ex2 {
        *
        * @todo This could be templated.
        *
+       * Blocks are reversed a vector of floats at a time from both ends with
+       * SSE2 or AVX2 shuffles when the CPU has them.
+       *
        * @param[in] blockSize The number of contiguous elements to reverse in a
        * block-wise fashion
        * @param[inout] v The vector
        */
       static void blockReverse(uint32_t blockSize, std::vector<float>& v);
 
+      /*!
+       * @brief The names of the bytesToFloat and blockReverse implementations
+       * in use, e.g., "avx2"
+       */
+      static const char *bytesToFloatKernelName();
+
+      static const char *blockReverseKernelName();
+
     private:
     };
 
@@ -79,6 +79,20 @@ rf_mode_number_t get_rf_mode_number(mac_t *m);
  */
 bool set_rf_mode_number (mac_t *m, rf_mode_number_t rf_mode_number);
 
+/*!
+ * @brief Turn packet CRCs on or off
+ *
+ * @details When on, a CRC-32 is added to each packet sent and checked on each
+ * packet received, and packets that fail are dropped. Both ends of the link
+ * must agree.
+ *
+ * @param m Pointer to the MAC object wrapper
+ * @param packet_crc true to add and check packet CRCs
+ *
+ * @return true if success, false otherwise
+ */
+bool set_packet_crc(mac_t *m, bool packet_crc);
+
 /************************************************************************/
 /* Receive from PHY (UHF Radio) methods                                 */
 /************************************************************************/
@@ -0,0 +1,53 @@
+/*!
+ * @file crcWrapper.h
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details C wrapper for the CRC calculations, so drivers share them with
+ * the MAC.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+#ifndef EX2_SDR_WRAPPER_CRC_H_
+#define EX2_SDR_WRAPPER_CRC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The CRC-16/CCITT-FALSE of no data, from which a checksum is continued */
+#define CRC16_CCITT_INITIAL 0xFFFF
+
+/* The CRC-32 of no data, from which a checksum is continued */
+#define CRC32_INITIAL 0x00000000
+
+/*!
+ * @brief Continue a CRC-16/CCITT-FALSE checksum, as used by the UHF radio
+ *
+ * @param[in] crc The checksum of the preceding data, CRC16_CCITT_INITIAL if none
+ * @param[in] data The next bytes
+ * @param[in] len The number of bytes
+ * @return The checksum of the preceding data followed by @p data
+ */
+uint16_t crc16_ccitt_update(uint16_t crc, const uint8_t *data, size_t len);
+
+/*!
+ * @brief Continue an IEEE 802.3 CRC-32 checksum
+ *
+ * @param[in] crc The checksum of the preceding data, CRC32_INITIAL if none
+ * @param[in] data The next bytes
+ * @param[in] len The number of bytes
+ * @return The checksum of the preceding data followed by @p data
+ */
+uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* EX2_SDR_WRAPPER_CRC_H_ */
@@ -69,7 +69,9 @@ typedef enum {
 
   NO_FEC                                    = 48, //ErrorCorrection::ErrorCorrectionScheme::NO_FEC, // No FEC
 
-  LAST                                      = 49, //ErrorCorrection::ErrorCorrectionScheme::LAST // This gets changes if we add more schemes
+  CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2 = 49, //ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2, // Reed-Solomon (255,223) interleaving 4 + convolutional coding rate 1/2
+
+  LAST                                      = 50, //ErrorCorrection::ErrorCorrectionScheme::LAST // This gets changes if we add more schemes
 
   ERROR_CORRECTION_SCHEME_BAD_WRAPPER_CONTEXT = 100 // needed for wrapper existance checking
 
@@ -45,6 +45,14 @@ typedef enum {
 
 sdr_uhf_baud_rate_t get_uhf_baud_t_from_rf_mode_number(uint8_t rf_mode_number);
 
+/*!
+ * @brief The over the air bit rate of an RF mode
+ *
+ * @param rf_mode_number The RF mode
+ * @return The bit rate in bits per second
+ */
+uint16_t get_bit_rate_from_rf_mode_number(uint8_t rf_mode_number);
+
 
 #ifdef __cplusplus
 }
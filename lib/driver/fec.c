@@ -15,10 +15,11 @@ int fec_mpdu_to_data(mac_t *my_mac, const uint8_t *mpdu, uint8_t **data, int mtu
         const uint8_t *raw_packet = get_raw_packet_buffer(my_mac);
 
         int len = get_raw_packet_length(my_mac);
-        *data = os_malloc(len);
-        if (*data) {
-            memcpy(*data, raw_packet, len);
+        *data = os_pool_alloc(&sdr_packet_pool);
+        if (!*data) {
+            return 0;
         }
+        memcpy(*data, raw_packet, len);
         return len;
     }
     return 0;
@@ -29,110 +29,218 @@
 #include <fcntl.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <sys/errno.h>
 #include <osal.h>
 #include <sdr_driver.h>
+#include <crcWrapper.h>
+#include <radio.h>
 
 #define SA struct sockaddr
 
 #define RX_TASK_STACK_SIZE 4096
 
+// frames that fit in an interface's receive buffer, so one read can take many
+#define RX_BUFFER_FRAMES 32
+
 #define PREAMBLE_B 0xAA
 #define SYNCWORD 0x7E
-#define PREAMBLE_LEN 16
-#define POSTAMBLE_LEN 10
-#define PACKET_LEN 128
-#define CRC16_LEN 2
-#define SYNCWORD_LEN 1
-#define LEN_ID_LEN 1
-#define RADIO_LEN PREAMBLE_LEN + SYNCWORD_LEN + LEN_ID_LEN + PACKET_LEN + CRC16_LEN + POSTAMBLE_LEN
+#define PREAMBLE_LEN UHF_PREAMBLE_LENGTH
+#define POSTAMBLE_LEN UHF_POSTAMBLE_LENGTH
+#define PACKET_LEN UHF_TRANSPARENT_MODE_DATA_FIELD_2_MAX_LENGTH
+#define CRC16_LEN UHF_CRC16_LENGTH
+#define SYNCWORD_LEN UHF_SYNCWORD_LENGTH
+#define LEN_ID_LEN UHF_LENGTH_FIELD_LENGTH
+#define RADIO_LEN (PREAMBLE_LEN + SYNCWORD_LEN + LEN_ID_LEN + PACKET_LEN + CRC16_LEN + POSTAMBLE_LEN)
 //^^radio_len = preamble + sync word + length indicator + data + crc + postamble
 
-uint16_t crc16(uint8_t *pData, int length) {
-    uint8_t i;
-    uint16_t wCrc = 0xffff;
-    while (length--) {
-        wCrc ^= *(unsigned char *)pData++ << 8;
-        for (i = 0; i < 8; i++)
-            wCrc = wCrc & 0x8000 ? (wCrc << 1) ^ 0x1021 : wCrc << 1;
+typedef struct gnuradio_context {
+    int mtu;
+    int rxfd;
+    int fd;
+    sdr_rx_callback_t rx_callback;
+    void *user_data;
+    /** Frames to send, with their preamble, sync word and postamble in place */
+    uint8_t tx_frames[SDR_TX_BATCH_MPDUS][RADIO_LEN];
+    struct iovec tx_iov[SDR_TX_BATCH_MPDUS];
+    /** Received bytes, the start of a frame not yet complete */
+    uint8_t *rx_buf;
+    size_t rx_size;
+    size_t rx_len;
+} gnuradio_context_t;
+
+static gnuradio_context_t *gnuradio_contexts[SDR_MAX_INTERFACES];
+
+static gnuradio_context_t *gnuradio_context_for_tx(int fd) {
+    for (int i = 0; i < SDR_MAX_INTERFACES; i++) {
+        if (gnuradio_contexts[i] && gnuradio_contexts[i]->fd == fd) {
+            return gnuradio_contexts[i];
+        }
     }
-    return wCrc & 0xffff;
+    return NULL;
 }
 
-static int sdr_gnuradio_tx(int fd, const void *data, size_t len) {
-    // apply framing according to UHF user manual protocol
-    uint8_t *crc_command = os_malloc(LEN_ID_LEN + len);
-    crc_command[0] = (uint8_t)len;
+static void gnuradio_frame_init(uint8_t *frame) {
+    memset(frame, 0, RADIO_LEN);
+    memset(frame, PREAMBLE_B, PREAMBLE_LEN);
+    frame[PREAMBLE_LEN] = SYNCWORD;
+    memset(frame + RADIO_LEN - POSTAMBLE_LEN, PREAMBLE_B, POSTAMBLE_LEN);
+}
 
-    for (size_t i = 0; i < len; i++) {
-        crc_command[LEN_ID_LEN + i] = ((uint8_t *)data)[i];
-    }
+// apply framing according to UHF user manual protocol
+static void gnuradio_frame_fill(uint8_t *frame, const uint8_t *data, size_t len) {
+    uint8_t *len_id = frame + PREAMBLE_LEN + SYNCWORD_LEN;
+    len_id[0] = len;
+    memcpy(len_id + LEN_ID_LEN, data, len);
+
+    // the CRC covers the length indicator and the data
+    uint16_t crc_res = crc16_ccitt_update(CRC16_CCITT_INITIAL, len_id, LEN_ID_LEN + len);
 
-    uint16_t crc_res = crc16(crc_command, LEN_ID_LEN + len);
+    uint8_t *crc = len_id + LEN_ID_LEN + len;
+    crc[0] = ((uint16_t)crc_res >> 8) & 0xFF;
+    crc[1] = ((uint16_t)crc_res >> 0) & 0xFF;
+
+    // a short MPDU leaves zeros between the CRC and the postamble
+    memset(crc + CRC16_LEN, 0, PACKET_LEN - len);
+}
 
-    uint8_t radio_command[RADIO_LEN] = {0};
-    for (int i = 0; i < PREAMBLE_LEN; i++) {
-        radio_command[i] = PREAMBLE_B;
+// send to radio via tcp, continuing after partial sends
+static int gnuradio_send_frames(int fd, struct iovec *iov, size_t count) {
+    while (count > 0) {
+        struct msghdr msg = {0};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ssize_t sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (sent == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            printf("%s: sendmsg() failed: %d\n", __FUNCTION__, errno);
+            return SDR_ERR_DRIVER;
+        }
+        while (count > 0 && (size_t)sent >= iov->iov_len) {
+            sent -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (uint8_t *)iov->iov_base + sent;
+            iov->iov_len -= sent;
+        }
     }
 
-    for (int i = POSTAMBLE_LEN; i > 0; i--) {
-        radio_command[RADIO_LEN - i] = PREAMBLE_B;
+    return SDR_ERR_NONE;
+}
+
+static int sdr_gnuradio_txv(int fd, const uint8_t *const *mpdus, size_t len, size_t count) {
+    gnuradio_context_t *ctx = gnuradio_context_for_tx(fd);
+    if (ctx == NULL || len > PACKET_LEN || count > SDR_TX_BATCH_MPDUS) {
+        return SDR_ERR_DRIVER;
     }
 
-    radio_command[PREAMBLE_LEN] = SYNCWORD;
-    radio_command[PREAMBLE_LEN + SYNCWORD_LEN] = len;
-    for (size_t i = 0; i < len; i++) {
-        radio_command[PREAMBLE_LEN + SYNCWORD_LEN + LEN_ID_LEN + i] = ((uint8_t *)data)[i];
+    for (size_t i = 0; i < count; i++) {
+        gnuradio_frame_fill(ctx->tx_frames[i], mpdus[i], len);
+        ctx->tx_iov[i].iov_base = ctx->tx_frames[i];
+        ctx->tx_iov[i].iov_len = RADIO_LEN;
     }
 
-    radio_command[PREAMBLE_LEN + SYNCWORD_LEN + LEN_ID_LEN + len] = ((uint16_t)crc_res >> 8) & 0xFF;
-    radio_command[PREAMBLE_LEN + SYNCWORD_LEN + LEN_ID_LEN + len + 1] = ((uint16_t)crc_res >> 0) & 0xFF;
+    return gnuradio_send_frames(fd, ctx->tx_iov, count);
+}
+
+static int sdr_gnuradio_tx(int fd, const void *data, size_t len) {
+    const uint8_t *mpdu = data;
+    return sdr_gnuradio_txv(fd, &mpdu, len, 1);
+}
+
+// One thread receives for every interface
+static int gnuradio_epfd = -1;
+
+// TCP can split frames anywhere, so read as much as is waiting and pass on
+// only whole frames, keeping the start of the next for the following read.
+// Returns nonzero once the connection is closed or has failed.
+static int gnuradio_rx_read(gnuradio_context_t *ctx) {
+    ssize_t length;
+    do {
+        length = read(ctx->rxfd, ctx->rx_buf + ctx->rx_len, ctx->rx_size - ctx->rx_len);
+    } while (length == -1 && errno == EINTR);
 
-    // send to radio via tcp
-    if (send(fd, radio_command, RADIO_LEN, 0) == -1) {
-        printf("sdr_gnuradio_tx send() failed\n");
-        exit(1);
+    if (length == 0) {
+        printf("%s: connection closed\n", __FUNCTION__);
+        return -1;
+    }
+    if (length == -1) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
+        }
+        printf("%s: read() failed: %d\n", __FUNCTION__, errno);
+        return -1;
     }
 
-    os_free(crc_command);
+    ctx->rx_len += length;
+    size_t whole = ctx->rx_len - ctx->rx_len % ctx->mtu;
+    if (whole) {
+        ctx->rx_callback(ctx->user_data, ctx->rx_buf, whole, NULL);
+        ctx->rx_len -= whole;
+        memmove(ctx->rx_buf, ctx->rx_buf + whole, ctx->rx_len);
+    }
 
     return 0;
 }
 
-typedef struct gnuradio_context {
-    int mtu;
-    int rxfd;
-    int fd;
-    sdr_rx_callback_t rx_callback;
-    void *user_data;
-} gnuradio_context_t;
-
+// Each ready interface gets one read per wakeup, so a busy interface can't
+// starve the others. Whatever is left makes the socket ready again at once.
 static void *gnuradio_rx_thread(void *arg) {
-    gnuradio_context_t *ctx = arg;
-    uint8_t *data = os_malloc(ctx->mtu);
+    (void)arg;
+    struct epoll_event events[SDR_MAX_INTERFACES];
 
     while (1) {
-        int length = read(ctx->rxfd, data, ctx->mtu);
-        if (length == 0) {
-            printf("%s: connection closed\n", __FUNCTION__);
-            return NULL;
-        }
-        if (length == -1) {
-            printf("%s: read() failed: %d", __FUNCTION__, errno);
+        int count = epoll_wait(gnuradio_epfd, events, SDR_MAX_INTERFACES, -1);
+        if (count == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            printf("%s: epoll_wait() failed: %d\n", __FUNCTION__, errno);
             return NULL;
         }
-        if (length < ctx->mtu) {
-            printf("%s: short read %d<%d", __FUNCTION__, length, ctx->mtu);
-        }
 
-        ctx->rx_callback(ctx->user_data, data, length, NULL);
+        for (int i = 0; i < count; i++) {
+            gnuradio_context_t *ctx = events[i].data.ptr;
+            if (gnuradio_rx_read(ctx)) {
+                epoll_ctl(gnuradio_epfd, EPOLL_CTL_DEL, ctx->rxfd, NULL);
+            }
+        }
     }
     return NULL;
 }
 
+// Starts the rx thread the first time an interface is opened
+static int gnuradio_rx_start(void) {
+    if (gnuradio_epfd != -1) {
+        return 0;
+    }
+
+    gnuradio_epfd = epoll_create1(0);
+    if (gnuradio_epfd == -1) {
+        printf("%s: epoll_create1() failed: %d\n", __FUNCTION__, errno);
+        return -1;
+    }
+
+    if (os_task_create(gnuradio_rx_thread, "gnuradio_rx", 0, NULL, 0, 0)) {
+        printf("%s: os_thread_create() failed to create RX thread\n", __FUNCTION__);
+        close(gnuradio_epfd);
+        gnuradio_epfd = -1;
+        return -1;
+    }
+
+    return 0;
+}
+
 // Inits tcp tx and rx
 // starts rx thread
 static int gnuradio_tcp_open(const char *host, uint16_t port) {
@@ -155,14 +263,29 @@ static int gnuradio_tcp_open(const char *host, uint16_t port) {
     // connect the client socket to server socket
     if (connect(sockfd, (SA *)&servaddr, sizeof(servaddr)) != 0) {
         printf("connection to port %d failed: %d\n", port, errno);
+        close(sockfd);
         return -2;
     } else
         printf("Connected to the gnuradio TCP server..\n");
 
+    // frames are written whole, so there is nothing to gain by holding them back
+    int nodelay = 1;
+    if (setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay)) != 0) {
+        printf("setting TCP_NODELAY on port %d failed: %d\n", port, errno);
+    }
+
     return sockfd;
 }
 
 int sdr_gnuradio_driver_init(sdr_interface_data_t *ifdata) {
+    int slot = 0;
+    while (slot < SDR_MAX_INTERFACES && gnuradio_contexts[slot]) {
+        slot++;
+    }
+    if (slot == SDR_MAX_INTERFACES) {
+        printf("%s: Too many interfaces\n", __FUNCTION__);
+        return -1;
+    }
 
     gnuradio_context_t *ctx = os_malloc(sizeof(gnuradio_context_t));
     if (ctx == NULL) {
@@ -172,21 +295,46 @@ int sdr_gnuradio_driver_init(sdr_interface_data_t *ifdata) {
 
     int rxfd = gnuradio_tcp_open("127.0.0.1", 4321);
     int txfd = gnuradio_tcp_open("127.0.0.1", 1235);
+    if (rxfd < 0 || txfd < 0) {
+        if (rxfd >= 0) {
+            close(rxfd);
+        }
+        if (txfd >= 0) {
+            close(txfd);
+        }
+        os_free(ctx);
+        return -2;
+    }
 
     ctx->mtu = ifdata->mtu;
     ctx->rxfd = rxfd;
+    ctx->fd = txfd;
     ifdata->fd = txfd;
     ctx->rx_callback = sdr_rx_isr;
     ctx->user_data = ifdata;
-
-    if (os_task_create(gnuradio_rx_thread, "gnuradio_rx", 0, ctx, 0, 0)) {
-        printf("%s: os_thread_create() failed to create RX thread\n", __FUNCTION__);
+    for (int i = 0; i < SDR_TX_BATCH_MPDUS; i++) {
+        gnuradio_frame_init(ctx->tx_frames[i]);
+    }
+    ctx->rx_size = RX_BUFFER_FRAMES * ctx->mtu;
+    ctx->rx_len = 0;
+    ctx->rx_buf = os_malloc(ctx->rx_size);
+
+    struct epoll_event event = {0};
+    event.events = EPOLLIN;
+    event.data.ptr = ctx;
+    if (ctx->rx_buf == NULL || fcntl(rxfd, F_SETFL, fcntl(rxfd, F_GETFL) | O_NONBLOCK) == -1 ||
+        gnuradio_rx_start() || epoll_ctl(gnuradio_epfd, EPOLL_CTL_ADD, rxfd, &event) == -1) {
+        printf("%s: failed to start receiving: %d\n", __FUNCTION__, errno);
+        os_free(ctx->rx_buf);
         os_free(ctx);
         close(rxfd);
+        close(txfd);
         return -2;
     }
 
+    gnuradio_contexts[slot] = ctx;
     ifdata->tx_func = (sdr_tx_t)sdr_gnuradio_tx;
+    ifdata->txv_func = sdr_gnuradio_txv;
 
     return 0;
 }
@@ -8,65 +8,180 @@
 #define PIPE_ENTER_MSG_LEN 15
 #define PIPE_EXIT_MSG_LEN 16
 
-/* From the EnduroSat manual, these delays assume the UART speed is 19.2KBaud */
-static int sdr_uhf_baud_rate_delay[] = {
-    [SDR_UHF_1200_BAUD] = 920,
-    [SDR_UHF_2400_BAUD] = 460,
-    [SDR_UHF_4800_BAUD] = 240,
-    [SDR_UHF_9600_BAUD] = 120,
-    [SDR_UHF_19200_BAUD] = 60,
-    [SDR_UHF_TEST_BAUD] = 20,
+/* Over the air bit rates. The test and GNU Radio interfaces have no radio
+   to wait for, so MPDUs are sent to them unpaced. */
+static const uint32_t sdr_uhf_bit_rate[] = {
+    [SDR_UHF_1200_BAUD] = 1200,
+    [SDR_UHF_2400_BAUD] = 2400,
+    [SDR_UHF_4800_BAUD] = 4800,
+    [SDR_UHF_9600_BAUD] = 9600,
+    [SDR_UHF_19200_BAUD] = 19200,
+    [SDR_UHF_TEST_BAUD] = 0,
     [SDR_UHF_GNURADIO_BAUD] = 0
 };
 
+uint32_t sdr_uhf_baud_bit_rate(sdr_uhf_baud_rate_t uhf_baudrate) {
+    if (uhf_baudrate >= SDR_UHF_END_BAUD) {
+        return 0;
+    }
+    return sdr_uhf_bit_rate[uhf_baudrate];
+}
+
+static int64_t sdr_uhf_airtime_us(uint32_t bit_rate, size_t mpdu_len) {
+    uint64_t bits = (uint64_t)(UHF_FRAME_OVERHEAD_LENGTH + mpdu_len) * 8;
+    return (int64_t)((bits * 1000000 + bit_rate - 1) / bit_rate);
+}
+
+/* Token bucket over airtime: credit accrues with elapsed time up to the burst
+   size, and sending a frame spends its airtime. Only the shortfall, if any,
+   is slept, so the time spent encoding and writing the previous frame to the
+   radio counts towards its airtime. */
+static void sdr_uhf_tx_pace(sdr_interface_data_t *ifdata, size_t mpdu_len) {
+    uint32_t bit_rate = ifdata->tx_bit_rate;
+    if (bit_rate == 0) {
+        return;
+    }
+
+    int64_t airtime = sdr_uhf_airtime_us(bit_rate, mpdu_len);
+    int64_t capacity = sdr_uhf_airtime_us(bit_rate, UHF_TRANSPARENT_MODE_DATA_FIELD_2_MAX_LENGTH) * SDR_UHF_TX_BURST_FRAMES;
+
+    while (1) {
+        OS_TickType now = os_get_ms();
+        ifdata->tx_credit_us += (int64_t)(now - ifdata->tx_last_ms) * 1000;
+        ifdata->tx_last_ms = now;
+        if (ifdata->tx_credit_us > capacity) {
+            ifdata->tx_credit_us = capacity;
+        }
+        if (ifdata->tx_credit_us >= airtime) {
+            break;
+        }
+        os_sleep_ms((uint32_t)((airtime - ifdata->tx_credit_us + 999) / 1000));
+    }
+    ifdata->tx_credit_us -= airtime;
+}
+
+/* Every MPDU is taken from the MAC, even after a send fails, so the next
+   packet starts from its first MPDU */
 int sdr_uhf_tx(sdr_interface_data_t *ifdata, uint8_t *data, uint16_t len) {
-    sdr_uhf_baud_rate_t uhf_baudrate = ifdata->sdr_conf->uhf_conf.uhf_baudrate;
+    int rc = SDR_ERR_NONE;
 
     if (fec_data_to_mpdu(ifdata->mac_data, data, len)) {
         uint8_t *buf;
-        int delay_time = sdr_uhf_baud_rate_delay[uhf_baudrate];
         size_t mtu = (size_t)fec_get_next_mpdu(ifdata->mac_data, (void **)&buf);
-        while (mtu != 0) {
-            (ifdata->tx_func)(ifdata->fd, buf, mtu);
-            mtu = fec_get_next_mpdu(ifdata->mac_data, (void **)&buf);
-            os_sleep_ms(delay_time);
+        if (ifdata->txv_func && ifdata->tx_bit_rate == 0) {
+            const uint8_t *batch[SDR_TX_BATCH_MPDUS];
+            size_t batch_mtu = mtu;
+            size_t count = 0;
+            while (mtu != 0) {
+                batch[count++] = buf;
+                mtu = fec_get_next_mpdu(ifdata->mac_data, (void **)&buf);
+                if ((count == SDR_TX_BATCH_MPDUS || mtu == 0) && rc == SDR_ERR_NONE) {
+                    rc = (ifdata->txv_func)(ifdata->fd, batch, batch_mtu, count);
+                }
+                if (count == SDR_TX_BATCH_MPDUS) {
+                    count = 0;
+                }
+            }
+        } else {
+            while (mtu != 0) {
+                if (rc == SDR_ERR_NONE) {
+                    sdr_uhf_tx_pace(ifdata, mtu);
+                    rc = (ifdata->tx_func)(ifdata->fd, buf, mtu);
+                }
+                mtu = fec_get_next_mpdu(ifdata->mac_data, (void **)&buf);
+            }
         }
     }
 
-    return 0;
+    return rc;
+}
+
+/* EnduroSat transceiver status messages, sent in place of an MPDU when pipe
+   mode is entered and left */
+static const uint8_t pipe_enter_msg[PIPE_ENTER_MSG_LEN] = {'+', 'P', 'I', 'P', 'E', ' ', '7', '8', '7', '8', 'B', '8', 'A', 'E', 0x0D};
+static const uint8_t pipe_exit_msg[PIPE_EXIT_MSG_LEN] = {'+', 'E', 'S', 'T', 'T', 'C', ' ', 'C', 'F', 'B', '5', '2', 'D', '3', '5', 0x0D};
+
+#define SDR_STATUS_PIPE_ENTER 0x01
+#define SDR_STATUS_PIPE_EXIT 0x02
+#define SDR_STATUS_ALL (SDR_STATUS_PIPE_ENTER | SDR_STATUS_PIPE_EXIT)
+
+static void sdr_rx_frame_reset(sdr_interface_data_t *ifdata) {
+    ifdata->rx_mpdu_index = 0;
+    ifdata->rx_status_mismatch = 0;
+}
+
+/* Match the byte at index of the frame being assembled against the status
+   messages the frame could still be. Returns true when the frame is a whole
+   status message. */
+static bool sdr_rx_status_match(sdr_interface_data_t *ifdata, uint16_t index, uint8_t byte) {
+    if (!(ifdata->rx_status_mismatch & SDR_STATUS_PIPE_ENTER)) {
+        if (index >= PIPE_ENTER_MSG_LEN || pipe_enter_msg[index] != byte) {
+            ifdata->rx_status_mismatch |= SDR_STATUS_PIPE_ENTER;
+        } else if (index == PIPE_ENTER_MSG_LEN - 1) {
+            return true;
+        }
+    }
+    if (!(ifdata->rx_status_mismatch & SDR_STATUS_PIPE_EXIT)) {
+        if (index >= PIPE_EXIT_MSG_LEN || pipe_exit_msg[index] != byte) {
+            ifdata->rx_status_mismatch |= SDR_STATUS_PIPE_EXIT;
+        } else if (index == PIPE_EXIT_MSG_LEN - 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Hand the assembled MPDU to the RX task and carry on in a new buffer */
+static void sdr_rx_frame_complete(sdr_interface_data_t *ifdata, void *pxTaskWoken) {
+    uint8_t *next = os_pool_alloc_from_isr(&sdr_mpdu_pool);
+    if (next && os_queue_enqueue_from_isr(ifdata->rx_queue, &ifdata->rx_mpdu, pxTaskWoken) == OS_QUEUE_OK) {
+        ifdata->rx_mpdu = next;
+    } else {
+        // This is an isr, if this fails there's nothing that can be done
+        // but reuse the buffer
+        os_pool_free_from_isr(&sdr_mpdu_pool, next);
+        ifdata->rx_mpdu_dropped++;
+    }
+    sdr_rx_frame_reset(ifdata);
 }
 
 void sdr_rx_isr(void *cb_data, uint8_t *buf, size_t len, void *pxTaskWoken) {
     sdr_interface_data_t *ifdata = (sdr_interface_data_t *)cb_data;
 
-    uint8_t *ptr = buf;
     if (os_get_ms() - ifdata->last_rx > 100) {
-        ifdata->rx_mpdu_index = 0;
+        sdr_rx_frame_reset(ifdata);
     }
     ifdata->last_rx = os_get_ms();
-    for (size_t i=0; i<len; i++) {
-        ifdata->rx_mpdu[ifdata->rx_mpdu_index] = ptr[i];
-        ifdata->rx_mpdu_index++;
-        if (ifdata->rx_mpdu_index >= ifdata->mtu) {
-            ifdata->rx_mpdu_index = 0;
-            // This is an isr, if this fails there's nothing that can be done
-            os_queue_enqueue(ifdata->rx_queue, ifdata->rx_mpdu);
-            return;
+
+    // A callback may hold the end of one frame, whole frames and the start of
+    // another, so assemble until every byte is used
+    size_t i = 0;
+    while (i < len) {
+        // Discard transceiver pipe mode status updates. Only the first few
+        // bytes of a frame are looked at, one at a time, and only while they
+        // could still be a status message, however the callbacks split them.
+        while (i < len && ifdata->rx_status_mismatch != SDR_STATUS_ALL) {
+            uint16_t index = ifdata->rx_mpdu_index;
+            uint8_t byte = buf[i++];
+            ifdata->rx_mpdu[index] = byte;
+            ifdata->rx_mpdu_index++;
+            if (sdr_rx_status_match(ifdata, index, byte)) {
+                sdr_rx_frame_reset(ifdata);
+            } else if (ifdata->rx_mpdu_index >= ifdata->mtu) {
+                sdr_rx_frame_complete(ifdata, pxTaskWoken);
+            }
         }
-    }
 
-    //Discard transceiver pipe mode status updates
-    //Could probably be done differently to use less cpu
-    if (ifdata->rx_mpdu_index == (PIPE_ENTER_MSG_LEN)) {
-        char pipe_enter_msg[PIPE_ENTER_MSG_LEN] = {'+', 'P', 'I', 'P', 'E', ' ', '7', '8', '7', '8', 'B', '8', 'A', 'E', 0x0D};
-        if(strncmp((char *)ifdata->rx_mpdu, pipe_enter_msg, PIPE_ENTER_MSG_LEN) == 0){
-            ifdata->rx_mpdu_index = 0;
+        // The rest of the frame is copied in bulk
+        size_t n = ifdata->mtu - ifdata->rx_mpdu_index;
+        if (n > len - i) {
+            n = len - i;
         }
-    }
-    if (ifdata->rx_mpdu_index == (PIPE_EXIT_MSG_LEN)) {
-        char pipe_exit_msg[PIPE_EXIT_MSG_LEN] = {'+', 'E', 'S', 'T', 'T', 'C', ' ', 'C', 'F', 'B', '5', '2', 'D', '3', '5', 0x0D};
-        if (strncmp((char *)(ifdata->rx_mpdu), pipe_exit_msg, PIPE_EXIT_MSG_LEN) == 0) {
-            ifdata->rx_mpdu_index = 0;
+        memcpy(ifdata->rx_mpdu + ifdata->rx_mpdu_index, buf + i, n);
+        ifdata->rx_mpdu_index += n;
+        i += n;
+        if (ifdata->rx_mpdu_index >= ifdata->mtu) {
+            sdr_rx_frame_complete(ifdata, pxTaskWoken);
         }
     }
 }
@@ -75,23 +190,25 @@ os_task_return_t sdr_rx_task(void *param) {
     sdr_interface_data_t *ifdata = (sdr_interface_data_t *)param;
     sdr_conf_t *sdr_conf = ifdata->sdr_conf;
 
-    uint8_t *mpdu = os_malloc(ifdata->mtu);
+    uint8_t *mpdu;
     uint8_t *data = 0;
 
     while (1) {
-        if (os_queue_dequeue(ifdata->rx_queue, mpdu, OS_MAX_TIMEOUT) != true) {
+        if (os_queue_dequeue(ifdata->rx_queue, &mpdu, OS_MAX_TIMEOUT) != true) {
             continue;
         }
 
         int plen = fec_mpdu_to_data(ifdata->mac_data, mpdu, &data, ifdata->mtu);
+        os_pool_free(&sdr_mpdu_pool, mpdu);
         if (plen) {
             sdr_conf->rx_callback(sdr_conf->rx_callback_data, data, plen, 0);
-            os_free(data);
+            os_pool_free(&sdr_packet_pool, data);
         }
     }
 }
 
 int sdr_uhf_set_rf_mode(sdr_interface_data_t *sdr_ifdata, uint8_t rf_mode){
     sdr_ifdata->sdr_conf->uhf_conf.uhf_baudrate = get_uhf_baud_t_from_rf_mode_number(rf_mode);
+    sdr_ifdata->tx_bit_rate = get_bit_rate_from_rf_mode_number(rf_mode);
     return 0;
 }
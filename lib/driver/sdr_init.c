@@ -6,9 +6,31 @@
 
 void sdr_loopback_open(sdr_interface_data_t *ifdata);
 
+OS_POOL_DEFINE(sdr_mpdu_pool, SDR_UHF_MAX_MTU, SDR_MPDU_BUFFER_COUNT);
+OS_POOL_DEFINE(sdr_packet_pool, MAC_MAX_USER_PACKET_LENGTH, SDR_PACKET_BUFFER_COUNT);
+
 static int sdr_driver_init(sdr_interface_data_t *ifdata, const char *ifname) {
     int rc;
 
+    /* Drivers can deliver bytes to sdr_rx_isr as soon as they are open, so
+       everything it uses is set up first */
+    ifdata->rx_queue = os_queue_create(SDR_RX_QUEUE_DEPTH, sizeof(uint8_t *));
+    error_correction_scheme_t correction_scheme;
+    if (ifdata->sdr_conf->use_fec) {
+        correction_scheme = CCSDS_CONVOLUTIONAL_CODING_R_1_2;
+    } else {
+        correction_scheme = NO_FEC;
+    }
+    ifdata->mac_data = fec_create(RF_MODE_3, correction_scheme);
+
+    ifdata->rx_mpdu_index = 0;
+    ifdata->rx_status_mismatch = 0;
+    ifdata->rx_mpdu_dropped = 0;
+    ifdata->rx_mpdu = os_pool_alloc(&sdr_mpdu_pool);
+    if (!ifdata->rx_mpdu) {
+        return SDR_ERR_NOMEM;
+    }
+
     if (strcmp(ifname, SDR_IF_LOOPBACK_NAME) == 0) {
         sdr_loopback_open(ifdata);
     }
@@ -16,10 +38,12 @@ static int sdr_driver_init(sdr_interface_data_t *ifdata, const char *ifname) {
         /* For UHF we can receive using either gnuradio or uart */
 #ifdef SDR_GNURADIO
         if ((rc = sdr_gnuradio_driver_init(ifdata))) {
+            os_pool_free(&sdr_mpdu_pool, ifdata->rx_mpdu);
             return rc;
         }
 #else
         if ((rc = sdr_uart_driver_init(ifdata))) {
+            os_pool_free(&sdr_mpdu_pool, ifdata->rx_mpdu);
             return rc;
         }
 #endif
@@ -28,27 +52,17 @@ static int sdr_driver_init(sdr_interface_data_t *ifdata, const char *ifname) {
         /* For S-Band we receive on Linux and transmit on FreeRTOS */
 #ifdef OS_POSIX
         if ((rc = sdr_gnuradio_driver_init(ifdata))) {
+            os_pool_free(&sdr_mpdu_pool, ifdata->rx_mpdu);
             return rc;
         }
 #else
         if ((rc = sdr_sband_driver_init(ifdata))) {
+            os_pool_free(&sdr_mpdu_pool, ifdata->rx_mpdu);
             return rc;
         }
 #endif
     }
 
-    ifdata->rx_queue = os_queue_create(2, ifdata->mtu);
-    error_correction_scheme_t correction_scheme;
-    if (ifdata->sdr_conf->use_fec) {
-        correction_scheme = CCSDS_CONVOLUTIONAL_CODING_R_1_2;
-    } else {
-        correction_scheme = NO_FEC;
-    }
-    ifdata->mac_data = fec_create(RF_MODE_3, correction_scheme);
-
-    ifdata->rx_mpdu_index = 0;
-    ifdata->rx_mpdu = os_malloc(ifdata->mtu);
-
     rc = os_task_create(sdr_rx_task, "sdr_rx", OS_RX_TASK_STACK_SIZE, (void *)ifdata, 0, NULL);
 
     return rc;
@@ -68,6 +82,8 @@ sdr_interface_data_t *sdr_interface_init(const sdr_conf_t *conf, const char *ifn
 
     ifdata->mtu = SDR_UHF_MAX_MTU;
     ifdata->sdr_conf = sdr_conf;
+    ifdata->tx_bit_rate = sdr_uhf_baud_bit_rate(sdr_conf->uhf_conf.uhf_baudrate);
+    ifdata->tx_last_ms = os_get_ms();
 
     int rc = sdr_driver_init(ifdata, ifname);
     if (rc) {
@@ -1,11 +1,21 @@
 #include <stdbool.h>
+#include <string.h>
 #include "sdr_driver.h"
 #include "osal.h"
 
 static sdr_interface_data_t *loop_ifdata;
 
 static int sdr_loopback_tx(int fd, const void *buf, size_t len) {
-    if (os_queue_enqueue(loop_ifdata->rx_queue, (const uint8_t *)buf) != true) {
+    uint8_t *mpdu = os_pool_alloc(&sdr_mpdu_pool);
+    if (!mpdu) {
+        return SDR_ERR_NOMEM;
+    }
+    if (len > loop_ifdata->mtu) {
+        len = loop_ifdata->mtu;
+    }
+    memcpy(mpdu, buf, len);
+    if (os_queue_enqueue(loop_ifdata->rx_queue, &mpdu) != true) {
+        os_pool_free(&sdr_mpdu_pool, mpdu);
         return SDR_ERR_TIMEOUT;
     }
 
@@ -0,0 +1,492 @@
+/*!
+ * @file CCSDSLDPC.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details The "CCSDSLDPC" scheme extends the FEC base class to implement the
+ * CCSDS_LDPC_ORANGE_BOOK_xxx forward error correction.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "CCSDSLDPC.hpp"
+#include "mpdu.hpp"
+
+namespace ex2 {
+  namespace sdr {
+
+    namespace {
+
+      // CCSDS 131.0-B Table 7-3, theta_k for k = 1..26
+      const uint8_t THETA[26] = {
+        3, 0, 1, 2, 2, 3, 0, 1, 0, 1, 2, 0, 2, 3, 0, 1, 2, 0, 1, 2, 0, 1, 2, 1, 2, 3
+      };
+
+      // CCSDS 131.0-B Table 7-4, phi_k(j, M) for j = 0..3, M = 128, 256, 512
+      // and k = 1..26
+      const uint8_t PHI[4][3][26] = {
+        {
+          { 1, 22, 0, 26, 0, 10, 5, 18, 3, 22, 3, 8, 25, 25, 2, 27, 7, 7, 15, 10, 4, 19, 7, 9, 26, 17 },
+          { 59, 18, 52, 23, 11, 7, 22, 25, 27, 30, 43, 14, 46, 62, 44, 12, 38, 47, 1, 52, 61, 10, 55, 7, 12, 2 },
+          { 16, 103, 105, 0, 50, 29, 115, 30, 92, 78, 70, 66, 39, 84, 79, 70, 29, 32, 45, 113, 86, 1, 42, 118, 33, 126 }
+        },
+        {
+          { 0, 27, 30, 28, 7, 1, 8, 20, 26, 24, 4, 12, 23, 15, 15, 17, 11, 2, 8, 0, 0, 12, 11, 22, 2, 29 },
+          { 0, 32, 21, 36, 30, 29, 37, 11, 25, 27, 19, 16, 44, 24, 14, 35, 7, 31, 24, 18, 20, 17, 28, 39, 1, 21 },
+          { 0, 53, 74, 45, 47, 0, 59, 102, 25, 3, 88, 73, 11, 24, 101, 46, 67, 24, 62, 69, 14, 45, 29, 0, 102, 20 }
+        },
+        {
+          { 0, 12, 30, 18, 10, 16, 13, 9, 7, 15, 16, 18, 4, 23, 5, 3, 29, 11, 4, 8, 2, 11, 11, 3, 15, 13 },
+          { 0, 46, 45, 27, 48, 37, 41, 13, 9, 49, 36, 10, 11, 18, 54, 40, 27, 35, 25, 46, 24, 14, 45, 26, 16, 17 },
+          { 0, 8, 119, 89, 31, 122, 1, 69, 92, 47, 11, 31, 19, 66, 49, 81, 96, 38, 83, 42, 58, 24, 25, 65, 112, 57 }
+        },
+        {
+          { 0, 13, 19, 14, 15, 20, 17, 4, 4, 11, 17, 20, 8, 22, 19, 15, 5, 21, 17, 9, 20, 18, 31, 13, 2, 18 },
+          { 0, 44, 51, 12, 15, 12, 4, 7, 2, 30, 53, 23, 29, 37, 42, 48, 4, 10, 28, 17, 48, 29, 40, 12, 9, 3 },
+          { 0, 35, 97, 112, 64, 93, 99, 94, 103, 91, 3, 6, 39, 113, 92, 119, 110, 78, 39, 48, 23, 39, 37, 76, 80, 56 }
+        }
+      };
+
+      // A term of an M x M block of the parity check matrix; k = 0 is the
+      // identity, otherwise PI_k
+      struct BlockTerm {
+        uint8_t row;
+        uint8_t col;
+        uint8_t k;
+      };
+
+      // The rate 1/2 matrix, the last three block columns of every rate
+      //   [ 0  0  I  0      I+PI_1       ]
+      //   [ I  I  0  I      PI_2+PI_3+PI_4 ]
+      //   [ I  PI_5+PI_6  0  PI_7+PI_8  I ]
+      const BlockTerm RATE_1_2_TERMS[] = {
+        { 0, 2, 0 }, { 0, 4, 0 }, { 0, 4, 1 },
+        { 1, 0, 0 }, { 1, 1, 0 }, { 1, 3, 0 }, { 1, 4, 2 }, { 1, 4, 3 }, { 1, 4, 4 },
+        { 2, 0, 0 }, { 2, 1, 5 }, { 2, 1, 6 }, { 2, 3, 7 }, { 2, 3, 8 }, { 2, 4, 0 }
+      };
+
+      // The block columns prepended for rate 4/5; rate 2/3 uses the last two
+      const BlockTerm EXTRA_TERMS[] = {
+        { 1, 0, 21 }, { 1, 0, 22 }, { 1, 0, 23 }, { 1, 1, 0 },
+        { 1, 2, 15 }, { 1, 2, 16 }, { 1, 2, 17 }, { 1, 3, 0 },
+        { 1, 4, 9 }, { 1, 4, 10 }, { 1, 4, 11 }, { 1, 5, 0 },
+        { 2, 0, 0 }, { 2, 1, 24 }, { 2, 1, 25 }, { 2, 1, 26 },
+        { 2, 2, 0 }, { 2, 3, 18 }, { 2, 3, 19 }, { 2, 3, 20 },
+        { 2, 4, 0 }, { 2, 5, 12 }, { 2, 5, 13 }, { 2, 5, 14 }
+      };
+      const uint16_t MAX_EXTRA_BLOCK_COLS = 6;
+
+      // Column of the 1 in row i of PI_k; k = 0 is the identity
+      uint16_t permutation(uint16_t k, uint16_t M, uint16_t i)
+      {
+        if (k == 0) {
+          return i;
+        }
+        const uint16_t q = M / 4;
+        const uint16_t j = i / q;
+        const uint8_t phi = PHI[j][(M == 128) ? 0 : ((M == 256) ? 1 : 2)][k - 1];
+        return q * ((THETA[k - 1] + j) % 4) + (phi + i) % q;
+      }
+
+    } /* anonymous namespace */
+
+    const uint32_t CCSDSLDPC::DEFAULT_MAX_ITERATIONS;
+
+    CCSDSLDPC::CCSDSLDPC(ErrorCorrection::ErrorCorrectionScheme ecScheme) : FEC(ecScheme) {
+      m_errorCorrection = new ErrorCorrection(ecScheme, (MPDU::maxMTU() * 8));
+
+      uint16_t extraBlockCols;
+      switch (ecScheme) {
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_1280:
+          m_M = 128;
+          extraBlockCols = 6;
+          break;
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_1536:
+          m_M = 256;
+          extraBlockCols = 2;
+          break;
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_2048:
+          m_M = 512;
+          extraBlockCols = 0;
+          break;
+        default:
+          throw FECException("CCSDSLDPC scheme is not an AR4JA LDPC code");
+      }
+      m_z = m_M / 4;
+      m_zPadded = ((m_z + MIN_SUM_LANES - 1) / MIN_SUM_LANES) * MIN_SUM_LANES;
+      m_blockCols = (extraBlockCols + 5) * 4;
+      m_infoCols = (extraBlockCols + 2) * 4;
+      m_layers = 3 * 4;
+      m_n = (extraBlockCols + 5) * m_M;
+      if (m_errorCorrection->getCodewordLen() != m_n - m_M) {
+        throw FECException("CCSDSLDPC codeword length does not match the parity check matrix");
+      }
+
+      // Each PI_k is a 4 x 4 array of circulants; row i of sub-block j is
+      // in block column (theta_k + j) mod 4, shifted by phi_k(j, M)
+      m_layerStart.resize(m_layers + 1, 0);
+      for (const BlockTerm& t : EXTRA_TERMS) {
+        if (t.col >= MAX_EXTRA_BLOCK_COLS - extraBlockCols) {
+          for (uint16_t j = 0; j < 4; j++) {
+            uint16_t col = t.col - (MAX_EXTRA_BLOCK_COLS - extraBlockCols);
+            uint16_t c = permutation(t.k, m_M, j * m_z) / m_z;
+            m_addEdge(t.row * 4 + j, col * 4 + c, permutation(t.k, m_M, j * m_z) % m_z);
+          }
+        }
+      }
+      for (const BlockTerm& t : RATE_1_2_TERMS) {
+        for (uint16_t j = 0; j < 4; j++) {
+          uint16_t col = t.col + extraBlockCols;
+          uint16_t c = permutation(t.k, m_M, j * m_z) / m_z;
+          m_addEdge(t.row * 4 + j, col * 4 + c, permutation(t.k, m_M, j * m_z) % m_z);
+        }
+      }
+
+      uint16_t maxDegree = 0;
+      for (uint16_t r = 0; r < m_layers; r++) {
+        maxDegree = std::max(maxDegree, (uint16_t) (m_layerStart[r + 1] - m_layerStart[r]));
+      }
+
+      m_invertCore();
+
+      m_bits.resize(m_n);
+      m_hardDecisions.resize(m_n);
+      m_posterior.resize(m_n);
+      m_checkMessages.resize(m_edgeCol.size() * m_zPadded);
+      m_layerPosterior.resize(maxDegree * m_zPadded);
+    }
+
+    CCSDSLDPC::~CCSDSLDPC() {
+      if (m_errorCorrection != NULL) {
+        delete m_errorCorrection;
+      }
+    }
+
+    void
+    CCSDSLDPC::m_addEdge(uint16_t layer, uint16_t col, uint8_t shift) {
+      // Keep each layer's edges in block column order. Two circulants at the
+      // same place cancel if they are equal; otherwise the layer would
+      // connect twice to some variables, which the layered decoder can't do
+      uint16_t e = m_layerStart[layer];
+      while (e < m_layerStart[layer + 1] && m_edgeCol[e] < col) {
+        e++;
+      }
+      if (e < m_layerStart[layer + 1] && m_edgeCol[e] == col) {
+        if (m_edgeShift[e] != shift) {
+          throw FECException("CCSDSLDPC circulant weight exceeds one");
+        }
+        m_edgeCol.erase(m_edgeCol.begin() + e);
+        m_edgeShift.erase(m_edgeShift.begin() + e);
+        for (uint16_t r = layer + 1; r <= m_layers; r++) {
+          m_layerStart[r]--;
+        }
+        return;
+      }
+      m_edgeCol.insert(m_edgeCol.begin() + e, col);
+      m_edgeShift.insert(m_edgeShift.begin() + e, shift);
+      for (uint16_t r = layer + 1; r <= m_layers; r++) {
+        m_layerStart[r]++;
+      }
+    }
+
+    void
+    CCSDSLDPC::m_invertCore() {
+      const uint16_t M = m_M;
+      const uint16_t words = M / 64;
+
+      // Row i of I + PI_78 PI_234 is e_i plus rows PI_7(i) and PI_8(i) of
+      // PI_234
+      std::vector<uint64_t> core(M * words, 0);
+      m_coreInverse.assign(M * words, 0);
+      for (uint16_t i = 0; i < M; i++) {
+        uint64_t *row = &core[i * words];
+        row[i / 64] ^= 1ULL << (i % 64);
+        m_coreInverse[i * words + i / 64] = 1ULL << (i % 64);
+        for (uint16_t k7 = 7; k7 <= 8; k7++) {
+          uint16_t j = permutation(k7, M, i);
+          for (uint16_t k2 = 2; k2 <= 4; k2++) {
+            uint16_t c = permutation(k2, M, j);
+            row[c / 64] ^= 1ULL << (c % 64);
+          }
+        }
+      }
+
+      // Gauss-Jordan elimination
+      for (uint16_t c = 0; c < M; c++) {
+        const uint16_t w = c / 64;
+        const uint64_t bit = 1ULL << (c % 64);
+        uint16_t pivot = c;
+        while (pivot < M && !(core[pivot * words + w] & bit)) {
+          pivot++;
+        }
+        if (pivot == M) {
+          throw FECException("CCSDSLDPC parity check matrix is singular");
+        }
+        if (pivot != c) {
+          std::swap_ranges(&core[pivot * words], &core[pivot * words] + words, &core[c * words]);
+          std::swap_ranges(&m_coreInverse[pivot * words], &m_coreInverse[pivot * words] + words,
+            &m_coreInverse[c * words]);
+        }
+        for (uint16_t r = 0; r < M; r++) {
+          if (r != c && (core[r * words + w] & bit)) {
+            for (uint16_t i = 0; i < words; i++) {
+              core[r * words + i] ^= core[c * words + i];
+              m_coreInverse[r * words + i] ^= m_coreInverse[c * words + i];
+            }
+          }
+        }
+      }
+    }
+
+    void
+    CCSDSLDPC::m_permute(uint16_t k, const uint8_t *x, uint8_t *y) const {
+      for (uint16_t i = 0; i < m_M; i++) {
+        y[i] ^= x[permutation(k, m_M, i)];
+      }
+    }
+
+    std::vector<uint8_t>
+    CCSDSLDPC::encode(const std::vector<uint8_t>& payload) {
+      const uint32_t messageLenBits = m_errorCorrection->getMessageLen(); // bits
+      if (payload.size() != (messageLenBits / 8))
+        throw FECException("CCSDSLDPC encode payload wrong length");
+
+      const uint16_t M = m_M;
+      const uint16_t z = m_z;
+
+      std::fill(m_bits.begin(), m_bits.end(), 0);
+      for (uint32_t i = 0; i < messageLenBits; i++) {
+        m_bits[i] = (payload[i / 8] >> (7 - (i % 8))) & 0x01;
+      }
+
+      // u, the syndrome of the information bits, one block of M per block row
+      std::vector<uint8_t> u(3 * M, 0);
+      for (uint16_t r = 0; r < m_layers; r++) {
+        uint8_t *ur = &u[r * z];
+        for (uint16_t e = m_layerStart[r]; e < m_layerStart[r + 1]; e++) {
+          if (m_edgeCol[e] < m_infoCols) {
+            const uint8_t *v = &m_bits[m_edgeCol[e] * z];
+            const uint8_t h = m_edgeShift[e];
+            for (uint16_t i = 0; i < z; i++) {
+              ur[i] ^= v[(i + h) % z];
+            }
+          }
+        }
+      }
+      const uint8_t *u1 = &u[0];
+      const uint8_t *u2 = &u[M];
+      const uint8_t *u3 = &u[2 * M];
+
+      uint8_t *p2 = &m_bits[m_n - 3 * M];
+      uint8_t *p3 = &m_bits[m_n - 2 * M];
+      uint8_t *p4 = &m_bits[m_n - M];
+
+      // p4 = (I + PI_78 PI_234)^-1 (u3 + PI_78 u2)
+      std::vector<uint8_t> t(u3, u3 + M);
+      m_permute(7, u2, t.data());
+      m_permute(8, u2, t.data());
+      const uint16_t words = M / 64;
+      std::vector<uint64_t> packed(words, 0);
+      for (uint16_t i = 0; i < M; i++) {
+        packed[i / 64] |= ((uint64_t) t[i]) << (i % 64);
+      }
+      for (uint16_t i = 0; i < M; i++) {
+        uint64_t parity = 0;
+        for (uint16_t w = 0; w < words; w++) {
+          parity ^= m_coreInverse[i * words + w] & packed[w];
+        }
+        p4[i] = __builtin_parityll(parity);
+      }
+
+      // p3 = u2 + PI_234 p4 and p2 = u1 + (I + PI_1) p4
+      std::memcpy(p3, u2, M);
+      m_permute(2, p4, p3);
+      m_permute(3, p4, p3);
+      m_permute(4, p4, p3);
+      for (uint16_t i = 0; i < M; i++) {
+        p2[i] = u1[i] ^ p4[i];
+      }
+      m_permute(1, p4, p2);
+
+      // Pack all but the punctured bits, msb first
+      std::vector<uint8_t> codeword((m_n - M) / 8, 0);
+      for (uint32_t i = 0; i < m_n - M; i++) {
+        codeword[i / 8] |= m_bits[i] << (7 - (i % 8));
+      }
+      return codeword;
+    }
+
+    std::vector<uint8_t>
+    CCSDSLDPC::lastFullCodeword() const {
+      std::vector<uint8_t> codeword(m_n / 8, 0);
+      for (uint32_t i = 0; i < m_n; i++) {
+        codeword[i / 8] |= m_bits[i] << (7 - (i % 8));
+      }
+      return codeword;
+    }
+
+    uint32_t
+    CCSDSLDPC::unsatisfiedChecks(const std::vector<uint8_t>& codeword) const {
+      uint32_t unsatisfied = 0;
+      for (uint16_t r = 0; r < m_layers; r++) {
+        for (uint16_t i = 0; i < m_z; i++) {
+          uint8_t parity = 0;
+          for (uint16_t e = m_layerStart[r]; e < m_layerStart[r + 1]; e++) {
+            uint32_t b = m_edgeCol[e] * m_z + (i + m_edgeShift[e]) % m_z;
+            parity ^= (codeword[b / 8] >> (7 - (b % 8))) & 0x01;
+          }
+          unsatisfied += parity;
+        }
+      }
+      return unsatisfied;
+    }
+
+    void
+    CCSDSLDPC::setMinSumVariant(MinSumVariant variant, float factor) {
+      if (variant == MinSumVariant::NORMALIZED) {
+        m_normalization = factor;
+        m_offset = 0.0f;
+      }
+      else {
+        m_normalization = 1.0f;
+        m_offset = factor;
+      }
+    }
+
+    uint32_t
+    CCSDSLDPC::decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+      std::vector<uint8_t>& decodedPayload) {
+
+      decodedPayload.resize(0); // Resize in all FEC decode methods
+
+      const uint32_t nTx = m_n - m_M;
+      if (encodedPayload.size() != nTx / 8) {
+        // make it very obviously fail by returning a huge number of bit errors
+        return UINT32_MAX;
+      }
+
+      // For BPSK over AWGN, hard decisions see a binary symmetric channel
+      // with crossover probability Q(sqrt(2 Es/N0)). Bound it so the LLRs
+      // stay finite for very high SNR estimates.
+      float esN0 = std::pow(10.0f, snrEstimate / 10.0f);
+      float p = 0.5f * std::erfc(std::sqrt(esN0));
+      p = std::min(std::max(p, 1.0e-6f), 0.49f);
+      const float llr = std::log((1.0f - p) / p);
+
+      std::vector<float> llrs(nTx);
+      for (uint32_t i = 0; i < nTx; i++) {
+        llrs[i] = ((encodedPayload[i / 8] >> (7 - (i % 8))) & 0x01) ? -llr : llr;
+      }
+
+      return decodeLLR(llrs, decodedPayload);
+    }
+
+    uint32_t
+    CCSDSLDPC::decodeLLR(const std::vector<float>& llrs, std::vector<uint8_t>& decodedPayload) {
+
+      decodedPayload.resize(0); // Resize in all FEC decode methods
+
+      const uint32_t nTx = m_n - m_M;
+      if (llrs.size() != nTx) {
+        return UINT32_MAX;
+      }
+
+      const uint16_t z = m_z;
+      const uint16_t zp = m_zPadded;
+      const uint32_t messageLenBits = m_errorCorrection->getMessageLen();
+
+      // The punctured bits are erasures
+      std::copy(llrs.begin(), llrs.end(), m_posterior.begin());
+      std::fill(m_posterior.begin() + nTx, m_posterior.end(), 0.0f);
+      std::fill(m_checkMessages.begin(), m_checkMessages.end(), 0.0f);
+      std::fill(m_layerPosterior.begin(), m_layerPosterior.end(), 0.0f);
+
+      const MinSumLayerFn minSumLayer = minSumLayerKernel.get();
+
+      m_lastIterations = 0;
+      m_lastConverged = m_syndromeIsZero();
+      while (!m_lastConverged && m_lastIterations < m_maxIterations) {
+        for (uint16_t r = 0; r < m_layers; r++) {
+          const uint16_t first = m_layerStart[r];
+          const uint16_t degree = m_layerStart[r + 1] - first;
+
+          // Gather each circulant's posteriors into circulant row order; row
+          // i of the circulant connects to variable (i + shift) mod z
+          for (uint16_t k = 0; k < degree; k++) {
+            const float *v = &m_posterior[m_edgeCol[first + k] * z];
+            float *g = &m_layerPosterior[k * zp];
+            const uint8_t h = m_edgeShift[first + k];
+            std::memcpy(g, v + h, (z - h) * sizeof(float));
+            std::memcpy(g + (z - h), v, h * sizeof(float));
+          }
+
+          minSumLayer(m_layerPosterior.data(), &m_checkMessages[first * zp], degree, zp,
+            m_normalization, m_offset);
+
+          // Scatter them back
+          for (uint16_t k = 0; k < degree; k++) {
+            float *v = &m_posterior[m_edgeCol[first + k] * z];
+            const float *g = &m_layerPosterior[k * zp];
+            const uint8_t h = m_edgeShift[first + k];
+            std::memcpy(v + h, g, (z - h) * sizeof(float));
+            std::memcpy(v, g + (z - h), h * sizeof(float));
+          }
+        }
+        m_lastIterations++;
+        m_lastConverged = m_syndromeIsZero();
+      }
+
+      // Count the corrected hard decisions and extract the payload
+      uint32_t corrected = 0;
+      for (uint32_t i = 0; i < nTx; i++) {
+        corrected += ((llrs[i] < 0.0f) != (m_posterior[i] < 0.0f));
+      }
+      decodedPayload.resize(messageLenBits / 8, 0);
+      for (uint32_t i = 0; i < messageLenBits; i++) {
+        if (m_posterior[i] < 0.0f) {
+          decodedPayload[i / 8] |= 0x80 >> (i % 8);
+        }
+      }
+
+      return corrected;
+    }
+
+    bool
+    CCSDSLDPC::m_syndromeIsZero() {
+      const uint16_t z = m_z;
+
+      for (uint32_t i = 0; i < m_n; i++) {
+        m_hardDecisions[i] = (m_posterior[i] < 0.0f);
+      }
+
+      uint8_t syndrome[MIN_SUM_MAX_Z_PADDED];
+      for (uint16_t r = 0; r < m_layers; r++) {
+        std::memset(syndrome, 0, z);
+        for (uint16_t e = m_layerStart[r]; e < m_layerStart[r + 1]; e++) {
+          const uint8_t *v = &m_hardDecisions[m_edgeCol[e] * z];
+          const uint8_t h = m_edgeShift[e];
+          for (uint16_t i = 0; i < z - h; i++) {
+            syndrome[i] ^= v[i + h];
+          }
+          for (uint16_t i = z - h; i < z; i++) {
+            syndrome[i] ^= v[i + h - z];
+          }
+        }
+        for (uint16_t i = 0; i < z; i++) {
+          if (syndrome[i]) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+  } /* namespace sdr */
+} /* namespace ex2 */
@@ -0,0 +1,553 @@
+/*!
+ * @file CCSDSTurbo.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details The "CCSDSTurbo" scheme extends the FEC base class to implement
+ * the CCSDS_TURBO_xxx forward error correction.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "CCSDSTurbo.hpp"
+#include "cpuFeatures.hpp"
+#include "mpdu.hpp"
+
+#if EX2_SDR_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#define CCSDS_TURBO_DEBUG 0
+
+namespace ex2 {
+  namespace sdr {
+
+    namespace {
+
+      // The component encoder outputs, in the order of @p m_pattern
+      enum Output : uint8_t {
+        OUT_0A = 0, OUT_1A, OUT_2A, OUT_3A, OUT_1B, OUT_2B, OUT_3B
+      };
+
+      // Stands in for minus infinity without overflowing when added to
+      const float NEG_METRIC = -1.0e30f;
+
+      const uint16_t STATES = 16;
+
+      /*!
+       * @brief One step of a component encoder
+       *
+       * @details The state is (s1 s2 s3 s4), s1 the msb and the most recent.
+       * The feedback is a = u + s3 + s4; when terminating, u is chosen to
+       * make a = 0.
+       *
+       * @param[in,out] state The encoder state
+       * @param[in] u The input bit, ignored if @p terminate
+       * @param[in] terminate True for the tail steps
+       * @param[out] out u, then the G1, G2 and G3 outputs
+       */
+      inline void componentStep(uint8_t& state, uint8_t u, bool terminate, uint8_t *out)
+      {
+        const uint8_t s1 = (state >> 3) & 1;
+        const uint8_t s2 = (state >> 2) & 1;
+        const uint8_t s3 = (state >> 1) & 1;
+        const uint8_t s4 = state & 1;
+        if (terminate) {
+          u = s3 ^ s4;
+        }
+        const uint8_t a = u ^ s3 ^ s4;
+        out[0] = u;
+        out[1] = a ^ s1 ^ s3 ^ s4;
+        out[2] = a ^ s2 ^ s4;
+        out[3] = a ^ s1 ^ s2 ^ s3 ^ s4;
+        state = (a << 3) | (state >> 1);
+      }
+
+      /*!
+       * @brief The trellis as a radix-2 butterfly
+       *
+       * @details States 2j and 2j+1 both go to states j (a = 0) and j + 8
+       * (a = 1). Branch class c is 0 for (2j, a = 0), 1 for (2j+1, a = 0),
+       * 2 for (2j, a = 1) and 3 for (2j+1, a = 1). For each class and j,
+       * @p sign holds +1/2 or -1/2 for a 0 or 1 on the u, G1, G2 and G3
+       * outputs, and @p u holds the input bit.
+       */
+      struct Trellis {
+        float sign[4][4][8];
+        float u[4][8];
+      };
+
+      const Trellis& trellis()
+      {
+        static const Trellis t = []() {
+          Trellis tr;
+          for (uint16_t c = 0; c < 4; c++) {
+            for (uint16_t j = 0; j < 8; j++) {
+              uint8_t state = 2 * j + (c & 1);
+              const uint8_t a = c >> 1;
+              // the input that gives feedback a
+              uint8_t u = a ^ ((state >> 1) & 1) ^ (state & 1);
+              uint8_t out[4];
+              componentStep(state, u, false, out);
+              for (uint16_t k = 0; k < 4; k++) {
+                tr.sign[c][k][j] = out[k] ? -0.5f : 0.5f;
+              }
+              tr.u[c][j] = u;
+            }
+          }
+          return tr;
+        }();
+        return t;
+      }
+
+      // Max-log-MAP over one component code. For each of @p steps trellis
+      // steps there is a systematic LLR and 4 parity LLRs. The trellis starts
+      // and ends in state 0 and the steps from @p infoSteps on are
+      // termination steps, which have only a = 0 branches. @p alpha holds
+      // (steps + 1) x 16 metrics. The extrinsic LLRs of the @p infoSteps
+      // information bits go to @p extrinsic. All implementations give
+      // identical results.
+      typedef void (*TurboSISOFn)(uint32_t steps, uint32_t infoSteps, const float *systematic,
+        const float *parity, float *alpha, float *extrinsic);
+
+      inline void branchMetrics(const Trellis& tr, float sys, const float *p, float g[4][8])
+      {
+        for (uint16_t c = 0; c < 4; c++) {
+          for (uint16_t j = 0; j < 8; j++) {
+            g[c][j] = ((tr.sign[c][0][j] * sys + tr.sign[c][1][j] * p[0])
+              + tr.sign[c][2][j] * p[1]) + tr.sign[c][3][j] * p[2];
+          }
+        }
+      }
+
+      void sisoScalar(uint32_t steps, uint32_t infoSteps, const float *systematic,
+        const float *parity, float *alpha, float *extrinsic)
+      {
+        const Trellis& tr = trellis();
+        float g[4][8];
+
+        alpha[0] = 0.0f;
+        for (uint16_t s = 1; s < STATES; s++) {
+          alpha[s] = NEG_METRIC;
+        }
+        for (uint32_t t = 0; t < steps; t++) {
+          const float *ap = &alpha[t * STATES];
+          float *an = &alpha[(t + 1) * STATES];
+          branchMetrics(tr, systematic[t], &parity[t * 4], g);
+          for (uint16_t j = 0; j < 8; j++) {
+            an[j] = std::max(ap[2 * j] + g[0][j], ap[2 * j + 1] + g[1][j]);
+            an[j + 8] = (t < infoSteps) ?
+              std::max(ap[2 * j] + g[2][j], ap[2 * j + 1] + g[3][j]) : NEG_METRIC;
+          }
+          const float norm = an[0];
+          for (uint16_t s = 0; s < STATES; s++) {
+            an[s] -= norm;
+          }
+        }
+
+        float beta[STATES];
+        float previous[STATES];
+        beta[0] = 0.0f;
+        for (uint16_t s = 1; s < STATES; s++) {
+          beta[s] = NEG_METRIC;
+        }
+        for (uint32_t t = steps; t-- > 0; ) {
+          const float *ap = &alpha[t * STATES];
+          branchMetrics(tr, systematic[t], &parity[t * 4], g);
+          std::copy(beta, beta + STATES, previous);
+          if (t < infoSteps) {
+            float m0 = NEG_METRIC;
+            float m1 = NEG_METRIC;
+            for (uint16_t c = 0; c < 4; c++) {
+              for (uint16_t j = 0; j < 8; j++) {
+                float m = (ap[2 * j + (c & 1)] + g[c][j]) + previous[j + 8 * (c >> 1)];
+                if (tr.u[c][j] != 0.0f) {
+                  m1 = std::max(m1, m);
+                }
+                else {
+                  m0 = std::max(m0, m);
+                }
+              }
+            }
+            extrinsic[t] = (m0 - m1) - systematic[t];
+            for (uint16_t j = 0; j < 8; j++) {
+              beta[2 * j] = std::max(previous[j] + g[0][j], previous[j + 8] + g[2][j]);
+              beta[2 * j + 1] = std::max(previous[j] + g[1][j], previous[j + 8] + g[3][j]);
+            }
+          }
+          else {
+            for (uint16_t j = 0; j < 8; j++) {
+              beta[2 * j] = previous[j] + g[0][j];
+              beta[2 * j + 1] = previous[j] + g[1][j];
+            }
+          }
+          const float norm = beta[0];
+          for (uint16_t s = 0; s < STATES; s++) {
+            beta[s] -= norm;
+          }
+        }
+      } // sisoScalar
+
+#if EX2_SDR_X86_KERNELS
+      __attribute__((target("avx2")))
+      inline void branchMetricsAVX2(const Trellis& tr, float sys, const float *p, __m256 g[4])
+      {
+        const __m256 vs = _mm256_set1_ps(sys);
+        const __m256 v1 = _mm256_set1_ps(p[0]);
+        const __m256 v2 = _mm256_set1_ps(p[1]);
+        const __m256 v3 = _mm256_set1_ps(p[2]);
+        for (uint16_t c = 0; c < 4; c++) {
+          __m256 x = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(tr.sign[c][0]), vs),
+            _mm256_mul_ps(_mm256_loadu_ps(tr.sign[c][1]), v1));
+          x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_loadu_ps(tr.sign[c][2]), v2));
+          g[c] = _mm256_add_ps(x, _mm256_mul_ps(_mm256_loadu_ps(tr.sign[c][3]), v3));
+        }
+      }
+
+      // The even and odd states of 16 metrics
+      __attribute__((target("avx2")))
+      inline void splitStatesAVX2(const float *m, __m256& even, __m256& odd)
+      {
+        const __m256 lo = _mm256_loadu_ps(m);
+        const __m256 hi = _mm256_loadu_ps(m + 8);
+        even = _mm256_castpd_ps(_mm256_permute4x64_pd(
+          _mm256_castps_pd(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+        odd = _mm256_castpd_ps(_mm256_permute4x64_pd(
+          _mm256_castps_pd(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+      }
+
+      __attribute__((target("avx2")))
+      inline float horizontalMaxAVX2(__m256 v)
+      {
+        __m256 x = _mm256_max_ps(v, _mm256_permute2f128_ps(v, v, 1));
+        x = _mm256_max_ps(x, _mm256_permute_ps(x, _MM_SHUFFLE(1, 0, 3, 2)));
+        x = _mm256_max_ps(x, _mm256_permute_ps(x, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm256_cvtss_f32(x);
+      }
+
+      __attribute__((target("avx2")))
+      void sisoAVX2(uint32_t steps, uint32_t infoSteps, const float *systematic,
+        const float *parity, float *alpha, float *extrinsic)
+      {
+        const Trellis& tr = trellis();
+        const __m256 neg = _mm256_set1_ps(NEG_METRIC);
+        __m256 uMask[4];
+        for (uint16_t c = 0; c < 4; c++) {
+          uMask[c] = _mm256_cmp_ps(_mm256_loadu_ps(tr.u[c]), _mm256_setzero_ps(), _CMP_NEQ_OQ);
+        }
+        __m256 g[4];
+        __m256 even, odd;
+
+        alpha[0] = 0.0f;
+        for (uint16_t s = 1; s < STATES; s++) {
+          alpha[s] = NEG_METRIC;
+        }
+        for (uint32_t t = 0; t < steps; t++) {
+          splitStatesAVX2(&alpha[t * STATES], even, odd);
+          branchMetricsAVX2(tr, systematic[t], &parity[t * 4], g);
+          __m256 lo = _mm256_max_ps(_mm256_add_ps(even, g[0]), _mm256_add_ps(odd, g[1]));
+          __m256 hi = (t < infoSteps) ?
+            _mm256_max_ps(_mm256_add_ps(even, g[2]), _mm256_add_ps(odd, g[3])) : neg;
+          const __m256 norm = _mm256_broadcastss_ps(_mm256_castps256_ps128(lo));
+          _mm256_storeu_ps(&alpha[(t + 1) * STATES], _mm256_sub_ps(lo, norm));
+          _mm256_storeu_ps(&alpha[(t + 1) * STATES + 8], _mm256_sub_ps(hi, norm));
+        }
+
+        // beta for states 0-7 and 8-15
+        __m256 b0 = _mm256_blend_ps(neg, _mm256_setzero_ps(), 0x01);
+        __m256 b1 = neg;
+        for (uint32_t t = steps; t-- > 0; ) {
+          branchMetricsAVX2(tr, systematic[t], &parity[t * 4], g);
+          __m256 ne, no;
+          if (t < infoSteps) {
+            splitStatesAVX2(&alpha[t * STATES], even, odd);
+            __m256 m0 = neg;
+            __m256 m1 = neg;
+            const __m256 m[4] = {
+              _mm256_add_ps(_mm256_add_ps(even, g[0]), b0),
+              _mm256_add_ps(_mm256_add_ps(odd, g[1]), b0),
+              _mm256_add_ps(_mm256_add_ps(even, g[2]), b1),
+              _mm256_add_ps(_mm256_add_ps(odd, g[3]), b1)
+            };
+            for (uint16_t c = 0; c < 4; c++) {
+              m1 = _mm256_max_ps(m1, _mm256_blendv_ps(neg, m[c], uMask[c]));
+              m0 = _mm256_max_ps(m0, _mm256_blendv_ps(m[c], neg, uMask[c]));
+            }
+            extrinsic[t] = (horizontalMaxAVX2(m0) - horizontalMaxAVX2(m1)) - systematic[t];
+            ne = _mm256_max_ps(_mm256_add_ps(b0, g[0]), _mm256_add_ps(b1, g[2]));
+            no = _mm256_max_ps(_mm256_add_ps(b0, g[1]), _mm256_add_ps(b1, g[3]));
+          }
+          else {
+            ne = _mm256_add_ps(b0, g[0]);
+            no = _mm256_add_ps(b0, g[1]);
+          }
+          // Interleave the even and odd states back into order
+          const __m256 lo = _mm256_unpacklo_ps(ne, no);
+          const __m256 hi = _mm256_unpackhi_ps(ne, no);
+          b0 = _mm256_permute2f128_ps(lo, hi, 0x20);
+          b1 = _mm256_permute2f128_ps(lo, hi, 0x31);
+          const __m256 norm = _mm256_broadcastss_ps(_mm256_castps256_ps128(b0));
+          b0 = _mm256_sub_ps(b0, norm);
+          b1 = _mm256_sub_ps(b1, norm);
+        }
+      } // sisoAVX2
+#endif
+
+      const DispatchedKernel<TurboSISOFn> sisoKernel({
+#if EX2_SDR_X86_KERNELS
+        { "avx2", CPUFeatures::AVX2, sisoAVX2 },
+#endif
+        { "scalar", CPUFeatures::NONE, sisoScalar }
+      });
+
+    } /* anonymous namespace */
+
+    const uint32_t CCSDSTurbo::DEFAULT_MAX_ITERATIONS;
+    constexpr float CCSDSTurbo::DEFAULT_EXTRINSIC_SCALE;
+    const uint32_t CCSDSTurbo::TAIL_STEPS;
+
+    CCSDSTurbo::CCSDSTurbo(ErrorCorrection::ErrorCorrectionScheme ecScheme) : FEC(ecScheme) {
+      switch (ecScheme) {
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_2:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_2:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_2:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_2:
+          m_outputsPerStep = 2;
+          break;
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_3:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_3:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_3:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_3:
+          m_outputsPerStep = 3;
+          break;
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_4:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_4:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_4:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_4:
+          m_outputsPerStep = 4;
+          break;
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_6:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_6:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_6:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_6:
+          m_outputsPerStep = 6;
+          break;
+        default:
+          throw FECException("CCSDSTurbo scheme is not a CCSDS Turbo code");
+      }
+
+      static const uint8_t patterns[4][2][6] = {
+        { { OUT_0A, OUT_1A }, { OUT_0A, OUT_1B } },
+        { { OUT_0A, OUT_1A, OUT_1B }, { OUT_0A, OUT_1A, OUT_1B } },
+        { { OUT_0A, OUT_2A, OUT_3A, OUT_1B }, { OUT_0A, OUT_2A, OUT_3A, OUT_1B } },
+        { { OUT_0A, OUT_1A, OUT_2A, OUT_3A, OUT_1B, OUT_3B },
+          { OUT_0A, OUT_1A, OUT_2A, OUT_3A, OUT_1B, OUT_3B } }
+      };
+      const uint16_t p = (m_outputsPerStep == 6) ? 3 : m_outputsPerStep - 2;
+      std::copy(&patterns[p][0][0], &patterns[p][0][0] + 12, &m_pattern[0][0]);
+
+      m_errorCorrection = new ErrorCorrection(ecScheme, (MPDU::maxMTU() * 8));
+      m_k = m_errorCorrection->getMessageLen();
+
+      // CCSDS 131.0-B permutation, with k = k1 k2 and k1 = 8. For s = 1..k,
+      // bit s of the permuted block is bit pi(s) of the information block.
+      static const uint16_t primes[8] = { 31, 37, 43, 47, 53, 59, 61, 67 };
+      const uint32_t k1 = 8;
+      const uint32_t k2 = m_k / k1;
+      m_permutation.resize(m_k);
+      for (uint32_t s = 1; s <= m_k; s++) {
+        const uint32_t m = (s - 1) % 2;
+        const uint32_t i = (s - 1) / (2 * k2);
+        const uint32_t j = (s - 1) / 2 - i * k2;
+        const uint32_t t = (19 * i + 1) % (k1 / 2);
+        const uint32_t q = t % 8 + 1;
+        const uint32_t c = (primes[q - 1] * j + 21 * m) % k2;
+        m_permutation[s - 1] = 2 * (t + c * k1 / 2 + 1) - m - 1;
+      }
+
+      const uint32_t steps = m_k + TAIL_STEPS;
+      m_systematicA.resize(steps);
+      m_systematicB.resize(steps);
+      m_parityA.resize(steps * 4);
+      m_parityB.resize(steps * 4);
+      m_channelSystematic.resize(steps);
+      m_extrinsicA.resize(m_k);
+      m_extrinsicB.resize(m_k);
+      m_siso.resize(m_k);
+      m_alpha.resize((steps + 1) * 16);
+      m_hardDecisions.resize(m_k);
+    }
+
+    CCSDSTurbo::~CCSDSTurbo() {
+      if (m_errorCorrection != NULL) {
+        delete m_errorCorrection;
+      }
+    }
+
+    const char *
+    CCSDSTurbo::sisoKernelName() {
+      return sisoKernel.name();
+    }
+
+    std::vector<uint8_t>
+    CCSDSTurbo::encode(const std::vector<uint8_t>& payload) {
+      if (payload.size() != m_k / 8u)
+        throw FECException("CCSDSTurbo encode payload wrong length");
+
+      std::vector<uint8_t> codeword(m_errorCorrection->getCodewordLen() / 8, 0);
+      uint8_t stateA = 0;
+      uint8_t stateB = 0;
+      uint8_t out[7];
+      uint8_t outB[4];
+      uint32_t bit = 0;
+      for (uint32_t t = 0; t < m_k + TAIL_STEPS; t++) {
+        const bool tail = (t >= m_k);
+        uint8_t uA = tail ? 0 : (payload[t / 8] >> (7 - t % 8)) & 1;
+        uint8_t uB = 0;
+        if (!tail) {
+          const uint16_t pi = m_permutation[t];
+          uB = (payload[pi / 8] >> (7 - pi % 8)) & 1;
+        }
+        componentStep(stateA, uA, tail, out);
+        componentStep(stateB, uB, tail, outB);
+        out[OUT_1B] = outB[1];
+        out[OUT_2B] = outB[2];
+        out[OUT_3B] = outB[3];
+
+        const uint8_t *pattern = m_pattern[t & 1];
+        for (uint16_t o = 0; o < m_outputsPerStep; o++, bit++) {
+          if (out[pattern[o]]) {
+            codeword[bit / 8] |= 0x80 >> (bit % 8);
+          }
+        }
+      }
+      return codeword;
+    }
+
+    uint32_t
+    CCSDSTurbo::decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+      std::vector<uint8_t>& decodedPayload) {
+
+      decodedPayload.resize(0); // Resize in all FEC decode methods
+
+      if (encodedPayload.size() != m_errorCorrection->getCodewordLen() / 8) {
+        // make it very obviously fail by returning a huge number of bit errors
+        return UINT32_MAX;
+      }
+
+      // For BPSK over AWGN, hard decisions see a binary symmetric channel
+      // with crossover probability Q(sqrt(2 Es/N0)). Bound it so the LLRs
+      // stay finite for very high SNR estimates.
+      float esN0 = std::pow(10.0f, snrEstimate / 10.0f);
+      float p = 0.5f * std::erfc(std::sqrt(esN0));
+      p = std::min(std::max(p, 1.0e-6f), 0.49f);
+      const float llr = std::log((1.0f - p) / p);
+
+      std::vector<float> llrs(codewordBits());
+      for (uint32_t i = 0; i < llrs.size(); i++) {
+        llrs[i] = ((encodedPayload[i / 8] >> (7 - (i % 8))) & 0x01) ? -llr : llr;
+      }
+
+      return decodeLLR(llrs, decodedPayload);
+    }
+
+    uint32_t
+    CCSDSTurbo::decodeLLR(const std::vector<float>& llrs, std::vector<uint8_t>& decodedPayload) {
+
+      decodedPayload.resize(0); // Resize in all FEC decode methods
+
+      if (llrs.size() != codewordBits()) {
+        return UINT32_MAX;
+      }
+
+      // Sort the channel LLRs to the component decoders; outputs that are
+      // not sent are erasures
+      const uint32_t steps = m_k + TAIL_STEPS;
+      std::fill(m_parityA.begin(), m_parityA.end(), 0.0f);
+      std::fill(m_parityB.begin(), m_parityB.end(), 0.0f);
+      uint32_t bit = 0;
+      for (uint32_t t = 0; t < steps; t++) {
+        const uint8_t *pattern = m_pattern[t & 1];
+        for (uint16_t o = 0; o < m_outputsPerStep; o++, bit++) {
+          const uint8_t output = pattern[o];
+          if (output == OUT_0A) {
+            m_channelSystematic[t] = llrs[bit];
+          }
+          else if (output <= OUT_3A) {
+            m_parityA[t * 4 + output - OUT_1A] = llrs[bit];
+          }
+          else {
+            m_parityB[t * 4 + output - OUT_1B] = llrs[bit];
+          }
+        }
+      }
+
+      // Encoder b's tail inputs are not sent
+      for (uint32_t t = m_k; t < steps; t++) {
+        m_systematicA[t] = m_channelSystematic[t];
+        m_systematicB[t] = 0.0f;
+      }
+      std::fill(m_extrinsicA.begin(), m_extrinsicA.end(), 0.0f);
+      std::fill(m_extrinsicB.begin(), m_extrinsicB.end(), 0.0f);
+
+      const TurboSISOFn siso = sisoKernel.get();
+      const float scale = DEFAULT_EXTRINSIC_SCALE;
+
+      m_lastIterations = 0;
+      m_lastConverged = false;
+      while (!m_lastConverged && m_lastIterations < m_maxIterations) {
+        for (uint32_t t = 0; t < m_k; t++) {
+          m_systematicA[t] = m_channelSystematic[t] + m_extrinsicB[t];
+        }
+        siso(steps, m_k, m_systematicA.data(), m_parityA.data(), m_alpha.data(), m_siso.data());
+        for (uint32_t t = 0; t < m_k; t++) {
+          m_extrinsicA[t] = scale * m_siso[t];
+        }
+
+        for (uint32_t s = 0; s < m_k; s++) {
+          const uint16_t pi = m_permutation[s];
+          m_systematicB[s] = m_channelSystematic[pi] + m_extrinsicA[pi];
+        }
+        siso(steps, m_k, m_systematicB.data(), m_parityB.data(), m_alpha.data(), m_siso.data());
+        for (uint32_t s = 0; s < m_k; s++) {
+          m_extrinsicB[m_permutation[s]] = scale * m_siso[s];
+        }
+
+        // Stop once the hard decisions no longer change
+        bool stable = (m_lastIterations > 0);
+        for (uint32_t t = 0; t < m_k; t++) {
+          uint8_t hard = (m_channelSystematic[t] + m_extrinsicA[t] + m_extrinsicB[t]) < 0.0f;
+          stable = stable && (hard == m_hardDecisions[t]);
+          m_hardDecisions[t] = hard;
+        }
+        m_lastIterations++;
+        m_lastConverged = stable;
+      }
+#if CCSDS_TURBO_DEBUG
+      printf("turbo decode %u iterations, converged %d\n", m_lastIterations, m_lastConverged);
+#endif
+
+      decodedPayload.resize(m_k / 8, 0);
+      for (uint32_t t = 0; t < m_k; t++) {
+        if (m_hardDecisions[t]) {
+          decodedPayload[t / 8] |= 0x80 >> (t % 8);
+        }
+      }
+
+      // Count the corrected codeword bits by re-encoding
+      std::vector<uint8_t> codeword = encode(decodedPayload);
+      uint32_t corrected = 0;
+      for (uint32_t i = 0; i < llrs.size(); i++) {
+        corrected += ((llrs[i] < 0.0f) != ((codeword[i / 8] >> (7 - i % 8)) & 0x01));
+      }
+      return corrected;
+    }
+
+  } /* namespace sdr */
+} /* namespace ex2 */
@@ -0,0 +1,130 @@
+/*!
+ * @file ConcatenatedFEC.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details A composite FEC codec chaining an outer and an inner codec with a
+ * block interleaver between them.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include "ConcatenatedFEC.hpp"
+#include "mpdu.hpp"
+
+#define CONCATENATED_FEC_DEBUG 0
+
+namespace ex2 {
+  namespace sdr {
+
+    ConcatenatedFEC::ConcatenatedFEC(ErrorCorrection::ErrorCorrectionScheme ecScheme) : FEC(ecScheme) {
+      switch (ecScheme) {
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2:
+          m_construct(ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_1,
+            ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_1_2, 4);
+          break;
+        default:
+          throw FECException("Must be a concatenated scheme.");
+//          break;
+      }
+    }
+
+    ConcatenatedFEC::ConcatenatedFEC(ErrorCorrection::ErrorCorrectionScheme ecScheme,
+      ErrorCorrection::ErrorCorrectionScheme outerScheme,
+      ErrorCorrection::ErrorCorrectionScheme innerScheme,
+      uint16_t depth) : FEC(ecScheme) {
+      m_construct(outerScheme, innerScheme, depth);
+    }
+
+    void
+    ConcatenatedFEC::m_construct(ErrorCorrection::ErrorCorrectionScheme outerScheme,
+      ErrorCorrection::ErrorCorrectionScheme innerScheme, uint16_t depth) {
+      if (depth == 0) {
+        throw FECException("Concatenated FEC interleaving depth must be at least 1");
+      }
+      m_outer = FEC::makeFECCodec(outerScheme);
+      m_inner = FEC::makeFECCodec(innerScheme);
+      if (m_outer == NULL || m_inner == NULL) {
+        delete m_outer;
+        delete m_inner;
+        throw FECException("Concatenated FEC scheme has no codec");
+      }
+      m_depth = depth;
+
+      ErrorCorrection outer(outerScheme, (MPDU::maxMTU() * 8));
+      m_outerMessageLen = outer.getMessageLen() / 8;
+      m_outerCodewordLen = outer.getCodewordLen() / 8;
+
+      m_outerMessage.reserve(m_outerMessageLen);
+      m_outerCodeword.reserve(m_outerCodewordLen);
+      m_interleaved.reserve(m_outerCodewordLen * m_depth);
+    }
+
+    ConcatenatedFEC::~ConcatenatedFEC() {
+      if (m_outer != NULL) {
+        delete m_outer;
+      }
+      if (m_inner != NULL) {
+        delete m_inner;
+      }
+    }
+
+    std::vector<uint8_t>
+    ConcatenatedFEC::encode(const std::vector<uint8_t>& payload) {
+      if (payload.size() != m_outerMessageLen * m_depth) {
+        throw FECException("Concatenated FEC encode payload wrong length");
+      }
+
+      // Outer codeword d takes the d-th slice of the payload and its bytes
+      // are written straight to their interleaved positions
+      m_interleaved.resize(m_outerCodewordLen * m_depth);
+      for (uint16_t d = 0; d < m_depth; d++) {
+        m_outerMessage.assign(payload.begin() + d * m_outerMessageLen,
+          payload.begin() + (d + 1) * m_outerMessageLen);
+        std::vector<uint8_t> outerCodeword = m_outer->encode(m_outerMessage);
+        for (uint32_t j = 0; j < m_outerCodewordLen; j++) {
+          m_interleaved[j * m_depth + d] = outerCodeword[j];
+        }
+      }
+
+      return m_inner->encode(m_interleaved);
+    }
+
+    uint32_t
+    ConcatenatedFEC::decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+      std::vector<uint8_t>& decodedPayload) {
+
+      decodedPayload.resize(0); // Resize in all FEC decode methods
+
+      uint32_t innerErrors = m_inner->decode(encodedPayload, snrEstimate, m_interleaved);
+      if (innerErrors == UINT32_MAX || m_interleaved.size() < m_outerCodewordLen * m_depth) {
+        // make it very obviously fail by returning a huge number of bit errors
+        return UINT32_MAX;
+      }
+
+      uint32_t bitErrors = 0;
+      decodedPayload.reserve(m_outerMessageLen * m_depth);
+      for (uint16_t d = 0; d < m_depth; d++) {
+        m_outerCodeword.resize(m_outerCodewordLen);
+        for (uint32_t j = 0; j < m_outerCodewordLen; j++) {
+          m_outerCodeword[j] = m_interleaved[j * m_depth + d];
+        }
+        uint32_t outerErrors = m_outer->decode(m_outerCodeword, snrEstimate, m_outerMessage);
+        if (outerErrors == UINT32_MAX) {
+          decodedPayload.resize(0);
+          return UINT32_MAX;
+        }
+        bitErrors += outerErrors;
+        decodedPayload.insert(decodedPayload.end(), m_outerMessage.begin(), m_outerMessage.end());
+      }
+#if CONCATENATED_FEC_DEBUG
+      printf("concatenated FEC corrected %u bits\n", bitErrors);
+#endif
+      return bitErrors;
+    }
+
+  } /* namespace sdr */
+} /* namespace ex2 */
@@ -29,26 +29,34 @@ namespace ex2 {
     ConvolutionalCodecHD::ConvolutionalCodecHD(ErrorCorrection::ErrorCorrectionScheme ecScheme)  : FEC(ecScheme) {
 
 
-      // Only the CCSDS schemes are permitted
+      // Only the CCSDS schemes are permitted. The puncture patterns are from
+      // CCSDS 131.0-B-3, Table 3-1, interleaved as C1 C2 per input bit.
       switch (ecScheme) {
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_1_2:
           break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_2_3:
-          throw new FECException("Convolutional coding rate 2/3 not yet implemented");
-//          break;
+          // C1: 1 0, C2: 1 1
+          m_puncturePattern = { 1,1, 0,1 };
+          break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_3_4:
-          throw new FECException("Convolutional coding rate 3/4 not yet implemented");
-//          break;
+          // C1: 1 0 1, C2: 1 1 0
+          m_puncturePattern = { 1,1, 0,1, 1,0 };
+          break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_5_6:
-          throw new FECException("Convolutional coding rate 5/6 not yet implemented");
-//          break;
+          // C1: 1 0 1 0 1, C2: 1 1 0 1 0
+          m_puncturePattern = { 1,1, 0,1, 1,0, 0,1, 1,0 };
+          break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_7_8:
-          throw new FECException("Convolutional coding rate 7/8 not yet implemented");
-//          break;
+          // C1: 1 0 0 0 1 0 1, C2: 1 1 1 1 0 1 0
+          m_puncturePattern = { 1,1, 0,1, 0,1, 0,1, 1,0, 0,1, 1,0 };
+          break;
         default:
-          throw new FECException("Must be a Convolutional Codec scheme.");
+          throw FECException("Must be a Convolutional Codec scheme.");
 //          break;
       }
+      for (uint8_t keep : m_puncturePattern) {
+        m_punctureKeptBits += keep;
+      }
 
       // @TODO does this belong in the FEC constructor?
       m_errorCorrection = new ErrorCorrection(ecScheme, (MPDU::maxMTU() * 8));
@@ -56,6 +64,13 @@ namespace ex2 {
 
       m_codec = new ViterbiCodec(CCSDS_CONVOLUTIONAL_CODE_CONSTRAINT, polynomials);
 
+      // Punctured codes have fewer received bits per trellis step, so paths
+      // take longer to merge; scale the traceback depth with the puncture
+      // period (7K for rate 2/3 up to 17K for rate 7/8)
+      if (!m_puncturePattern.empty()) {
+        m_codec->setTracebackDepth(CCSDS_CONVOLUTIONAL_CODE_CONSTRAINT * (3 + m_puncturePattern.size()));
+      }
+
 //      // for dev of memory-reduced algorithm, use constraint len 3 and { 7, 5 }, which is used for a unit test; see qa_viterbi
 //      std::vector<int> polynomials{ 7, 5};
 //
@@ -77,6 +92,10 @@ namespace ex2 {
       // Encode the 8 BPS message
       std::vector<uint8_t> encodedPayload = m_codec->encodePacked(payload);
 
+      if (!m_puncturePattern.empty()) {
+        return m_puncture(encodedPayload);
+      }
+
       return encodedPayload;
     }
 
@@ -93,22 +112,103 @@ namespace ex2 {
         return UINT32_MAX;
       }
       else {
-        // assume the encoded payload is packed, 8 bits per byte. Repack to be
-        // 1 bit per byte
-        MPDUUtility::repack(encodedPayload, MPDUUtility::BPSymb_8, MPDUUtility::BPSymb_1);
-
-        // Decode the 1 bit per byte payload.
-        ViterbiCodec::bitarr_t decoded = m_codec->decodeTruncated(encodedPayload);
+        // assume the encoded payload is packed, 8 bits per byte. Unpack a
+        // copy to 1 bit per byte for the decoder
+        MPDUUtility::repack(ConstBitSpan(encodedPayload), MPDUUtility::BPSymb_1, m_received);
+
+        // Decode the 1 bit per byte payload, restoring any punctured bits as
+        // erasures first.
+        ViterbiCodec::bitarr_t decoded;
+        if (m_puncturePattern.empty()) {
+          decoded = m_codec->decodeTruncated(m_received);
+        }
+        else {
+          decoded = m_codec->decodeTruncated(m_depuncture(m_received));
+        }
 
         // Repack the result to be 8 bits per byte
-        MPDUUtility::repack(decoded, MPDUUtility::BPSymb_1, MPDUUtility::BPSymb_8);
-        decodedPayload.resize(0);
-        decodedPayload.insert(decodedPayload.end(),decoded.begin(),decoded.end());
+        MPDUUtility::repack(decoded, MPDUUtility::BPSymb_1, MPDUUtility::BPSymb_8, decodedPayload);
 
         // We have no way to know if there are bit errors, so return zero (0)
         return 0;
       }
     }
 
+    uint32_t
+    ConvolutionalCodecHD::decodeList(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+      unsigned int listSize, std::vector<std::vector<uint8_t>>& decodedPayloads) {
+
+      (void) snrEstimate; // Not used in this method
+
+      decodedPayloads.resize(0);
+
+      if (!m_codec) {
+        return UINT32_MAX;
+      }
+
+      MPDUUtility::repack(ConstBitSpan(encodedPayload), MPDUUtility::BPSymb_1, m_received);
+
+      std::vector<ViterbiCodec::bitarr_t> decodedList;
+      if (m_puncturePattern.empty()) {
+        decodedList = m_codec->decodeList(m_received, listSize);
+      }
+      else {
+        decodedList = m_codec->decodeList(m_depuncture(m_received), listSize);
+      }
+
+      decodedPayloads.resize(decodedList.size());
+      for (size_t i = 0; i < decodedList.size(); i++) {
+        MPDUUtility::repack(decodedList[i], MPDUUtility::BPSymb_1, MPDUUtility::BPSymb_8, decodedPayloads[i]);
+      }
+
+      return 0;
+    }
+
+    std::vector<uint8_t>
+    ConvolutionalCodecHD::m_puncture(const std::vector<uint8_t>& motherCodeword) const
+    {
+      const uint32_t period = m_puncturePattern.size();
+      ConstBitSpan mother(motherCodeword);
+      BitBuffer punctured;
+      punctured.reserve((mother.size() * m_punctureKeptBits) / period + 8);
+
+      uint32_t p = 0;
+      for (size_t i = 0; i < mother.size(); i++) {
+        if (m_puncturePattern[p]) {
+          punctured.append(mother.get(i));
+        }
+        p = (p + 1 == period) ? 0 : p + 1;
+      }
+
+      // The last byte is zero-padded
+      return punctured.bytes();
+    }
+
+    ViterbiCodec::bitarr_t
+    ConvolutionalCodecHD::m_depuncture(const ViterbiCodec::bitarr_t& received) const
+    {
+      const uint32_t period = m_puncturePattern.size();
+
+      // Each period carries period/2 message bits in m_punctureKeptBits
+      // transmitted bits
+      uint32_t messageBits = (received.size() * (period / 2)) / m_punctureKeptBits;
+      messageBits -= (messageBits % 8);
+
+      ViterbiCodec::bitarr_t mother(messageBits * 2);
+      uint32_t r = 0;
+      uint32_t p = 0;
+      for (uint32_t i = 0; i < mother.size(); i++) {
+        if (m_puncturePattern[p]) {
+          mother[i] = received[r++];
+        }
+        else {
+          mother[i] = ViterbiCodec::ERASED_BIT;
+        }
+        p = (p + 1 == period) ? 0 : p + 1;
+      }
+
+      return mother;
+    }
+
   } /* namespace sdr */
 } /* namespace ex2 */
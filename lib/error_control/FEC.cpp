@@ -14,8 +14,12 @@
 
 
 #include "FEC.hpp"
+#include "CCSDSLDPC.hpp"
+#include "CCSDSTurbo.hpp"
+#include "ConcatenatedFEC.hpp"
 #include "NoFEC.hpp"
 #include "QCLDPC.hpp"
+#include "ReedSolomon.hpp"
 #include "ConvolutionalCodecHD.hpp"
 
 namespace ex2 {
@@ -37,7 +41,7 @@ namespace ex2 {
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_4:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_5:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_8:
-          newFEC = NULL; // @TODO change when this is implemented
+          newFEC = new ReedSolomon(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_1:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_2:
@@ -45,65 +49,72 @@ namespace ex2 {
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_4:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_5:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_8:
-          newFEC = NULL; // @TODO change when this is implemented
+          newFEC = new ReedSolomon(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_2:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_3:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_4:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_6:
-          newFEC = NULL; // @TODO change when this is implemented
+          newFEC = new CCSDSTurbo(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_2:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_3:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_4:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_6:
-          newFEC = NULL; // @TODO change when this is implemented
+          newFEC = new CCSDSTurbo(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_2:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_3:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_4:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_6:
-          newFEC = NULL; // @TODO change when this is implemented
+          newFEC = new CCSDSTurbo(ecScheme);
+          break;
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_2:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_3:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_4:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_6:
+          newFEC = new CCSDSTurbo(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_1280:
-          newFEC = NULL; // @TODO change when this is implemented
+          newFEC = new CCSDSLDPC(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_1536:
-          newFEC = NULL; // @TODO change when this is implemented
+          newFEC = new CCSDSLDPC(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_2048:
-          newFEC = NULL; // @TODO change when this is implemented
+          newFEC = new CCSDSLDPC(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_648_R_1_2:
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_648_R_2_3:
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_648_R_3_4:
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_648_R_5_6:
-          newFEC = new QCLDPC(ecScheme); // @TODO change when this is implemented
+          newFEC = new QCLDPC(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1296_R_1_2:
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1296_R_2_3:
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1296_R_3_4:
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1296_R_5_6:
-          newFEC = new QCLDPC(ecScheme); // @TODO change when this is implemented
+          newFEC = new QCLDPC(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1944_R_1_2:
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1944_R_2_3:
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1944_R_3_4:
         case ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1944_R_5_6:
-          newFEC = new QCLDPC(ecScheme); // @TODO change when this is implemented
+          newFEC = new QCLDPC(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_1_2:
-          newFEC = new ConvolutionalCodecHD(ecScheme);
-          break;
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_2_3:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_3_4:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_5_6:
         case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_7_8:
-          newFEC = NULL; // @TODO change when this is implemented
+          newFEC = new ConvolutionalCodecHD(ecScheme);
           break;
         case ErrorCorrection::ErrorCorrectionScheme::NO_FEC:
           newFEC = new NoFEC(ecScheme);
           break;
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2:
+          newFEC = new ConcatenatedFEC(ecScheme);
+          break;
 
 
         default:
@@ -119,5 +130,14 @@ namespace ex2 {
 
     }
 
+    uint32_t
+    FEC::decodeList(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+      unsigned int listSize, std::vector<std::vector<uint8_t>>& decodedPayloads)
+    {
+      (void) listSize;
+      decodedPayloads.resize(1);
+      return decode(encodedPayload, snrEstimate, decodedPayloads.front());
+    }
+
   } /* namespace sdr */
 } /* namespace ex2 */
@@ -0,0 +1,175 @@
+/*!
+ * @file LDPCMinSum.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Min-sum check node kernels shared by the layered LDPC decoders.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cfloat>
+#include <cmath>
+
+#include "LDPCMinSum.hpp"
+
+#if EX2_SDR_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace ex2 {
+  namespace sdr {
+
+    namespace {
+
+      void minSumLayerScalar(float *posterior, float *check, uint16_t degree,
+        uint16_t zPadded, float normalization, float offset)
+      {
+        float min1[MIN_SUM_MAX_Z_PADDED];
+        float min2[MIN_SUM_MAX_Z_PADDED];
+        uint16_t minIndex[MIN_SUM_MAX_Z_PADDED];
+        uint8_t signs[MIN_SUM_MAX_Z_PADDED];
+        for (uint16_t i = 0; i < zPadded; i++) {
+          min1[i] = FLT_MAX;
+          min2[i] = FLT_MAX;
+          minIndex[i] = 0;
+          signs[i] = 0;
+        }
+
+        for (uint16_t k = 0; k < degree; k++) {
+          float *l = &posterior[k * zPadded];
+          const float *r = &check[k * zPadded];
+          for (uint16_t i = 0; i < zPadded; i++) {
+            float q = l[i] - r[i];
+            l[i] = q;
+            float a = std::fabs(q);
+            if (a < min1[i]) {
+              min2[i] = min1[i];
+              min1[i] = a;
+              minIndex[i] = k;
+            }
+            else if (a < min2[i]) {
+              min2[i] = a;
+            }
+            signs[i] ^= (q < 0.0f);
+          }
+        }
+
+        for (uint16_t i = 0; i < zPadded; i++) {
+          float m = normalization * min1[i] - offset;
+          min1[i] = (m > 0.0f) ? m : 0.0f;
+          m = normalization * min2[i] - offset;
+          min2[i] = (m > 0.0f) ? m : 0.0f;
+        }
+
+        for (uint16_t k = 0; k < degree; k++) {
+          float *l = &posterior[k * zPadded];
+          float *r = &check[k * zPadded];
+          for (uint16_t i = 0; i < zPadded; i++) {
+            float q = l[i];
+            float magnitude = (minIndex[i] == k) ? min2[i] : min1[i];
+            float rNew = (signs[i] ^ (q < 0.0f)) ? -magnitude : magnitude;
+            r[i] = rNew;
+            l[i] = q + rNew;
+          }
+        }
+      } // minSumLayerScalar
+
+#if EX2_SDR_X86_KERNELS
+      __attribute__((target("sse2")))
+      void minSumLayerSSE2(float *posterior, float *check, uint16_t degree,
+        uint16_t zPadded, float normalization, float offset)
+      {
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 alpha = _mm_set1_ps(normalization);
+        const __m128 beta = _mm_set1_ps(offset);
+        for (uint16_t i = 0; i < zPadded; i += 4) {
+          __m128 min1 = _mm_set1_ps(FLT_MAX);
+          __m128 min2 = min1;
+          __m128 minIndex = zero;
+          __m128 signs = zero;
+          for (uint16_t k = 0; k < degree; k++) {
+            float *l = &posterior[k * zPadded + i];
+            __m128 q = _mm_sub_ps(_mm_loadu_ps(l), _mm_loadu_ps(&check[k * zPadded + i]));
+            _mm_storeu_ps(l, q);
+            __m128 a = _mm_andnot_ps(signBit, q);
+            __m128 lt1 = _mm_cmplt_ps(a, min1);
+            __m128 lt2 = _mm_cmplt_ps(a, min2);
+            min2 = _mm_or_ps(_mm_and_ps(lt1, min1),
+              _mm_andnot_ps(lt1, _mm_or_ps(_mm_and_ps(lt2, a), _mm_andnot_ps(lt2, min2))));
+            min1 = _mm_or_ps(_mm_and_ps(lt1, a), _mm_andnot_ps(lt1, min1));
+            minIndex = _mm_or_ps(_mm_and_ps(lt1, _mm_set1_ps((float) k)), _mm_andnot_ps(lt1, minIndex));
+            signs = _mm_xor_ps(signs, _mm_cmplt_ps(q, zero));
+          }
+          min1 = _mm_max_ps(_mm_sub_ps(_mm_mul_ps(alpha, min1), beta), zero);
+          min2 = _mm_max_ps(_mm_sub_ps(_mm_mul_ps(alpha, min2), beta), zero);
+          for (uint16_t k = 0; k < degree; k++) {
+            float *l = &posterior[k * zPadded + i];
+            __m128 q = _mm_loadu_ps(l);
+            __m128 isMin = _mm_cmpeq_ps(minIndex, _mm_set1_ps((float) k));
+            __m128 magnitude = _mm_or_ps(_mm_and_ps(isMin, min2), _mm_andnot_ps(isMin, min1));
+            __m128 negative = _mm_xor_ps(signs, _mm_cmplt_ps(q, zero));
+            __m128 rNew = _mm_xor_ps(magnitude, _mm_and_ps(negative, signBit));
+            _mm_storeu_ps(&check[k * zPadded + i], rNew);
+            _mm_storeu_ps(l, _mm_add_ps(q, rNew));
+          }
+        }
+      } // minSumLayerSSE2
+
+      __attribute__((target("avx2")))
+      void minSumLayerAVX2(float *posterior, float *check, uint16_t degree,
+        uint16_t zPadded, float normalization, float offset)
+      {
+        const __m256 signBit = _mm256_set1_ps(-0.0f);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 alpha = _mm256_set1_ps(normalization);
+        const __m256 beta = _mm256_set1_ps(offset);
+        for (uint16_t i = 0; i < zPadded; i += 8) {
+          __m256 min1 = _mm256_set1_ps(FLT_MAX);
+          __m256 min2 = min1;
+          __m256 minIndex = zero;
+          __m256 signs = zero;
+          for (uint16_t k = 0; k < degree; k++) {
+            float *l = &posterior[k * zPadded + i];
+            __m256 q = _mm256_sub_ps(_mm256_loadu_ps(l), _mm256_loadu_ps(&check[k * zPadded + i]));
+            _mm256_storeu_ps(l, q);
+            __m256 a = _mm256_andnot_ps(signBit, q);
+            __m256 lt1 = _mm256_cmp_ps(a, min1, _CMP_LT_OQ);
+            __m256 lt2 = _mm256_cmp_ps(a, min2, _CMP_LT_OQ);
+            min2 = _mm256_blendv_ps(_mm256_blendv_ps(min2, a, lt2), min1, lt1);
+            min1 = _mm256_blendv_ps(min1, a, lt1);
+            minIndex = _mm256_blendv_ps(minIndex, _mm256_set1_ps((float) k), lt1);
+            signs = _mm256_xor_ps(signs, _mm256_cmp_ps(q, zero, _CMP_LT_OQ));
+          }
+          min1 = _mm256_max_ps(_mm256_sub_ps(_mm256_mul_ps(alpha, min1), beta), zero);
+          min2 = _mm256_max_ps(_mm256_sub_ps(_mm256_mul_ps(alpha, min2), beta), zero);
+          for (uint16_t k = 0; k < degree; k++) {
+            float *l = &posterior[k * zPadded + i];
+            __m256 q = _mm256_loadu_ps(l);
+            __m256 isMin = _mm256_cmp_ps(minIndex, _mm256_set1_ps((float) k), _CMP_EQ_OQ);
+            __m256 magnitude = _mm256_blendv_ps(min1, min2, isMin);
+            __m256 negative = _mm256_xor_ps(signs, _mm256_cmp_ps(q, zero, _CMP_LT_OQ));
+            __m256 rNew = _mm256_xor_ps(magnitude, _mm256_and_ps(negative, signBit));
+            _mm256_storeu_ps(&check[k * zPadded + i], rNew);
+            _mm256_storeu_ps(l, _mm256_add_ps(q, rNew));
+          }
+        }
+      } // minSumLayerAVX2
+#endif
+
+    } /* anonymous namespace */
+
+    const DispatchedKernel<MinSumLayerFn> minSumLayerKernel({
+#if EX2_SDR_X86_KERNELS
+      { "avx2", CPUFeatures::AVX2, minSumLayerAVX2 },
+      { "sse2", CPUFeatures::SSE2, minSumLayerSSE2 },
+#endif
+      { "scalar", CPUFeatures::NONE, minSumLayerScalar }
+    });
+
+  } /* namespace sdr */
+} /* namespace ex2 */
@@ -12,14 +12,152 @@
  * This software may not be modified or distributed in any form, except as described in the LICENSE file.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 #include "QCLDPC.hpp"
+#include "LDPCMinSum.hpp"
 #include "mpdu.hpp"
 
 namespace ex2 {
   namespace sdr {
 
-    QCLDPC::QCLDPC(ErrorCorrection::ErrorCorrectionScheme ecScheme) : FEC(ecScheme){
+    namespace {
+
+      // A Z bit block of a codeword; bit r is in word r/64. Z <= 128
+      struct ZBlock {
+        uint64_t w[2];
+      };
+
+      uint8_t reverseByte(uint8_t b)
+      {
+        b = (uint8_t) (((b & 0xF0) >> 4) | ((b & 0x0F) << 4));
+        b = (uint8_t) (((b & 0xCC) >> 2) | ((b & 0x33) << 2));
+        b = (uint8_t) (((b & 0xAA) >> 1) | ((b & 0x55) << 1));
+        return b;
+      }
+
+      // Get len <= 64 bits starting at bit offset
+      uint64_t getBits(const std::vector<uint64_t>& words, uint32_t offset, uint32_t len)
+      {
+        uint32_t w = offset / 64;
+        uint32_t sh = offset % 64;
+        uint64_t v = words[w] >> sh;
+        if (sh != 0 && sh + len > 64) {
+          v |= words[w + 1] << (64 - sh);
+        }
+        return (len < 64) ? (v & ((1ULL << len) - 1)) : v;
+      }
+
+      // OR len <= 64 bits of v into the words starting at bit offset
+      void putBits(std::vector<uint64_t>& words, uint32_t offset, uint32_t len, uint64_t v)
+      {
+        uint32_t w = offset / 64;
+        uint32_t sh = offset % 64;
+        words[w] |= v << sh;
+        if (sh != 0 && sh + len > 64) {
+          words[w + 1] |= v >> (64 - sh);
+        }
+      }
+
+      ZBlock loadBlock(const std::vector<uint64_t>& words, uint32_t offset, uint8_t z)
+      {
+        ZBlock b;
+        b.w[0] = getBits(words, offset, (z < 64) ? z : 64);
+        b.w[1] = (z > 64) ? getBits(words, offset + 64, z - 64) : 0;
+        return b;
+      }
+
+      void storeBlock(std::vector<uint64_t>& words, uint32_t offset, uint8_t z, const ZBlock& b)
+      {
+        putBits(words, offset, (z < 64) ? z : 64, b.w[0]);
+        if (z > 64) {
+          putBits(words, offset + 64, z - 64, b.w[1]);
+        }
+      }
+
+      // Multiply by the circulant P^s, the identity with its columns shifted
+      // right by s, i.e., bit r of the result is bit (r + s) mod z of x
+      ZBlock rotate(const ZBlock& x, uint8_t s, uint8_t z)
+      {
+        if (s == 0) {
+          return x;
+        }
+        const uint8_t t = z - s;
+        ZBlock r;
+        // x >> s
+        if (s < 64) {
+          r.w[0] = (x.w[0] >> s) | (x.w[1] << (64 - s));
+          r.w[1] = x.w[1] >> s;
+        }
+        else {
+          r.w[0] = x.w[1] >> (s - 64);
+          r.w[1] = 0;
+        }
+        // | x << (z - s)
+        if (t < 64) {
+          r.w[1] |= (x.w[1] << t) | (t ? (x.w[0] >> (64 - t)) : 0);
+          r.w[0] |= x.w[0] << t;
+        }
+        else {
+          r.w[1] |= x.w[0] << (t - 64);
+        }
+        // keep z bits
+        if (z < 64) {
+          r.w[0] &= (1ULL << z) - 1;
+          r.w[1] = 0;
+        }
+        else if (z < 128) {
+          r.w[1] &= (z > 64) ? ((1ULL << (z - 64)) - 1) : 0;
+        }
+        return r;
+      }
+
+      inline void xorBlock(ZBlock& a, const ZBlock& b)
+      {
+        a.w[0] ^= b.w[0];
+        a.w[1] ^= b.w[1];
+      }
+
+      // LLR for the message bits beyond the payload, which are known zeros
+      const float KNOWN_ZERO_LLR = 1.0e4f;
+
+    } /* anonymous namespace */
+
+    const uint32_t QCLDPC::DEFAULT_MAX_ITERATIONS;
+
+    QCLDPC::QCLDPC(ErrorCorrection::ErrorCorrectionScheme ecScheme) : FEC(ecScheme),
+      m_baseMatrix(QCLDPCBaseMatrix::forScheme(ecScheme))
+#if QCLDPC_FIXED_POINT
+      , m_fixedPoint(m_baseMatrix, m_baseMatrix.infoCols() * m_baseMatrix.z, DEFAULT_MAX_ITERATIONS)
+#endif
+    {
       m_errorCorrection = new ErrorCorrection(ecScheme, (MPDU::maxMTU() * 8));
+      if (m_errorCorrection->getCodewordLen() != m_baseMatrix.n) {
+        throw FECException("QCLDPC codeword length does not match the base matrix");
+      }
+      m_codewordWords.resize(m_baseMatrix.n / 64 + 2);
+
+      // Collect the non-zero circulants of each layer
+      for (uint16_t r = 0; r < m_baseMatrix.rows; r++) {
+        m_layerStart.push_back(m_edgeCol.size());
+        for (uint16_t c = 0; c < QCLDPCBaseMatrix::BLOCK_COLS; c++) {
+          int8_t h = m_baseMatrix.shift(r, c);
+          if (h >= 0) {
+            m_edgeCol.push_back(c);
+            m_edgeShift.push_back(h);
+          }
+        }
+      }
+      m_layerStart.push_back(m_edgeCol.size());
+
+#if !QCLDPC_FIXED_POINT
+      m_zPadded = ((m_baseMatrix.z + MIN_SUM_LANES - 1) / MIN_SUM_LANES) * MIN_SUM_LANES;
+      m_posterior.resize(m_baseMatrix.n);
+      m_checkMessages.resize(m_edgeCol.size() * m_zPadded);
+      m_layerPosterior.resize(QCLDPCBaseMatrix::BLOCK_COLS * m_zPadded);
+#endif
     }
 
     QCLDPC::~QCLDPC() {
@@ -30,50 +168,310 @@ namespace ex2 {
 
     std::vector<uint8_t>
     QCLDPC::encode(const std::vector<uint8_t>& payload) {
-      // @todo For now we pretend to encode the payload according to the rate
-      // @todo change me!
-
       // Note that for some IEEE_802_11N_QCLDPC_xxx schemes, the message length
       // is not a integer number of bytes. E.g., for IEEE_802_11N_QCLDPC_648_R_1_2
       // the message length is 324 bits = 40.5 bytes. Rather than do everything
       // using 1 bit per byte (and consuming lots of memory), we choose to accept
       // payloads that are the floor of the fractional message length. That is
-      // checked next.
+      // checked next. The remaining message bits are zero. Use encodeBits
+      // for the whole message.
       uint32_t messageLenBits = m_errorCorrection->getMessageLen(); // bits
       if (payload.size() != (messageLenBits / 8))
         throw FECException("QCLDPC encode payload wrong length");
 
-      // @TODO temp code to fake a codeword. In the actual implementation,
-      // we'd repack the payload to 1 bit per byte and, if needed, append zeros
-      // to make it the true message length, then encode, then repack to 8 bits
-      // per byte and return
-      std::vector<uint8_t> payloadData = payload;
-      // extend the unencoded payload to the codeword length, padding with zeros
-      payloadData.resize(m_errorCorrection->getCodewordLen()/8,0);
-      // @TODO don't forget to convert to bits, or change LDPC code to work with
-      // bytes as input and output
-      return payloadData;
+      m_encode(ConstBitSpan(payload));
+
+      // Repack msb first
+      std::vector<uint8_t> codeword(m_baseMatrix.n / 8);
+      for (uint32_t i = 0; i < codeword.size(); i++) {
+        codeword[i] = reverseByte((uint8_t) (m_codewordWords[i / 8] >> ((i % 8) * 8)));
+      }
+      return codeword;
+    }
+
+    BitBuffer
+    QCLDPC::encodeBits(ConstBitSpan message) {
+      if (message.size() != m_errorCorrection->getMessageLen())
+        throw FECException("QCLDPC encode message wrong length");
+
+      m_encode(message);
+
+      // Repack msb first
+      BitBuffer codeword(m_baseMatrix.n);
+      for (uint32_t i = 0; i < m_baseMatrix.n / 8; i++) {
+        codeword.data()[i] = reverseByte((uint8_t) (m_codewordWords[i / 8] >> ((i % 8) * 8)));
+      }
+      return codeword;
+    }
+
+    void
+    QCLDPC::m_encode(ConstBitSpan message) {
+      const uint8_t z = m_baseMatrix.z;
+      const uint16_t kb = m_baseMatrix.infoCols();
+      const uint16_t mb = m_baseMatrix.rows;
+
+      // Load the message into the systematic part of the codeword, lsb
+      // first; any bits beyond it are zero
+      std::fill(m_codewordWords.begin(), m_codewordWords.end(), 0);
+      uint32_t i = 0;
+      for (; i + 8 <= message.size(); i += 8) {
+        m_codewordWords[i / 64] |= ((uint64_t) reverseByte((uint8_t) message.extract(i, 8))) << (i % 64);
+      }
+      for (; i < message.size(); i++) {
+        m_codewordWords[i / 64] |= ((uint64_t) message.get(i)) << (i % 64);
+      }
+
+      ZBlock info[QCLDPCBaseMatrix::BLOCK_COLS];
+      for (uint16_t c = 0; c < kb; c++) {
+        info[c] = loadBlock(m_codewordWords, c * z, z);
+      }
+
+      // lambda_i = sum over the information columns j of P^h(i,j) s_j
+      ZBlock lambda[QCLDPCBaseMatrix::BLOCK_COLS];
+      ZBlock p0 = {{0, 0}};
+      for (uint16_t r = 0; r < mb; r++) {
+        lambda[r] = {{0, 0}};
+        for (uint16_t c = 0; c < kb; c++) {
+          int8_t h = m_baseMatrix.shift(r, c);
+          if (h >= 0) {
+            xorBlock(lambda[r], rotate(info[c], h, z));
+          }
+        }
+        xorBlock(p0, lambda[r]);
+      }
+
+      // Summing all rows, the staircase parity blocks cancel, as do the two
+      // shift 1 entries of the first parity column, leaving its shift 0 entry,
+      // so p_0 is the sum of the lambdas. The rest follow by back-substitution
+      // down the dual diagonal:
+      //   p_(i+1) = lambda_i + P^h(i,kb) p_0 + p_i
+      ZBlock p = p0;
+      storeBlock(m_codewordWords, kb * z, z, p0);
+      for (uint16_t r = 0; r + 1 < mb; r++) {
+        ZBlock next = lambda[r];
+        int8_t h = m_baseMatrix.shift(r, kb);
+        if (h >= 0) {
+          xorBlock(next, rotate(p0, h, z));
+        }
+        if (r > 0) {
+          xorBlock(next, p);
+        }
+        p = next;
+        storeBlock(m_codewordWords, (kb + r + 1) * z, z, p);
+      }
+
+    }
+
+    void
+    QCLDPC::setMaxIterations(uint32_t maxIterations) {
+      m_maxIterations = maxIterations;
+#if QCLDPC_FIXED_POINT
+      m_fixedPoint.setMaxIterations(maxIterations);
+#endif
+    }
+
+    void
+    QCLDPC::setMinSumVariant(MinSumVariant variant, float factor) {
+      if (variant == MinSumVariant::NORMALIZED) {
+        m_normalization = factor;
+        m_offset = 0.0f;
+#if QCLDPC_FIXED_POINT
+        m_fixedPoint.setNormalization(factor);
+#endif
+      }
+      else {
+        m_normalization = 1.0f;
+        m_offset = factor;
+#if QCLDPC_FIXED_POINT
+        m_fixedPoint.setOffset((uint8_t) QCLDPCFixedPoint::quantize(factor,
+          QCLDPCFixedPoint::DEFAULT_LLR_SCALE));
+#endif
+      }
     }
 
     uint32_t
     QCLDPC::decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
       std::vector<uint8_t>& decodedPayload) {
 
-      (void) snrEstimate; // Not used in this method
+      decodedPayload.resize(0); // Resize in all FEC decode methods
+
+      if (encodedPayload.size() != m_baseMatrix.n / 8) {
+        // make it very obviously fail by returning a huge number of bit errors
+        return UINT32_MAX;
+      }
+
+      // For BPSK over AWGN, hard decisions see a binary symmetric channel
+      // with crossover probability Q(sqrt(2 Es/N0)). Bound it so the LLRs
+      // stay finite for very high SNR estimates.
+      float esN0 = std::pow(10.0f, snrEstimate / 10.0f);
+      float p = 0.5f * std::erfc(std::sqrt(esN0));
+      p = std::min(std::max(p, 1.0e-6f), 0.49f);
+      const float llr = std::log((1.0f - p) / p);
+
+#if QCLDPC_FIXED_POINT
+      decodedPayload.resize(m_errorCorrection->getMessageLen() / 8);
+      uint32_t corrected = m_fixedPoint.decodeHard(encodedPayload.data(),
+        QCLDPCFixedPoint::quantize(llr, QCLDPCFixedPoint::DEFAULT_LLR_SCALE), decodedPayload.data());
+      m_lastIterations = m_fixedPoint.lastIterations();
+      m_lastConverged = m_fixedPoint.lastConverged();
+      return corrected;
+#else
+      std::vector<float> llrs(m_baseMatrix.n);
+      for (uint32_t i = 0; i < m_baseMatrix.n; i++) {
+        llrs[i] = ((encodedPayload[i / 8] >> (7 - (i % 8))) & 0x01) ? -llr : llr;
+      }
+
+      return decodeLLR(llrs, decodedPayload);
+#endif
+    }
 
-      // @todo For now we pretend to dencode the payload according to the rate
+    uint32_t
+    QCLDPC::decodeLLR(const std::vector<float>& llrs, std::vector<uint8_t>& decodedPayload) {
 
       decodedPayload.resize(0); // Resize in all FEC decode methods
 
-      // Here is where we apply the FEC decode algorithm.
-      // For no FEC, just copy the data
-      decodedPayload.insert(decodedPayload.end(),
-        encodedPayload.begin(), encodedPayload.begin() + m_errorCorrection->getMessageLen()/8);
+      const uint32_t n = m_baseMatrix.n;
+      if (llrs.size() != n) {
+        return UINT32_MAX;
+      }
+
+#if QCLDPC_FIXED_POINT
+      decodedPayload.resize(m_errorCorrection->getMessageLen() / 8);
+      uint32_t corrected = m_fixedPoint.decode(llrs.data(), QCLDPCFixedPoint::DEFAULT_LLR_SCALE,
+        decodedPayload.data());
+      m_lastIterations = m_fixedPoint.lastIterations();
+      m_lastConverged = m_fixedPoint.lastConverged();
+      return corrected;
+#else
+      const uint32_t payloadBits = (m_errorCorrection->getMessageLen() / 8) * 8;
+      uint32_t corrected = m_decodeLLR(llrs, payloadBits);
+
+      // Extract the payload
+      decodedPayload.resize(payloadBits / 8, 0);
+      for (uint32_t i = 0; i < payloadBits; i++) {
+        if (m_posterior[i] < 0.0f) {
+          decodedPayload[i / 8] |= 0x80 >> (i % 8);
+        }
+      }
+
+      return corrected;
+#endif
+    }
+
+    uint32_t
+    QCLDPC::decodeLLR(const std::vector<float>& llrs, BitBuffer& decodedMessage) {
+
+      decodedMessage.clear();
+
+      const uint32_t n = m_baseMatrix.n;
+      if (llrs.size() != n) {
+        return UINT32_MAX;
+      }
+
+      const uint32_t messageLenBits = m_errorCorrection->getMessageLen();
+#if QCLDPC_FIXED_POINT
+      std::vector<uint8_t> message((messageLenBits + 7) / 8);
+      uint32_t corrected = m_fixedPoint.decodeMessage(llrs.data(), QCLDPCFixedPoint::DEFAULT_LLR_SCALE,
+        message.data());
+      m_lastIterations = m_fixedPoint.lastIterations();
+      m_lastConverged = m_fixedPoint.lastConverged();
+      decodedMessage.append(ConstBitSpan(message));
+      decodedMessage.resize(messageLenBits);
+      return corrected;
+#else
+      uint32_t corrected = m_decodeLLR(llrs, messageLenBits);
+
+      decodedMessage.resize(messageLenBits);
+      for (uint32_t i = 0; i < messageLenBits; i++) {
+        if (m_posterior[i] < 0.0f) {
+          decodedMessage.set(i, true);
+        }
+      }
+
+      return corrected;
+#endif
+    }
+
+#if !QCLDPC_FIXED_POINT
+    uint32_t
+    QCLDPC::m_decodeLLR(const std::vector<float>& llrs, uint32_t knownBits) {
+      const uint8_t z = m_baseMatrix.z;
+      const uint16_t zp = m_zPadded;
+      const uint32_t messageLenBits = m_errorCorrection->getMessageLen();
+
+      std::copy(llrs.begin(), llrs.end(), m_posterior.begin());
+      // The message bits beyond those sent are known to be zero
+      for (uint32_t i = knownBits; i < messageLenBits; i++) {
+        m_posterior[i] = KNOWN_ZERO_LLR;
+      }
+      std::fill(m_checkMessages.begin(), m_checkMessages.end(), 0.0f);
+      std::fill(m_layerPosterior.begin(), m_layerPosterior.end(), 0.0f);
+
+      const MinSumLayerFn minSumLayer = minSumLayerKernel.get();
+
+      m_lastIterations = 0;
+      m_lastConverged = m_syndromeIsZero();
+      while (!m_lastConverged && m_lastIterations < m_maxIterations) {
+        for (uint16_t r = 0; r < m_baseMatrix.rows; r++) {
+          const uint16_t first = m_layerStart[r];
+          const uint16_t degree = m_layerStart[r + 1] - first;
+
+          // Gather each circulant's posteriors into circulant row order; row
+          // i of P^h connects to variable (i + h) mod z
+          for (uint16_t k = 0; k < degree; k++) {
+            const float *v = &m_posterior[m_edgeCol[first + k] * z];
+            float *g = &m_layerPosterior[k * zp];
+            const uint8_t h = m_edgeShift[first + k];
+            std::memcpy(g, v + h, (z - h) * sizeof(float));
+            std::memcpy(g + (z - h), v, h * sizeof(float));
+          }
 
-      // @TODO Consistent with the encode method, if the final message length is
-      // not a multiple of 8 bits, we simply drop the last bits to make it so
-      // since the encode method above originally made those zeros
-      return 0;
+          minSumLayer(m_layerPosterior.data(), &m_checkMessages[first * zp], degree, zp,
+            m_normalization, m_offset);
+
+          // Scatter them back
+          for (uint16_t k = 0; k < degree; k++) {
+            float *v = &m_posterior[m_edgeCol[first + k] * z];
+            const float *g = &m_layerPosterior[k * zp];
+            const uint8_t h = m_edgeShift[first + k];
+            std::memcpy(v + h, g, (z - h) * sizeof(float));
+            std::memcpy(v, g + (z - h), h * sizeof(float));
+          }
+        }
+        m_lastIterations++;
+        m_lastConverged = m_syndromeIsZero();
+      }
+
+      // Count the corrected hard decisions
+      uint32_t corrected = 0;
+      for (uint32_t i = 0; i < m_baseMatrix.n; i++) {
+        corrected += ((llrs[i] < 0.0f) != (m_posterior[i] < 0.0f));
+      }
+
+      return corrected;
+    }
+#endif
+
+    bool
+    QCLDPC::m_syndromeIsZero() {
+      const uint8_t z = m_baseMatrix.z;
+
+      // Pack the hard decisions, lsb first
+      std::fill(m_codewordWords.begin(), m_codewordWords.end(), 0);
+      for (uint32_t i = 0; i < m_baseMatrix.n; i++) {
+        m_codewordWords[i / 64] |= ((uint64_t) (m_posterior[i] < 0.0f)) << (i % 64);
+      }
+
+      for (uint16_t r = 0; r < m_baseMatrix.rows; r++) {
+        ZBlock syndrome = {{0, 0}};
+        for (uint16_t e = m_layerStart[r]; e < m_layerStart[r + 1]; e++) {
+          xorBlock(syndrome, rotate(loadBlock(m_codewordWords, m_edgeCol[e] * z, z), m_edgeShift[e], z));
+        }
+        if (syndrome.w[0] != 0 || syndrome.w[1] != 0) {
+          return false;
+        }
+      }
+      return true;
     }
 
   } /* namespace sdr */
@@ -0,0 +1,256 @@
+/*!
+ * @file QCLDPCFixedPoint.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details A fixed-point layered min-sum decoder for the IEEE 802.11n QC-LDPC
+ * codes.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cmath>
+#include <cstring>
+
+#include "QCLDPCFixedPoint.hpp"
+#include "FEC.hpp"
+
+namespace ex2 {
+  namespace sdr {
+
+    const uint16_t QCLDPCFixedPoint::MAX_N;
+    const uint16_t QCLDPCFixedPoint::MAX_Z;
+    const uint16_t QCLDPCFixedPoint::MAX_EDGES;
+    const uint16_t QCLDPCFixedPoint::MAX_ROW_DEGREE;
+    const uint16_t QCLDPCFixedPoint::MAX_BLOCK_ROWS;
+    const int8_t QCLDPCFixedPoint::MAX_LLR;
+
+    namespace {
+      inline int16_t saturate16(int32_t x)
+      {
+        return (int16_t) ((x > INT16_MAX) ? INT16_MAX : ((x < -INT16_MAX) ? -INT16_MAX : x));
+      }
+    } /* anonymous namespace */
+
+    QCLDPCFixedPoint::QCLDPCFixedPoint(const QCLDPCBaseMatrix& baseMatrix, uint32_t messageLenBits,
+      uint32_t maxIterations)
+    : m_baseMatrix(baseMatrix), m_messageLenBits(messageLenBits), m_maxIterations(maxIterations),
+      m_normalization(12), m_offset(0), m_lastIterations(0), m_lastConverged(false)
+    {
+      if (m_baseMatrix.n > MAX_N || m_baseMatrix.z > MAX_Z || m_baseMatrix.rows > MAX_BLOCK_ROWS) {
+        throw FECException("QCLDPCFixedPoint code too large");
+      }
+
+      // Collect the non-zero circulants of each layer
+      uint16_t edges = 0;
+      for (uint16_t r = 0; r < m_baseMatrix.rows; r++) {
+        m_layerStart[r] = edges;
+        for (uint16_t c = 0; c < QCLDPCBaseMatrix::BLOCK_COLS; c++) {
+          int8_t h = m_baseMatrix.shift(r, c);
+          if (h >= 0) {
+            if (edges == MAX_EDGES || edges - m_layerStart[r] == MAX_ROW_DEGREE) {
+              throw FECException("QCLDPCFixedPoint code too large");
+            }
+            m_edgeCol[edges] = c;
+            m_edgeShift[edges] = h;
+            edges++;
+          }
+        }
+      }
+      m_layerStart[m_baseMatrix.rows] = edges;
+    }
+
+    int8_t
+    QCLDPCFixedPoint::quantize(float llr, float scale)
+    {
+      float q = std::round(llr * scale);
+      if (q > MAX_LLR) {
+        return MAX_LLR;
+      }
+      if (q < -MAX_LLR) {
+        return -MAX_LLR;
+      }
+      return (int8_t) q;
+    }
+
+    void
+    QCLDPCFixedPoint::setNormalization(float factor)
+    {
+      float n = std::round(factor * 16.0f);
+      m_normalization = (uint8_t) ((n < 0.0f) ? 0 : ((n > 16.0f) ? 16 : n));
+      m_offset = 0;
+    }
+
+    void
+    QCLDPCFixedPoint::setOffset(uint8_t offset)
+    {
+      m_normalization = 16;
+      m_offset = offset;
+    }
+
+    uint32_t
+    QCLDPCFixedPoint::decode(const int8_t *llrs, uint8_t *payload)
+    {
+      std::memcpy(m_channel, llrs, m_baseMatrix.n);
+      return m_decode(payload, (m_messageLenBits / 8) * 8);
+    }
+
+    uint32_t
+    QCLDPCFixedPoint::decode(const float *llrs, float scale, uint8_t *payload)
+    {
+      for (uint16_t i = 0; i < m_baseMatrix.n; i++) {
+        m_channel[i] = quantize(llrs[i], scale);
+      }
+      return m_decode(payload, (m_messageLenBits / 8) * 8);
+    }
+
+    uint32_t
+    QCLDPCFixedPoint::decodeMessage(const float *llrs, float scale, uint8_t *message)
+    {
+      for (uint16_t i = 0; i < m_baseMatrix.n; i++) {
+        m_channel[i] = quantize(llrs[i], scale);
+      }
+      return m_decode(message, m_messageLenBits);
+    }
+
+    uint32_t
+    QCLDPCFixedPoint::decodeHard(const uint8_t *codeword, int8_t llrMagnitude, uint8_t *payload)
+    {
+      for (uint16_t i = 0; i < m_baseMatrix.n; i++) {
+        m_channel[i] = ((codeword[i / 8] >> (7 - (i % 8))) & 0x01) ? -llrMagnitude : llrMagnitude;
+      }
+      return m_decode(payload, (m_messageLenBits / 8) * 8);
+    }
+
+    uint32_t
+    QCLDPCFixedPoint::m_decode(uint8_t *out, uint32_t outBits)
+    {
+      const uint16_t n = m_baseMatrix.n;
+
+      for (uint16_t i = 0; i < n; i++) {
+        m_posterior[i] = m_channel[i];
+      }
+      // The message bits beyond those wanted are known to be zero
+      for (uint32_t i = outBits; i < m_messageLenBits; i++) {
+        m_posterior[i] = INT16_MAX;
+      }
+      std::memset(m_checkMessages, 0, sizeof(m_checkMessages));
+
+      m_lastIterations = 0;
+      m_lastConverged = m_syndromeIsZero();
+      while (!m_lastConverged && m_lastIterations < m_maxIterations) {
+        for (uint16_t r = 0; r < m_baseMatrix.rows; r++) {
+          m_updateLayer(r);
+        }
+        m_lastIterations++;
+        m_lastConverged = m_syndromeIsZero();
+      }
+
+      // Count the corrected hard decisions and extract the payload
+      uint32_t corrected = 0;
+      for (uint16_t i = 0; i < n; i++) {
+        corrected += ((m_channel[i] < 0) != (m_posterior[i] < 0));
+      }
+      std::memset(out, 0, (outBits + 7) / 8);
+      for (uint32_t i = 0; i < outBits; i++) {
+        if (m_posterior[i] < 0) {
+          out[i / 8] |= 0x80 >> (i % 8);
+        }
+      }
+
+      return corrected;
+    }
+
+    void
+    QCLDPCFixedPoint::m_updateLayer(uint16_t layer)
+    {
+      const uint8_t z = m_baseMatrix.z;
+      const uint16_t first = m_layerStart[layer];
+      const uint16_t degree = m_layerStart[layer + 1] - first;
+
+      uint8_t min1[MAX_Z];
+      uint8_t min2[MAX_Z];
+      uint8_t minIndex[MAX_Z];
+      uint8_t signs[MAX_Z];
+      std::memset(min1, MAX_LLR, z);
+      std::memset(min2, MAX_LLR, z);
+      std::memset(minIndex, 0, z);
+      std::memset(signs, 0, z);
+
+      // Variable to check messages; row i of P^h connects to variable
+      // (i + h) mod z
+      for (uint16_t k = 0; k < degree; k++) {
+        const int16_t *v = &m_posterior[m_edgeCol[first + k] * z];
+        const int8_t *rk = &m_checkMessages[(first + k) * z];
+        int16_t *q = &m_layerPosterior[k * z];
+        uint16_t j = m_edgeShift[first + k];
+        for (uint16_t i = 0; i < z; i++) {
+          q[i] = saturate16((int32_t) v[j] - rk[i]);
+          uint8_t a = (uint8_t) ((q[i] > MAX_LLR || q[i] < -MAX_LLR) ? MAX_LLR : (q[i] < 0 ? -q[i] : q[i]));
+          if (a < min1[i]) {
+            min2[i] = min1[i];
+            min1[i] = a;
+            minIndex[i] = k;
+          }
+          else if (a < min2[i]) {
+            min2[i] = a;
+          }
+          signs[i] ^= (q[i] < 0);
+          if (++j == z) {
+            j = 0;
+          }
+        }
+      }
+
+      for (uint16_t i = 0; i < z; i++) {
+        int16_t m = ((min1[i] * m_normalization + 8) >> 4) - m_offset;
+        min1[i] = (m > 0) ? m : 0;
+        m = ((min2[i] * m_normalization + 8) >> 4) - m_offset;
+        min2[i] = (m > 0) ? m : 0;
+      }
+
+      // New check to variable messages and posteriors
+      for (uint16_t k = 0; k < degree; k++) {
+        int16_t *v = &m_posterior[m_edgeCol[first + k] * z];
+        int8_t *rk = &m_checkMessages[(first + k) * z];
+        const int16_t *q = &m_layerPosterior[k * z];
+        uint16_t j = m_edgeShift[first + k];
+        for (uint16_t i = 0; i < z; i++) {
+          int8_t magnitude = (minIndex[i] == k) ? min2[i] : min1[i];
+          int8_t r = (signs[i] ^ (q[i] < 0)) ? -magnitude : magnitude;
+          rk[i] = r;
+          v[j] = saturate16((int32_t) q[i] + r);
+          if (++j == z) {
+            j = 0;
+          }
+        }
+      }
+    }
+
+    bool
+    QCLDPCFixedPoint::m_syndromeIsZero() const
+    {
+      const uint8_t z = m_baseMatrix.z;
+      for (uint16_t r = 0; r < m_baseMatrix.rows; r++) {
+        for (uint16_t i = 0; i < z; i++) {
+          uint8_t parity = 0;
+          for (uint16_t e = m_layerStart[r]; e < m_layerStart[r + 1]; e++) {
+            uint16_t j = i + m_edgeShift[e];
+            if (j >= z) {
+              j -= z;
+            }
+            parity ^= (m_posterior[m_edgeCol[e] * z + j] < 0);
+          }
+          if (parity) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+  } /* namespace sdr */
+} /* namespace ex2 */
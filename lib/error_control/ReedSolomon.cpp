@@ -0,0 +1,461 @@
+/*!
+ * @file ReedSolomon.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details The "ReedSolomon" scheme extends the FEC base class to implement
+ * the CCSDS_REED_SOLOMON_xxx forward error correction.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cstring>
+
+#include "ReedSolomon.hpp"
+#include "cpuFeatures.hpp"
+#include "mpdu.hpp"
+
+#if EX2_SDR_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace ex2 {
+  namespace sdr {
+
+    namespace {
+
+      // x^8 + x^7 + x^2 + x + 1
+      const uint16_t FIELD_GENERATOR = 0x187;
+
+      // Code generator roots are alpha^(ROOT_STEP j)
+      const uint16_t ROOT_STEP = 11;
+
+      // All roots of both codes, j = 112..143, have syndrome tables
+      const uint16_t FIRST_TABLE_ROOT = 112;
+      const uint16_t TABLE_ROOTS = 32;
+
+      // Marks a zero in log form
+      const uint8_t LOG_ZERO = 255;
+
+      struct GaloisField {
+        uint8_t exp[2 * 255];   // doubled so sums of two logs need no modulo
+        uint8_t log[256];
+        uint8_t toDual[256];    // conventional to dual basis
+        uint8_t fromDual[256];  // dual basis to conventional
+
+        // Per root: log of the root, and low and high nibble product tables
+        // for multiplying by the root to the 16th and 32nd powers
+        uint8_t rootLog[TABLE_ROOTS];
+        uint8_t mul16[TABLE_ROOTS][32];
+        uint8_t mul32[TABLE_ROOTS][32];
+      };
+
+      inline uint8_t gfMul(const GaloisField& gf, uint8_t a, uint8_t b)
+      {
+        return (a == 0 || b == 0) ? 0 : gf.exp[gf.log[a] + gf.log[b]];
+      }
+
+      const GaloisField& galoisField()
+      {
+        static const GaloisField gf = []() {
+          GaloisField f;
+          uint16_t x = 1;
+          for (uint16_t i = 0; i < 255; i++) {
+            f.exp[i] = f.exp[i + 255] = (uint8_t) x;
+            f.log[x] = (uint8_t) i;
+            x <<= 1;
+            if (x & 0x100) {
+              x ^= FIELD_GENERATOR;
+            }
+          }
+          f.log[0] = LOG_ZERO;
+
+          // CCSDS 131.0-B Annex F; row k of T_al is applied for bit 7 - k
+          static const uint8_t tal[8] = { 0x8d, 0xef, 0xec, 0x86, 0xfa, 0x99, 0xaf, 0x7b };
+          for (uint16_t i = 0; i < 256; i++) {
+            uint8_t d = 0;
+            for (uint16_t k = 0; k < 8; k++) {
+              if (i & (1 << k)) {
+                d ^= tal[7 - k];
+              }
+            }
+            f.toDual[i] = d;
+            f.fromDual[d] = (uint8_t) i;
+          }
+
+          for (uint16_t r = 0; r < TABLE_ROOTS; r++) {
+            f.rootLog[r] = (ROOT_STEP * (FIRST_TABLE_ROOT + r)) % 255;
+            uint8_t b16 = f.exp[(16 * f.rootLog[r]) % 255];
+            uint8_t b32 = f.exp[(32 * f.rootLog[r]) % 255];
+            for (uint16_t n = 0; n < 16; n++) {
+              f.mul16[r][n] = gfMul(f, (uint8_t) n, b16);
+              f.mul16[r][16 + n] = gfMul(f, (uint8_t) (n << 4), b16);
+              f.mul32[r][n] = gfMul(f, (uint8_t) n, b32);
+              f.mul32[r][16 + n] = gfMul(f, (uint8_t) (n << 4), b32);
+            }
+          }
+          return f;
+        }();
+        return gf;
+      }
+
+      // Syndromes of a codeword for roots firstRoot to firstRoot + count - 1,
+      // relative to FIRST_TABLE_ROOT. The codeword is 256 symbols, a leading
+      // zero then the N codeword symbols, highest degree first. All
+      // implementations give identical results.
+      typedef void (*SyndromeFn)(const uint8_t *codeword, uint16_t firstRoot, uint16_t count,
+        uint8_t *syndromes);
+
+      void syndromesScalar(const uint8_t *codeword, uint16_t firstRoot, uint16_t count,
+        uint8_t *syndromes)
+      {
+        const GaloisField& gf = galoisField();
+        for (uint16_t r = 0; r < count; r++) {
+          const uint8_t rootLog = gf.rootLog[firstRoot + r];
+          uint8_t s = 0;
+          for (uint16_t j = 0; j < 256; j++) {
+            s = ((s == 0) ? 0 : gf.exp[gf.log[s] + rootLog]) ^ codeword[j];
+          }
+          syndromes[r] = s;
+        }
+      } // syndromesScalar
+
+      // The SIMD kernels run Horner's rule with a stride of L lanes: lane t
+      // accumulates P_t = sum over m of c(L m + t) b^(L (M - 1 - m)), which
+      // only needs multiplies by the constant b^L, done with nibble table
+      // lookups. Then S = sum over t of P_t b^(L - 1 - t).
+      inline uint8_t combineLanes(const GaloisField& gf, const uint8_t *lanes, uint16_t L,
+        uint8_t rootLog)
+      {
+        uint8_t s = 0;
+        for (uint16_t t = 0; t < L; t++) {
+          s = ((s == 0) ? 0 : gf.exp[gf.log[s] + rootLog]) ^ lanes[t];
+        }
+        return s;
+      }
+
+#if EX2_SDR_X86_KERNELS
+      __attribute__((target("ssse3")))
+      void syndromesSSSE3(const uint8_t *codeword, uint16_t firstRoot, uint16_t count,
+        uint8_t *syndromes)
+      {
+        const GaloisField& gf = galoisField();
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        alignas(16) uint8_t lanes[16];
+        for (uint16_t r = 0; r < count; r++) {
+          const __m128i lo = _mm_loadu_si128((const __m128i *) &gf.mul16[firstRoot + r][0]);
+          const __m128i hi = _mm_loadu_si128((const __m128i *) &gf.mul16[firstRoot + r][16]);
+          __m128i p = _mm_setzero_si128();
+          for (uint16_t j = 0; j < 256; j += 16) {
+            __m128i pl = _mm_shuffle_epi8(lo, _mm_and_si128(p, nibble));
+            __m128i ph = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(p, 4), nibble));
+            p = _mm_xor_si128(_mm_xor_si128(pl, ph), _mm_loadu_si128((const __m128i *) &codeword[j]));
+          }
+          _mm_store_si128((__m128i *) lanes, p);
+          syndromes[r] = combineLanes(gf, lanes, 16, gf.rootLog[firstRoot + r]);
+        }
+      } // syndromesSSSE3
+
+      __attribute__((target("avx2")))
+      void syndromesAVX2(const uint8_t *codeword, uint16_t firstRoot, uint16_t count,
+        uint8_t *syndromes)
+      {
+        const GaloisField& gf = galoisField();
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        alignas(32) uint8_t lanes[32];
+        for (uint16_t r = 0; r < count; r++) {
+          const __m256i lo = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128((const __m128i *) &gf.mul32[firstRoot + r][0]));
+          const __m256i hi = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128((const __m128i *) &gf.mul32[firstRoot + r][16]));
+          __m256i p = _mm256_setzero_si256();
+          for (uint16_t j = 0; j < 256; j += 32) {
+            __m256i pl = _mm256_shuffle_epi8(lo, _mm256_and_si256(p, nibble));
+            __m256i ph = _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi16(p, 4), nibble));
+            p = _mm256_xor_si256(_mm256_xor_si256(pl, ph),
+              _mm256_loadu_si256((const __m256i *) &codeword[j]));
+          }
+          _mm256_store_si256((__m256i *) lanes, p);
+          syndromes[r] = combineLanes(gf, lanes, 32, gf.rootLog[firstRoot + r]);
+        }
+      } // syndromesAVX2
+#endif
+
+      const DispatchedKernel<SyndromeFn> syndromeKernel({
+#if EX2_SDR_X86_KERNELS
+        { "avx2", CPUFeatures::AVX2, syndromesAVX2 },
+        { "ssse3", CPUFeatures::SSSE3, syndromesSSSE3 },
+#endif
+        { "scalar", CPUFeatures::NONE, syndromesScalar }
+      });
+
+    } /* anonymous namespace */
+
+    const uint16_t ReedSolomon::N;
+    const uint16_t ReedSolomon::MAX_PARITY;
+
+    ReedSolomon::ReedSolomon(ErrorCorrection::ErrorCorrectionScheme ecScheme) : FEC(ecScheme) {
+      m_errorCorrection = new ErrorCorrection(ecScheme, (MPDU::maxMTU() * 8));
+
+      switch (ecScheme) {
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_1:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_2:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_3:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_4:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_5:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_8:
+          m_parityLen = 16;
+          break;
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_1:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_2:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_3:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_4:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_5:
+        case ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_8:
+          m_parityLen = 32;
+          break;
+        default:
+          throw FECException("ReedSolomon scheme is not a CCSDS Reed-Solomon code");
+      }
+      m_messageLen = N - m_parityLen;
+      m_interleavingDepth = m_errorCorrection->getMessageLen() / 8 / m_messageLen;
+      m_firstRoot = 128 - m_parityLen / 2;
+
+      // g(x) = product over the roots of (x - alpha^(11 j)), built up in
+      // polynomial form, highest degree first
+      const GaloisField& gf = galoisField();
+      uint8_t g[MAX_PARITY + 1] = { 1 };
+      for (uint16_t i = 0; i < m_parityLen; i++) {
+        uint8_t root = gf.exp[(ROOT_STEP * (m_firstRoot + i)) % 255];
+        for (uint16_t j = i + 1; j > 0; j--) {
+          g[j] ^= gfMul(gf, g[j - 1], root);
+        }
+      }
+      for (uint16_t j = 0; j <= m_parityLen; j++) {
+        m_generator[j] = gf.log[g[j]];
+      }
+    }
+
+    ReedSolomon::~ReedSolomon() {
+      if (m_errorCorrection != NULL) {
+        delete m_errorCorrection;
+      }
+    }
+
+    const char *
+    ReedSolomon::syndromeKernelName() {
+      return syndromeKernel.name();
+    }
+
+    void
+    ReedSolomon::m_encodeCodeword(const uint8_t *message, uint8_t *parity) const {
+      // The remainder of m(x) x^(2E) divided by g(x), by LFSR
+      const GaloisField& gf = galoisField();
+      std::memset(parity, 0, m_parityLen);
+      for (uint16_t i = 0; i < m_messageLen; i++) {
+        uint8_t feedback = gf.log[message[i] ^ parity[0]];
+        for (uint16_t j = 0; j + 1 < m_parityLen; j++) {
+          parity[j] = parity[j + 1];
+          if (feedback != LOG_ZERO && m_generator[j + 1] != LOG_ZERO) {
+            parity[j] ^= gf.exp[feedback + m_generator[j + 1]];
+          }
+        }
+        parity[m_parityLen - 1] = (feedback != LOG_ZERO && m_generator[m_parityLen] != LOG_ZERO) ?
+          gf.exp[feedback + m_generator[m_parityLen]] : 0;
+      }
+    }
+
+    std::vector<uint8_t>
+    ReedSolomon::encode(const std::vector<uint8_t>& payload) {
+      if (payload.size() != m_errorCorrection->getMessageLen() / 8)
+        throw FECException("ReedSolomon encode payload wrong length");
+
+      const GaloisField& gf = galoisField();
+      const uint16_t depth = m_interleavingDepth;
+      std::vector<uint8_t> codewords(N * depth);
+
+      // The message is sent as is, so only the parity needs interleaving
+      uint8_t message[N];
+      uint8_t parity[MAX_PARITY];
+      std::memcpy(codewords.data(), payload.data(), payload.size());
+      for (uint16_t c = 0; c < depth; c++) {
+        for (uint16_t j = 0; j < m_messageLen; j++) {
+          uint8_t s = payload[j * depth + c];
+          message[j] = m_dualBasis ? gf.fromDual[s] : s;
+        }
+        m_encodeCodeword(message, parity);
+        for (uint16_t j = 0; j < m_parityLen; j++) {
+          codewords[(m_messageLen + j) * depth + c] = m_dualBasis ? gf.toDual[parity[j]] : parity[j];
+        }
+      }
+      return codewords;
+    }
+
+    void
+    ReedSolomon::syndromes(const uint8_t *codeword, uint8_t *syndromes) const {
+      alignas(32) uint8_t padded[256];
+      padded[0] = 0;
+      std::memcpy(&padded[1], codeword, N);
+      syndromeKernel.get()(padded, m_firstRoot - FIRST_TABLE_ROOT, m_parityLen, syndromes);
+    }
+
+    int16_t
+    ReedSolomon::m_decodeCodeword(uint8_t *codeword) const {
+      const GaloisField& gf = galoisField();
+      const uint16_t twoT = m_parityLen;
+
+      uint8_t s[MAX_PARITY];
+      syndromes(codeword, s);
+      bool clean = true;
+      for (uint16_t i = 0; i < twoT; i++) {
+        clean = clean && (s[i] == 0);
+      }
+      if (clean) {
+        return 0;
+      }
+
+      // Berlekamp-Massey for the error locator lambda(x), lowest degree first
+      uint8_t lambda[MAX_PARITY + 1] = { 1 };
+      uint8_t b[MAX_PARITY + 1] = { 1 };
+      uint8_t t[MAX_PARITY + 1];
+      uint16_t L = 0;
+      uint16_t m = 1;
+      uint8_t bDiscrepancy = 1;
+      for (uint16_t r = 0; r < twoT; r++) {
+        uint8_t d = s[r];
+        for (uint16_t i = 1; i <= L; i++) {
+          d ^= gfMul(gf, lambda[i], s[r - i]);
+        }
+        if (d == 0) {
+          m++;
+          continue;
+        }
+        // lambda(x) -= d / b x^m B(x)
+        const uint8_t scale = gf.exp[gf.log[d] + 255 - gf.log[bDiscrepancy]];
+        std::memcpy(t, lambda, sizeof(t));
+        for (uint16_t i = 0; i + m <= twoT; i++) {
+          lambda[i + m] ^= gfMul(gf, scale, b[i]);
+        }
+        if (2 * L <= r) {
+          L = r + 1 - L;
+          std::memcpy(b, t, sizeof(b));
+          bDiscrepancy = d;
+          m = 1;
+        }
+        else {
+          m++;
+        }
+      }
+      if (L > twoT / 2) {
+        return -1;
+      }
+
+      // Chien search. The symbol at index j has degree p = N - 1 - j and
+      // locator X = a^p, a = alpha^11; it is in error if lambda(X^-1) = 0
+      uint16_t positions[MAX_PARITY / 2];
+      uint8_t inverseLocators[MAX_PARITY / 2];
+      uint16_t found = 0;
+      for (uint16_t p = 0; p < N; p++) {
+        const uint16_t xInvLog = (255 - (ROOT_STEP * p) % 255) % 255;
+        uint8_t v = 0;
+        for (uint16_t i = 0; i <= L; i++) {
+          if (lambda[i] != 0) {
+            v ^= gf.exp[(gf.log[lambda[i]] + i * xInvLog) % 255];
+          }
+        }
+        if (v == 0) {
+          if (found == L) {
+            return -1;
+          }
+          positions[found] = N - 1 - p;
+          inverseLocators[found] = (uint8_t) xInvLog;
+          found++;
+        }
+      }
+      if (found != L) {
+        return -1;
+      }
+
+      // Forney: omega(x) = S(x) lambda(x) mod x^2t, and the error value is
+      // X^(1 - b) omega(X^-1) / lambda'(X^-1) with b the first root
+      uint8_t omega[MAX_PARITY];
+      for (uint16_t i = 0; i < twoT; i++) {
+        omega[i] = 0;
+        for (uint16_t j = 0; j <= i && j <= L; j++) {
+          omega[i] ^= gfMul(gf, s[i - j], lambda[j]);
+        }
+      }
+      for (uint16_t k = 0; k < found; k++) {
+        const uint16_t xInvLog = inverseLocators[k];
+        uint8_t num = 0;
+        for (uint16_t i = 0; i < twoT; i++) {
+          if (omega[i] != 0) {
+            num ^= gf.exp[(gf.log[omega[i]] + i * xInvLog) % 255];
+          }
+        }
+        // lambda'(x) has only the odd terms, i lambda_i x^(i-1)
+        uint8_t den = 0;
+        for (uint16_t i = 1; i <= L; i += 2) {
+          if (lambda[i] != 0) {
+            den ^= gf.exp[(gf.log[lambda[i]] + (i - 1) * xInvLog) % 255];
+          }
+        }
+        if (den == 0) {
+          return -1;
+        }
+        if (num != 0) {
+          // X^(1 - b) = (X^-1)^(b - 1)
+          uint32_t e = gf.log[num] + 255 - gf.log[den] + ((m_firstRoot - 1) * xInvLog) % 255;
+          codeword[positions[k]] ^= gf.exp[e % 255];
+        }
+      }
+      return found;
+    }
+
+    uint32_t
+    ReedSolomon::decode(std::vector<uint8_t>& encodedPayload, float snrEstimate,
+      std::vector<uint8_t>& decodedPayload) {
+      (void) snrEstimate;
+
+      decodedPayload.resize(0); // Resize in all FEC decode methods
+
+      const uint16_t depth = m_interleavingDepth;
+      if (encodedPayload.size() != (uint32_t) N * depth) {
+        // make it very obviously fail by returning a huge number of bit errors
+        return UINT32_MAX;
+      }
+
+      const GaloisField& gf = galoisField();
+      uint32_t correctedBits = 0;
+      m_lastUncorrectable = 0;
+      decodedPayload.resize(m_messageLen * depth);
+
+      uint8_t codeword[N];
+      for (uint16_t c = 0; c < depth; c++) {
+        for (uint16_t j = 0; j < N; j++) {
+          uint8_t s = encodedPayload[j * depth + c];
+          codeword[j] = m_dualBasis ? gf.fromDual[s] : s;
+        }
+        if (m_decodeCodeword(codeword) < 0) {
+          m_lastUncorrectable++;
+          for (uint16_t j = 0; j < m_messageLen; j++) {
+            decodedPayload[j * depth + c] = encodedPayload[j * depth + c];
+          }
+          continue;
+        }
+        for (uint16_t j = 0; j < N; j++) {
+          uint8_t s = m_dualBasis ? gf.toDual[codeword[j]] : codeword[j];
+          correctedBits += __builtin_popcount(s ^ encodedPayload[j * depth + c]);
+          if (j < m_messageLen) {
+            decodedPayload[j * depth + c] = s;
+          }
+        }
+      }
+      return correctedBits;
+    }
+
+  } /* namespace sdr */
+} /* namespace ex2 */
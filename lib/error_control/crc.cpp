@@ -1,9 +1,13 @@
 /*!
- * @file .cpp
+ * @file crc.cpp
  * @author Steven Knudsen
  * @date June 18, 2019
  *
- * @details
+ * @details CRC 16 and 32 support.
+ *
+ * Both CRCs are calculated by one engine with a 32 bit register. The 16 bit
+ * CRC is kept in the top half of the register with its polynomial multiplied
+ * by x^16, which gives the same remainder shifted up 16 bits.
  *
  * @copyright AlbertaSat 2021
  *
@@ -13,10 +17,15 @@
 
 #include "crc.hpp"
 
-#include <iostream>
 #include <stdexcept>
 #include <stdio.h>
 
+#include "cpuFeatures.hpp"
+
+#if EX2_SDR_X86_KERNELS
+#include <immintrin.h>
+#endif
+
 //#define CRC_DEBUG 0
 
 namespace ex2
@@ -24,99 +33,302 @@ namespace ex2
   namespace sdr
   {
 
-    crc::crc ()
+    namespace {
+
+      /*
+       * A CRC with a 32 bit register. The polynomial is in normal form without
+       * its x^32 term; a reflected CRC processes bytes lsb first and keeps its
+       * register bit reversed.
+       */
+      struct CRCEngine {
+        uint32_t poly;
+        uint32_t init;
+        uint32_t xorOut;
+        unsigned int width;
+        bool reflected;
+
+        // Slice-by-8 tables; table[k][b] is the register change due to byte
+        // b followed by k zero bytes
+        uint32_t table[8][256];
+
+        // Carry-less multiplication constants to fold 16 bytes across 16 and
+        // 64 bytes, see foldConstants
+        uint64_t fold16[2];
+        uint64_t fold64[2];
+      };
+
+      inline uint32_t load32BE(const uint8_t *p)
+      {
+        return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+      }
+
+      inline uint32_t load32LE(const uint8_t *p)
+      {
+        return ((uint32_t) p[3] << 24) | ((uint32_t) p[2] << 16) | ((uint32_t) p[1] << 8) | p[0];
+      }
+
+      uint64_t reflect64(uint64_t v)
+      {
+        uint64_t r = 0;
+        for (int i = 0; i < 64; i++) {
+          r = (r << 1) | ((v >> i) & 0x01);
+        }
+        return r;
+      }
+
+      // x^n mod (x^32 + poly)
+      uint32_t xPowMod(unsigned int n, uint32_t poly)
+      {
+        uint32_t r = 1;
+        for (unsigned int i = 0; i < n; i++) {
+          r = (r & 0x80000000) ? (r << 1) ^ poly : r << 1;
+        }
+        return r;
+      }
+
+      /*
+       * Folding 16 bytes A(x) x^64 + B(x) forward d bits replaces it with
+       * A(x) (x^(64+d) mod P) + B(x) (x^d mod P), which is at most 96 bits.
+       * The high constant multiplies the high 64 bit lane and the low constant
+       * the low lane.
+       *
+       * A normal CRC loads bytes in reverse so lane bits match the polynomial
+       * degrees. A reflected CRC loads them as they are, so the lanes are bit
+       * reversed and swapped; the constants are reflected and one degree
+       * lower because the reversed product lands one bit too high.
+       */
+      void foldConstants(const CRCEngine &e, unsigned int d, uint64_t k[2])
+      {
+        if (e.reflected) {
+          k[0] = reflect64(xPowMod(64 + d - 1, e.poly));
+          k[1] = reflect64(xPowMod(d - 1, e.poly));
+        }
+        else {
+          k[0] = xPowMod(d, e.poly);
+          k[1] = xPowMod(64 + d, e.poly);
+        }
+      }
+
+      void makeEngine(CRCEngine &e)
+      {
+        uint32_t rPoly = (uint32_t) (reflect64(e.poly) >> 32);
+        for (unsigned int b = 0; b < 256; b++) {
+          uint32_t c;
+          if (e.reflected) {
+            c = b;
+            for (int i = 0; i < 8; i++) {
+              c = (c & 0x01) ? (c >> 1) ^ rPoly : c >> 1;
+            }
+          }
+          else {
+            c = b << 24;
+            for (int i = 0; i < 8; i++) {
+              c = (c & 0x80000000) ? (c << 1) ^ e.poly : c << 1;
+            }
+          }
+          e.table[0][b] = c;
+        }
+        for (unsigned int k = 1; k < 8; k++) {
+          for (unsigned int b = 0; b < 256; b++) {
+            uint32_t c = e.table[k - 1][b];
+            e.table[k][b] = e.reflected ? (c >> 8) ^ e.table[0][c & 0xFF] : (c << 8) ^ e.table[0][c >> 24];
+          }
+        }
+        foldConstants(e, 128, e.fold16);
+        foldConstants(e, 512, e.fold64);
+      }
+
+      const CRCEngine &engine(crc::crc_size_t crcSize)
+      {
+        static const CRCEngine *engines = [] {
+          static CRCEngine e[2];
+          // CRC-16/CCITT-FALSE in the top half of the register
+          e[0].poly = 0x1021u << 16;
+          e[0].init = 0xFFFFu << 16;
+          e[0].xorOut = 0;
+          e[0].width = 16;
+          e[0].reflected = false;
+          // CRC-32
+          e[1].poly = 0x04C11DB7u;
+          e[1].init = 0xFFFFFFFFu;
+          e[1].xorOut = 0xFFFFFFFFu;
+          e[1].width = 32;
+          e[1].reflected = true;
+          makeEngine(e[0]);
+          makeEngine(e[1]);
+          return e;
+        }();
+        return engines[crcSize == crc::CRC_16_BITS ? 0 : 1];
+      }
+
+      // The register for a checksum and back
+      inline uint32_t toRegister(const CRCEngine &e, uint32_t checksum)
+      {
+        return (checksum ^ e.xorOut) << (32 - e.width);
+      }
+
+      inline uint32_t toChecksum(const CRCEngine &e, uint32_t reg)
+      {
+        return (reg >> (32 - e.width)) ^ e.xorOut;
+      }
+
+      typedef uint32_t (*CRCKernelFn)(const CRCEngine &e, uint32_t reg, const uint8_t *data, size_t length);
+
+      uint32_t sliceBy8(const CRCEngine &e, uint32_t reg, const uint8_t *data, size_t length)
+      {
+        const uint32_t (*t)[256] = e.table;
+        if (e.reflected) {
+          for (; length >= 8; length -= 8, data += 8) {
+            uint32_t one = load32LE(data) ^ reg;
+            uint32_t two = load32LE(data + 4);
+            reg = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24]
+              ^ t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+          }
+          for (; length > 0; length--) {
+            reg = (reg >> 8) ^ t[0][(reg ^ *data++) & 0xFF];
+          }
+        }
+        else {
+          for (; length >= 8; length -= 8, data += 8) {
+            uint32_t one = load32BE(data) ^ reg;
+            uint32_t two = load32BE(data + 4);
+            reg = t[7][one >> 24] ^ t[6][(one >> 16) & 0xFF] ^ t[5][(one >> 8) & 0xFF] ^ t[4][one & 0xFF]
+              ^ t[3][two >> 24] ^ t[2][(two >> 16) & 0xFF] ^ t[1][(two >> 8) & 0xFF] ^ t[0][two & 0xFF];
+          }
+          for (; length > 0; length--) {
+            reg = (reg << 8) ^ t[0][(reg >> 24) ^ *data++];
+          }
+        }
+        return reg;
+      } // sliceBy8
+
+#if EX2_SDR_X86_KERNELS
+      __attribute__((target("sse2,ssse3,pclmul")))
+      inline __m128i foldPCLMUL(__m128i x, __m128i k)
+      {
+        return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+      }
+
+      __attribute__((target("sse2,ssse3,pclmul")))
+      inline __m128i loadPCLMUL(const uint8_t *p, bool reflected)
+      {
+        const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+        __m128i v = _mm_loadu_si128((const __m128i *) p);
+        return reflected ? v : _mm_shuffle_epi8(v, reverse);
+      }
+
+      // Fold 16 byte blocks, four lanes at a time, into one block whose
+      // checksum is that of all the blocks, then finish with the tables
+      __attribute__((target("sse2,ssse3,pclmul")))
+      uint32_t foldBy4PCLMUL(const CRCEngine &e, uint32_t reg, const uint8_t *data, size_t length)
+      {
+        if (length < 64) {
+          return sliceBy8(e, reg, data, length);
+        }
+
+        const __m128i k16 = _mm_set_epi64x((long long) e.fold16[1], (long long) e.fold16[0]);
+        const __m128i k64 = _mm_set_epi64x((long long) e.fold64[1], (long long) e.fold64[0]);
+        __m128i x[4];
+        for (int i = 0; i < 4; i++) {
+          x[i] = loadPCLMUL(data + 16 * i, e.reflected);
+        }
+        // The register is added to the first bytes of the data
+        x[0] = _mm_xor_si128(x[0], e.reflected ? _mm_cvtsi32_si128((int) reg) : _mm_set_epi32((int) reg, 0, 0, 0));
+        data += 64;
+        length -= 64;
+
+        for (; length >= 64; length -= 64, data += 64) {
+          for (int i = 0; i < 4; i++) {
+            x[i] = _mm_xor_si128(foldPCLMUL(x[i], k64), loadPCLMUL(data + 16 * i, e.reflected));
+          }
+        }
+        __m128i y = x[0];
+        for (int i = 1; i < 4; i++) {
+          y = _mm_xor_si128(foldPCLMUL(y, k16), x[i]);
+        }
+        for (; length >= 16; length -= 16, data += 16) {
+          y = _mm_xor_si128(foldPCLMUL(y, k16), loadPCLMUL(data, e.reflected));
+        }
+
+        uint8_t block[16];
+        _mm_storeu_si128((__m128i *) block, loadPCLMUL((const uint8_t *) &y, e.reflected));
+        reg = sliceBy8(e, 0, block, 16);
+        return sliceBy8(e, reg, data, length);
+      } // foldBy4PCLMUL
+#endif
+
+      const DispatchedKernel<CRCKernelFn> crcKernel({
+#if EX2_SDR_X86_KERNELS
+        { "pclmul", CPUFeatures::SSE2 | CPUFeatures::SSSE3 | CPUFeatures::PCLMUL, foldBy4PCLMUL },
+#endif
+        { "slice-by-8", CPUFeatures::NONE, sliceBy8 } });
+
+    } // namespace
+
+    crc::crc (crc_size_t crcSize) : m_crcSize(crcSize)
     {
+      reset();
     }
 
     crc::~crc ()
     {
     }
 
-    void crc::add(PPDU_u8 &pdu, crc_size_t crcSize)
+    uint32_t
+    crc::initial(crc_size_t crcSize)
     {
-      PPDU_u8::data_ptr_t dPtr = pdu.m_payload.data();
-      uint16_t crc16Syndrome;
-      uint32_t crc32Syndrome;
-      switch(crcSize)
-      {
-        case CRC_16_BITS:
-          m_crc16Impl.reset ();
-          m_crc16Impl.process_bytes(dPtr, pdu.payloadLength());
-          crc16Syndrome = m_crc16Impl.checksum();
-#ifdef CRC_DEBUG
-          printf("crc::add crc16 syndrome   = 0x%x\n",crc16Syndrome);
-#endif
-          pdu.append((const unsigned char *) &crc16Syndrome, sizeof(crc16Syndrome));
-          break;
-        case CRC_32_BITS:
-          m_crc32Impl.reset ();
-          m_crc32Impl.process_bytes(dPtr, pdu.payloadLength());
-          crc32Syndrome = m_crc32Impl.checksum();
+      const CRCEngine &e = engine(crcSize);
+      return toChecksum(e, e.init);
+    }
+
+    uint32_t
+    crc::calculate(crc_size_t crcSize, const uint8_t *data, size_t length, uint32_t checksum)
+    {
+      const CRCEngine &e = engine(crcSize);
+      return toChecksum(e, crcKernel.get()(e, toRegister(e, checksum), data, length));
+    }
+
+    const char *
+    crc::kernelName()
+    {
+      return crcKernel.name();
+    }
+
+    void crc::add(std::vector<uint8_t> &pdu, crc_size_t crcSize)
+    {
+      uint32_t syndrome = calculate(crcSize, pdu.data(), pdu.size());
 #ifdef CRC_DEBUG
-          printf("crc::add crc32 syndrome   = 0x%x\n",crc32Syndrome);
+      printf("crc::add crc%d syndrome   = 0x%x\n", (int) crcSize, syndrome);
 #endif
-          pdu.append((const unsigned char *) &crc32Syndrome, sizeof(crc32Syndrome));
-          break;
-        default:
-          break;
+      for (int shift = crcSize - 8; shift >= 0; shift -= 8) {
+        pdu.push_back((uint8_t) (syndrome >> shift));
       }
     }
 
-    void crc::check(PPDU_u8 &pdu, crc_size_t crcSize)
+    bool
+    crc::valid(const uint8_t *data, size_t length, crc_size_t crcSize)
     {
-      PPDU_u8::data_ptr_t dPtr = pdu.m_payload.data();
-      uint16_t crc16Syndrome;
-      uint32_t crc32Syndrome;
-      int N = pdu.payloadLength();
-      switch(crcSize)
-      {
-        case CRC_16_BITS:
-          m_crc16Impl.reset ();
-          m_crc16Impl.process_bytes(dPtr, N-sizeof(crc16Syndrome));
-          crc16Syndrome = m_crc16Impl.checksum();
-#ifdef CRC_DEBUG
-          printf("crc::check crc16 syndrome = 0x%x\n",crc16Syndrome);
-#endif
-          dataSyndrome16_t ds16;
-          ds16.lastBytes[1] = dPtr[N-1];
-          ds16.lastBytes[0] = dPtr[N-2];
-#ifdef CRC_DEBUG
-          printf("crc::check data syndrome  = 0x%x\n",ds16.syndrome16);
-#endif
-          if (crc16Syndrome == ds16.syndrome16)
-          {
-            pdu.m_payload.pop_back();
-            pdu.m_payload.pop_back();
-          } else
-            throw std::runtime_error("CRC16 check failed.");
-          break;
-        case CRC_32_BITS:
-          m_crc32Impl.reset ();
-          m_crc32Impl.process_bytes(dPtr, N-sizeof(crc32Syndrome));
-          crc32Syndrome = m_crc32Impl.checksum();
-#ifdef CRC_DEBUG
-          printf("crc::check crc32 syndrome = 0x%x\n",crc32Syndrome);
-#endif
-          dataSyndrome32_t ds32;
-          ds32.lastBytes[3] = dPtr[N-1];
-          ds32.lastBytes[2] = dPtr[N-2];
-          ds32.lastBytes[1] = dPtr[N-3];
-          ds32.lastBytes[0] = dPtr[N-4];
+      size_t syndromeLength = crcSize / 8;
+      if (length < syndromeLength) {
+        return false;
+      }
+      uint32_t syndrome = calculate(crcSize, data, length - syndromeLength);
+      uint32_t dataSyndrome = 0;
+      for (size_t i = length - syndromeLength; i < length; i++) {
+        dataSyndrome = (dataSyndrome << 8) | data[i];
+      }
 #ifdef CRC_DEBUG
-          printf("crc::check data syndrome  = 0x%x\n",ds32.syndrome32);
+      printf("crc::valid syndrome = 0x%x data syndrome = 0x%x\n", syndrome, dataSyndrome);
 #endif
-          if (crc32Syndrome == ds32.syndrome32)
-          {
-            pdu.m_payload.pop_back();
-            pdu.m_payload.pop_back();
-            pdu.m_payload.pop_back();
-            pdu.m_payload.pop_back();
-          } else
-            throw std::runtime_error("CRC16 check failed.");
-          break;
-        default:
-          break;
+      return syndrome == dataSyndrome;
+    }
+
+    void crc::check(std::vector<uint8_t> &pdu, crc_size_t crcSize)
+    {
+      if (!valid(pdu.data(), pdu.size(), crcSize)) {
+        throw std::runtime_error(crcSize == CRC_16_BITS ? "CRC16 check failed." : "CRC32 check failed.");
       }
+      pdu.resize(pdu.size() - crcSize / 8);
     }
 
   } /* namespace sdr */
@@ -251,6 +251,9 @@ namespace ex2 {
         case ErrorCorrectionScheme::NO_FEC:
           return std::string("No FEC");
 //          break;
+        case ErrorCorrectionScheme::CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2:
+          return std::string("CCSDS Reed-Solomon (255,223) interleaving level 4 + Convolutional Coding rate 1/2");
+//          break;
 
         default:
           throw ECException("Invalid Error Correction Coding value.");
@@ -274,6 +277,7 @@ namespace ex2 {
         case ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_7_8:
           isValid = true;
           break;
+        // CCSDS Reed-Solomon is supported.
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_1:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_2:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_3:
@@ -286,6 +290,9 @@ namespace ex2 {
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_4:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_5:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_8:
+          isValid = true;
+          break;
+          // CCSDS Turbo is supported
         case ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_2:
         case ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_3:
         case ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_4:
@@ -302,9 +309,13 @@ namespace ex2 {
         case ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_3:
         case ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_4:
         case ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_6:
+          isValid = true;
+          break;
+          // CCSDS AR4JA LDPC is valid
         case ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_1280:
         case ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_1536:
         case ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_2048:
+          isValid = true;
           break;
           // IEEE QCLPDC is valid
         case ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_648_R_1_2:
@@ -325,6 +336,10 @@ namespace ex2 {
         case ErrorCorrectionScheme::NO_FEC:
           isValid = true;
           break;
+          // CCSDS concatenated coding is supported
+        case ErrorCorrectionScheme::CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2:
+          isValid = true;
+          break;
         default:
           throw ECException("Invalid Error Correction Coding value.");
 //          break;
@@ -390,25 +405,36 @@ namespace ex2 {
       uint32_t codewordLen = 0; // @TODO this may cause trouble, but is fine for now
       // @TODO This is so ugly
       switch(m_errorCorrectionScheme) {
+        // Each encode makes one codeword per level of interleaving
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_1:
-        case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_2:
-        case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_3:
-        case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_4:
-        case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_5:
-        case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_8:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_1:
+          codewordLen = 255*8; // bits
+          break;
+        case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_2:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_2:
+          codewordLen = 255*8*2; // bits
+          break;
+        case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_3:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_3:
+          codewordLen = 255*8*3; // bits
+          break;
+        case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_4:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_4:
+          codewordLen = 255*8*4; // bits
+          break;
+        case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_5:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_5:
+          codewordLen = 255*8*5; // bits
+          break;
+        case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_8:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_8:
-          codewordLen = 255*8; // bits
+          codewordLen = 255*8*8; // bits
           break;
         case ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_2:
           codewordLen = 3576; // bits
           break;
         case ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_3:
-          codewordLen = 5364; // bits
+          codewordLen = 5368; // bits, 5364 zero-padded to whole bytes
           break;
         case ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_4:
           codewordLen = 7152; // bits
@@ -420,7 +446,7 @@ namespace ex2 {
           codewordLen = 7144; // bits
           break;
         case ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_3:
-          codewordLen = 10716; // bits
+          codewordLen = 10720; // bits, 10716 zero-padded to whole bytes
           break;
         case ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_4:
           codewordLen = 14288; // bits
@@ -432,7 +458,7 @@ namespace ex2 {
           codewordLen = 14280; // bits
           break;
         case ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_3:
-          codewordLen = 21420; // bits
+          codewordLen = 21424; // bits, 21420 zero-padded to whole bytes
           break;
         case ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_4:
           codewordLen = 28560; // bits
@@ -444,7 +470,7 @@ namespace ex2 {
           codewordLen = 17848; // bits
           break;
         case ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_3:
-          codewordLen = 26772; // bits
+          codewordLen = 26776; // bits, 26772 zero-padded to whole bytes
           break;
         case ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_4:
           codewordLen = 35696; // bits
@@ -490,33 +516,38 @@ namespace ex2 {
           codewordLen = msgLen * 2;
         }
         break;
-        case ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_2_3: // @todo not confirmed/tested!
+          // The punctured rates transmit ceil(msgLen / r) bits, which is then
+          // zero-padded to a whole number of bytes; see ConvolutionalCodecHD
+        case ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_2_3:
         {
           uint32_t msgLen = m_continuousMaxCodewordLen * 2 / 3;
           msgLen -= (msgLen % 8);
-          codewordLen = msgLen * 3 / 2;
-          codewordLen += (codewordLen % 8);
+          codewordLen = (msgLen * 3 + 1) / 2;
+          codewordLen += (8 - codewordLen % 8) % 8;
         }
         break;
-        case ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_3_4: // @todo not confirmed/tested!
+        case ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_3_4:
         {
           uint32_t msgLen = m_continuousMaxCodewordLen * 3 / 4;
           msgLen -= (msgLen % 8);
-          codewordLen = msgLen * 4 / 3;
+          codewordLen = (msgLen * 4 + 2) / 3;
+          codewordLen += (8 - codewordLen % 8) % 8;
         }
         break;
-        case ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_5_6: // @todo not confirmed/tested!
+        case ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_5_6:
         {
           uint32_t msgLen = m_continuousMaxCodewordLen * 5 / 6;
           msgLen -= (msgLen % 8);
-          codewordLen = msgLen * 6 / 5;
+          codewordLen = (msgLen * 6 + 4) / 5;
+          codewordLen += (8 - codewordLen % 8) % 8;
         }
         break;
-        case ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_7_8: // @todo not confirmed/tested!
+        case ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_7_8:
         {
           uint32_t msgLen = m_continuousMaxCodewordLen * 7 / 8;
           msgLen -= (msgLen % 8);
-          codewordLen = msgLen * 8 / 7;
+          codewordLen = (msgLen * 8 + 6) / 7;
+          codewordLen += (8 - codewordLen % 8) % 8;
         }
         break;
 
@@ -526,6 +557,12 @@ namespace ex2 {
           codewordLen = m_continuousMaxCodewordLen; // bits
           break;
 
+          // Four interleaved RS(255,223) codewords, convolutionally encoded
+          // at rate 1/2
+        case ErrorCorrectionScheme::CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2:
+          codewordLen = 255*8*4*2; // bits
+          break;
+
         default:
           throw ECException("Invalid Error Correction Scheme.");
           //break;
@@ -541,20 +578,40 @@ namespace ex2 {
       // @TODO This is so ugly
       switch(m_errorCorrectionScheme) {
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_1:
+          messageLen = 239*8; // bits
+          break;
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_2:
+          messageLen = 239*8*2; // bits
+          break;
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_3:
+          messageLen = 239*8*3; // bits
+          break;
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_4:
+          messageLen = 239*8*4; // bits
+          break;
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_5:
+          messageLen = 239*8*5; // bits
+          break;
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_8:
-          messageLen = 239*8; // bits
+          messageLen = 239*8*8; // bits
           break;
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_1:
+          messageLen = 223*8; // bits
+          break;
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_2:
+          messageLen = 223*8*2; // bits
+          break;
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_3:
+          messageLen = 223*8*3; // bits
+          break;
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_4:
+          messageLen = 223*8*4; // bits
+          break;
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_5:
+          messageLen = 223*8*5; // bits
+          break;
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_8:
-          messageLen = 223*8; // bits
+          messageLen = 223*8*8; // bits
           break;
         case ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_2:
         case ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_3:
@@ -662,6 +719,10 @@ namespace ex2 {
           messageLen = m_continuousMaxCodewordLen; // bits
           break;
 
+        case ErrorCorrectionScheme::CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2:
+          messageLen = 223*8*4; // bits
+          break;
+
         default:
           throw ECException("Invalid Error Correction Scheme.");
 //          break;
@@ -759,6 +820,7 @@ namespace ex2 {
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_4:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_5:
         case ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_8:
+        case ErrorCorrectionScheme::CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2:
           r = ErrorCorrection::CodingRate::RATE_NA;
           break;
 
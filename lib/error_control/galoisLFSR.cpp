@@ -0,0 +1,130 @@
+/*!
+ * @file galoisLFSR.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details A Galois linear feedback shift register (LFSR) of up to 64 bits.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include "galoisLFSR.h"
+
+#include <stdexcept>
+
+namespace ex2 {
+  namespace sdr {
+
+    namespace {
+
+      // Primitive polynomials, indexed by order - 2
+      const uint64_t primitivePolynomials[] = {
+        0x0000000000000003ULL, // 2: x^2 + x^1 + 1
+        0x0000000000000006ULL, // 3: x^3 + x^2 + 1
+        0x000000000000000CULL, // 4: x^4 + x^3 + 1
+        0x0000000000000014ULL, // 5: x^5 + x^3 + 1
+        0x0000000000000030ULL, // 6: x^6 + x^5 + 1
+        0x0000000000000060ULL, // 7: x^7 + x^6 + 1
+        0x00000000000000B8ULL, // 8: x^8 + x^6 + x^5 + x^4 + 1
+        0x0000000000000110ULL, // 9: x^9 + x^5 + 1
+        0x0000000000000240ULL, // 10: x^10 + x^7 + 1
+        0x0000000000000500ULL, // 11: x^11 + x^9 + 1
+        0x0000000000000829ULL, // 12: x^12 + x^6 + x^4 + x^1 + 1
+        0x000000000000100DULL, // 13: x^13 + x^4 + x^3 + x^1 + 1
+        0x0000000000002015ULL, // 14: x^14 + x^5 + x^3 + x^1 + 1
+        0x0000000000006000ULL, // 15: x^15 + x^14 + 1
+        0x000000000000B400ULL, // 16: x^16 + x^14 + x^13 + x^11 + 1
+        0x0000000000012000ULL, // 17: x^17 + x^14 + 1
+        0x0000000000020400ULL, // 18: x^18 + x^11 + 1
+        0x0000000000040023ULL, // 19: x^19 + x^6 + x^2 + x^1 + 1
+        0x0000000000090000ULL, // 20: x^20 + x^17 + 1
+        0x0000000000140000ULL, // 21: x^21 + x^19 + 1
+        0x0000000000300000ULL, // 22: x^22 + x^21 + 1
+        0x0000000000420000ULL, // 23: x^23 + x^18 + 1
+        0x0000000000E10000ULL, // 24: x^24 + x^23 + x^22 + x^17 + 1
+        0x0000000001200000ULL, // 25: x^25 + x^22 + 1
+        0x0000000002000023ULL, // 26: x^26 + x^6 + x^2 + x^1 + 1
+        0x0000000004000013ULL, // 27: x^27 + x^5 + x^2 + x^1 + 1
+        0x0000000009000000ULL, // 28: x^28 + x^25 + 1
+        0x0000000014000000ULL, // 29: x^29 + x^27 + 1
+        0x0000000020000029ULL, // 30: x^30 + x^6 + x^4 + x^1 + 1
+        0x0000000048000000ULL, // 31: x^31 + x^28 + 1
+        0x0000000080200003ULL, // 32: x^32 + x^22 + x^2 + x^1 + 1
+        0x0000000100080000ULL, // 33: x^33 + x^20 + 1
+        0x0000000204000003ULL, // 34: x^34 + x^27 + x^2 + x^1 + 1
+        0x0000000500000000ULL, // 35: x^35 + x^33 + 1
+        0x0000000801000000ULL, // 36: x^36 + x^25 + 1
+        0x000000100000001FULL, // 37: x^37 + x^5 + x^4 + x^3 + x^2 + x^1 + 1
+        0x0000002000000031ULL, // 38: x^38 + x^6 + x^5 + x^1 + 1
+        0x0000004400000000ULL, // 39: x^39 + x^35 + 1
+        0x000000A000140000ULL, // 40: x^40 + x^38 + x^21 + x^19 + 1
+        0x0000012000000000ULL, // 41: x^41 + x^38 + 1
+        0x00000300000C0000ULL, // 42: x^42 + x^41 + x^20 + x^19 + 1
+        0x0000063000000000ULL, // 43: x^43 + x^42 + x^38 + x^37 + 1
+        0x00000C0000030000ULL, // 44: x^44 + x^43 + x^18 + x^17 + 1
+        0x00001B0000000000ULL, // 45: x^45 + x^44 + x^42 + x^41 + 1
+        0x0000300003000000ULL, // 46: x^46 + x^45 + x^26 + x^25 + 1
+        0x0000420000000000ULL, // 47: x^47 + x^42 + 1
+        0x0000C00000180000ULL, // 48: x^48 + x^47 + x^21 + x^20 + 1
+        0x0001008000000000ULL, // 49: x^49 + x^40 + 1
+        0x0003000000C00000ULL, // 50: x^50 + x^49 + x^24 + x^23 + 1
+        0x0006000C00000000ULL, // 51: x^51 + x^50 + x^36 + x^35 + 1
+        0x0009000000000000ULL, // 52: x^52 + x^49 + 1
+        0x0018003000000000ULL, // 53: x^53 + x^52 + x^38 + x^37 + 1
+        0x0030000000030000ULL, // 54: x^54 + x^53 + x^18 + x^17 + 1
+        0x0040000040000000ULL, // 55: x^55 + x^31 + 1
+        0x00C0000600000000ULL, // 56: x^56 + x^55 + x^35 + x^34 + 1
+        0x0102000000000000ULL, // 57: x^57 + x^50 + 1
+        0x0200004000000000ULL, // 58: x^58 + x^39 + 1
+        0x0600003000000000ULL, // 59: x^59 + x^58 + x^38 + x^37 + 1
+        0x0C00000000000000ULL, // 60: x^60 + x^59 + 1
+        0x1800300000000000ULL, // 61: x^61 + x^60 + x^46 + x^45 + 1
+        0x3000000000000030ULL, // 62: x^62 + x^61 + x^6 + x^5 + 1
+        0x6000000000000000ULL, // 63: x^63 + x^62 + 1
+        0xD800000000000000ULL, // 64: x^64 + x^63 + x^61 + x^60 + 1
+      };
+
+    } // namespace
+
+    uint64_t
+    GaloisLFSR::polynomialForOrder(uint32_t order)
+    {
+      if (order < 2 || order > 64) {
+        throw std::runtime_error("LFSR order must be in the range [2,64].");
+      }
+      return primitivePolynomials[order - 2];
+    }
+
+    GaloisLFSR::GaloisLFSR(uint64_t polynomial, uint64_t initialFill) :
+        m_polynomial(polynomial), m_initialFill(initialFill), m_state(initialFill), m_order(0)
+    {
+      if (polynomial == 0) {
+        throw std::runtime_error("LFSR polynomial must not be zero.");
+      }
+      while (m_order < 64 && (polynomial >> m_order) != 0) {
+        m_order++;
+      }
+      if (initialFill == 0 || (m_order < 64 && (initialFill >> m_order) != 0)) {
+        throw std::runtime_error("LFSR initial fill must be non-zero and fit in the register.");
+      }
+    }
+
+    GaloisLFSR::~GaloisLFSR()
+    {
+    }
+
+    uint8_t
+    GaloisLFSR::nextByte()
+    {
+      uint8_t byte = 0;
+      for (int i = 0; i < 8; i++) {
+        byte = (byte << 1) | nextBit();
+      }
+      return byte;
+    }
+
+  } /* namespace sdr */
+} /* namespace ex2 */
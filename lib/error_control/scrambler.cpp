@@ -0,0 +1,135 @@
+/*!
+ * @file scrambler.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Scramble bits and samples with a maximum length sequence.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include "scrambler.hpp"
+
+#include <cstring>
+
+namespace ex2 {
+  namespace sdr {
+
+    namespace {
+
+      // The float sign bit masks for the eight samples covered by each
+      // sequence byte
+      struct SignMasks {
+        uint32_t masks[256][8];
+
+        constexpr SignMasks() : masks() {
+          for (int b = 0; b < 256; b++) {
+            for (int j = 0; j < 8; j++) {
+              masks[b][j] = ((b >> (7 - j)) & 0x01) ? 0x80000000u : 0;
+            }
+          }
+        }
+      };
+
+      constexpr SignMasks signMasks;
+
+      // Flip the sign of each of count floats whose sequence bit is one;
+      // stride floats share a bit, e.g., 2 for complex samples
+      template <int stride>
+      void
+      flipSigns(const float *original, float *scrambled, size_t count, const uint8_t *sequence)
+      {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+          const uint32_t *masks = signMasks.masks[sequence[i / 8]];
+          uint32_t words[8 * stride];
+          std::memcpy(words, original + i * stride, sizeof(words));
+          for (int j = 0; j < 8 * stride; j++) {
+            words[j] ^= masks[j / stride];
+          }
+          std::memcpy(scrambled + i * stride, words, sizeof(words));
+        }
+        for (; i < count; i++) {
+          uint32_t mask = signMasks.masks[sequence[i / 8]][i % 8];
+          for (int j = 0; j < stride; j++) {
+            uint32_t word;
+            std::memcpy(&word, original + i * stride + j, sizeof(word));
+            word ^= mask;
+            std::memcpy(scrambled + i * stride + j, &word, sizeof(word));
+          }
+        }
+      }
+
+    } // namespace
+
+    Scrambler::Scrambler(uint64_t polynomial, uint64_t initialRegisterFill) :
+        m_lfsr(polynomial, initialRegisterFill)
+    {
+    }
+
+    Scrambler::~Scrambler()
+    {
+    }
+
+    void
+    Scrambler::reserve(size_t length)
+    {
+      // Whole words, so the payload can be scrambled a word at a time
+      size_t bytes = (((length + 7) / 8 + 7) / 8) * 8;
+      if (bytes <= m_sequence.size()) {
+        return;
+      }
+      m_sequence.reserve(bytes);
+      while (m_sequence.size() < bytes) {
+        m_sequence.push_back(m_lfsr.nextByte());
+      }
+    }
+
+    void
+    Scrambler::scramble(const PPDU_u8::payload_t& original,
+        PPDU_u8::payload_t& scrambled)
+    {
+      const size_t length = original.size();
+      reserve(length * 8);
+      scrambled.resize(length);
+
+      const uint8_t *in = original.data();
+      uint8_t *out = scrambled.data();
+      const uint8_t *sequence = m_sequence.data();
+      size_t i = 0;
+      for (; i + 8 <= length; i += 8) {
+        uint64_t data, bits;
+        std::memcpy(&data, in + i, sizeof(data));
+        std::memcpy(&bits, sequence + i, sizeof(bits));
+        data ^= bits;
+        std::memcpy(out + i, &data, sizeof(data));
+      }
+      for (; i < length; i++) {
+        out[i] = in[i] ^ sequence[i];
+      }
+    }
+
+    void
+    Scrambler::scramble(const std::vector<float>& original,
+        std::vector<float>& scrambled)
+    {
+      reserve(original.size());
+      scrambled.resize(original.size());
+      flipSigns<1>(original.data(), scrambled.data(), original.size(), m_sequence.data());
+    }
+
+    void
+    Scrambler::scramble(const std::vector<std::complex<float>>& original,
+        std::vector<std::complex<float>>& scrambled)
+    {
+      reserve(original.size());
+      scrambled.resize(original.size());
+      flipSigns<2>(reinterpret_cast<const float *>(original.data()),
+        reinterpret_cast<float *>(scrambled.data()), original.size(), m_sequence.data());
+    }
+
+  } /* namespace sdr */
+} /* namespace ex2 */
@@ -14,6 +14,7 @@
 #include "mac.hpp"
 #include <cmath>
 
+#include "crc.hpp"
 #include "golay.h"
 #include "mpdu.hpp"
 #include "QCLDPC.hpp"
@@ -74,6 +75,28 @@ namespace ex2 {
       // @todo clear buffers?
       m_codewordBuffer.resize(0);
       m_transparentModePayloads.resize(0);
+
+      m_reserveBuffers();
+    }
+
+    void
+    MAC::m_reserveBuffers() {
+      // The user packet length is bounded by its MPDU header field, so the
+      // number of codewords and MPDUs for a packet are too
+      uint32_t const messageLength = m_errorCorrection->getMessageLen() / 8;
+      uint32_t const cwLen = m_errorCorrection->getCodewordLen() / 8;
+      uint32_t const maxCodewords = (MAC_MAX_USER_PACKET_LENGTH + messageLength - 1) / messageLength;
+      uint32_t const maxMPDUs = MPDU::mpdusInNBytes(MAC_MAX_USER_PACKET_LENGTH, *m_errorCorrection);
+
+      m_codewordBuffer.reserve(maxMPDUs * MPDU::maxMTU());
+      m_transparentModePayloads.reserve(maxMPDUs * MPDU::rawMPDULength());
+      m_message.reserve(messageLength);
+      m_mpduPayload.reserve(MPDU::maxMTU());
+      m_crcPacket.reserve(MAC_MAX_USER_PACKET_LENGTH);
+      m_receivedMPDU.reserve(MPDU::rawMPDULength());
+      m_codeword.reserve(cwLen);
+      m_decodedMessage.reserve(messageLength);
+      m_rawPacket.reserve(maxCodewords * messageLength);
     }
 
     void
@@ -98,10 +121,9 @@ namespace ex2 {
       // Make an MPDU from the @p uhfPayload. This causes the recevied MPDUHeader
       // data to be decoded. If that fails, an exception is thrown and we can
       // short-circuit some processing
-      std::vector<uint8_t> p;
-      p.assign(uhfPayload, uhfPayload+payloadLength);
+      m_receivedMPDU.assign(uhfPayload, uhfPayload+payloadLength);
       try {
-        MPDU mpdu(p);
+        MPDU mpdu(m_receivedMPDU);
 
         // Since we do not use the userPacketFragmentIndex field of the MPDU
         // header (we set to 0 always), we can check it and catch cases where
@@ -154,8 +176,8 @@ namespace ex2 {
 
               // If only one MPDU is expected for this packet, decode the codeword(s) in the buffer
               if (m_mpduCodewordFragmentCount == m_numExpectedMpduCodewordFragments) {
-                m_decodePacket();
-                return MAC_UHFPacketProcessingStatus::PACKET_READY;
+                return m_decodePacket() ? MAC_UHFPacketProcessingStatus::PACKET_READY
+                  : MAC_UHFPacketProcessingStatus::READY_FOR_NEXT_UHF_PACKET;
               }
               // Otherwise there must be more MPDUs to come...
               m_firstFragmentReceived = true;
@@ -201,8 +223,8 @@ namespace ex2 {
 
               // If only one MPDU is expected for this packet, decode the codeword(s) in the buffer
               if (m_mpduCodewordFragmentCount == m_numExpectedMpduCodewordFragments) {
-                m_decodePacket();
-                return MAC_UHFPacketProcessingStatus::PACKET_READY;
+                return m_decodePacket() ? MAC_UHFPacketProcessingStatus::PACKET_READY
+                  : MAC_UHFPacketProcessingStatus::READY_FOR_NEXT_UHF_PACKET;
               }
               // Otherwise there must be more MPDUs to come...
               m_firstFragmentReceived = true;
@@ -243,8 +265,8 @@ namespace ex2 {
               uint32_t numMissingMPDUs = m_numExpectedMpduCodewordFragments - m_mpduCodewordFragmentCount;
               m_codewordBuffer.insert(m_codewordBuffer.end(), numMissingMPDUs * MPDU::maxMTU(), 0);
 
-              m_decodePacket();
-              return MAC_UHFPacketProcessingStatus::PACKET_READY;
+              return m_decodePacket() ? MAC_UHFPacketProcessingStatus::PACKET_READY
+                : MAC_UHFPacketProcessingStatus::READY_FOR_NEXT_UHF_PACKET;
             }
 
           } // MPDU fragement index is not what was expected
@@ -253,8 +275,8 @@ namespace ex2 {
           // @todo refactor to avoid duplicate code
           m_numExpectedMpduCodewordFragments = MPDU::mpdusInNBytes(m_currentPacketLength, *m_errorCorrection);
           if (m_mpduCodewordFragmentCount == m_numExpectedMpduCodewordFragments) {
-            m_decodePacket();
-            return MAC_UHFPacketProcessingStatus::PACKET_READY;
+            return m_decodePacket() ? MAC_UHFPacketProcessingStatus::PACKET_READY
+              : MAC_UHFPacketProcessingStatus::READY_FOR_NEXT_UHF_PACKET;
           } // Have all the MPDUs?
 
         }
@@ -267,8 +289,8 @@ namespace ex2 {
 
             // If only one MPDU is expected for this packet, decode the codeword(s) in the buffer
             if (m_mpduCodewordFragmentCount == m_numExpectedMpduCodewordFragments) {
-              m_decodePacket();
-              return MAC_UHFPacketProcessingStatus::PACKET_READY;
+              return m_decodePacket() ? MAC_UHFPacketProcessingStatus::PACKET_READY
+                : MAC_UHFPacketProcessingStatus::READY_FOR_NEXT_UHF_PACKET;
             }
             // Otherwise there must be more MPDUs to come...
             m_firstFragmentReceived = true;
@@ -310,8 +332,8 @@ namespace ex2 {
             uint32_t numMissingMPDUs = m_numExpectedMpduCodewordFragments - (m_mpduCodewordFragmentCount - 1);
             m_codewordBuffer.insert(m_codewordBuffer.end(), numMissingMPDUs * MPDU::maxMTU(), 0);
 
-            m_decodePacket();
-            return MAC_UHFPacketProcessingStatus::PACKET_READY;
+            return m_decodePacket() ? MAC_UHFPacketProcessingStatus::PACKET_READY
+              : MAC_UHFPacketProcessingStatus::READY_FOR_NEXT_UHF_PACKET;
           } // Have all the MPDUs?
 
           // If it was not the final fragment expected, just continue...
@@ -359,24 +381,87 @@ namespace ex2 {
       m_codewordBuffer.assign(firstMPDU.getPayload().begin(),firstMPDU.getPayload().end());
     }
 
-    void
+    bool
     MAC::m_decodePacket() {
 
       m_rawPacket.resize(0);
-      std::vector<uint8_t> codeword;
-      std::vector<uint8_t> decodedMessage;
       uint32_t cwLen = m_errorCorrection->getCodewordLen()/8;
       uint32_t cwCount = m_codewordBuffer.size() / cwLen;
       for (uint32_t c = 0; c < cwCount; c++) {
-        codeword.resize(0);
-        codeword.insert(codeword.end(), m_codewordBuffer.begin()+c*cwLen, m_codewordBuffer.begin()+c*cwLen+cwLen);
-        __attribute__((unused)) uint32_t bitErrors = m_FEC->decode(codeword, 100.0, decodedMessage);
+        m_codeword.assign(m_codewordBuffer.begin()+c*cwLen, m_codewordBuffer.begin()+c*cwLen+cwLen);
+        __attribute__((unused)) uint32_t bitErrors = m_FEC->decode(m_codeword, m_SNREstimate, m_decodedMessage);
         // @todo could log the bit errors
-        m_rawPacket.insert(m_rawPacket.end(), decodedMessage.begin(), decodedMessage.end());
+        m_rawPacket.insert(m_rawPacket.end(), m_decodedMessage.begin(), m_decodedMessage.end());
       }
       m_rawPacket.resize(m_currentPacketLength);
       m_firstFragmentReceived = false;
       m_mpduCodewordFragmentCount = 0;
+
+      if (!m_packetCRC) {
+        return true;
+      }
+
+      uint32_t const crcLength = crc::CRC_32_BITS / 8;
+      if (m_rawPacket.size() < crcLength ||
+        (!crc::valid(m_rawPacket.data(), m_rawPacket.size(), crc::CRC_32_BITS) && !m_listDecodePacket())) {
+        m_corruptPacketCount++;
+        m_rawPacket.resize(0);
+        return false;
+      }
+      m_rawPacket.resize(m_rawPacket.size() - crcLength);
+      return true;
+    }
+
+    bool
+    MAC::m_listDecodePacket() {
+
+      if (m_decodeListSize < 2 || !m_FEC->supportsListDecoding()) {
+        return false;
+      }
+
+      uint32_t cwLen = m_errorCorrection->getCodewordLen()/8;
+      uint32_t cwCount = m_codewordBuffer.size() / cwLen;
+      uint32_t messageLength = m_errorCorrection->getMessageLen() / 8;
+
+      // Start from the most likely decoding of every codeword, then swap in
+      // each alternative for one codeword at a time. Errors in more than one
+      // codeword are not searched since the number of combinations grows
+      // exponentially.
+      std::vector<std::vector<std::vector<uint8_t>>> candidates(cwCount);
+      for (uint32_t c = 0; c < cwCount; c++) {
+        m_codeword.assign(m_codewordBuffer.begin()+c*cwLen, m_codewordBuffer.begin()+c*cwLen+cwLen);
+        m_FEC->decodeList(m_codeword, m_SNREstimate, m_decodeListSize, candidates[c]);
+        if (candidates[c].empty()) {
+          return false;
+        }
+      }
+
+      // Copy the part of a candidate that lies within the packet into place
+      auto place = [&](uint32_t c, const std::vector<uint8_t>& message) {
+        uint32_t offset = c * messageLength;
+        if (offset < m_rawPacket.size()) {
+          uint32_t n = std::min<uint32_t>(std::min<uint32_t>(message.size(), messageLength),
+            m_rawPacket.size() - offset);
+          std::copy(message.begin(), message.begin() + n, m_rawPacket.begin() + offset);
+        }
+      };
+
+      for (uint32_t c = 0; c < cwCount; c++) {
+        place(c, candidates[c].front());
+      }
+      if (crc::valid(m_rawPacket.data(), m_rawPacket.size(), crc::CRC_32_BITS)) {
+        return true;
+      }
+      for (uint32_t c = 0; c < cwCount; c++) {
+        for (size_t a = 1; a < candidates[c].size(); a++) {
+          place(c, candidates[c][a]);
+          if (crc::valid(m_rawPacket.data(), m_rawPacket.size(), crc::CRC_32_BITS)) {
+            return true;
+          }
+        }
+        place(c, candidates[c].front());
+      }
+      return false;
     }
 
     bool
@@ -394,7 +479,25 @@ namespace ex2 {
 
       // Everything is done in units of bytes
 
-        uint16_t const packetLength = len;
+      // Append the packet CRC if it's on, leaving the caller's packet alone
+      if (m_packetCRC) {
+        if (len > MAC_MAX_USER_PACKET_LENGTH - crc::CRC_32_BITS / 8) {
+          return false;
+        }
+        m_crcPacket.assign(packet, packet + len);
+        crc packetCRC;
+        packetCRC.add(m_crcPacket, crc::CRC_32_BITS);
+        packet = m_crcPacket.data();
+        len = m_crcPacket.size();
+      }
+
+      // The receiver tells the MPDUs of a packet apart by their codeword
+      // fragment index, so there can't be more MPDUs than indices
+      if (MPDU::mpdusInNBytes(len, *m_errorCorrection) > MPDUHeader::maxCodewordFragments()) {
+        return false;
+      }
+
+      uint16_t const packetLength = len;
 
       // @note the message length returned by the ErrorCorrection object is
       // in bits. It may be that it's not a multiple of 8 bits (1 byte), so
@@ -412,12 +515,8 @@ namespace ex2 {
       // not quite fill up the MPDU(s), it is zero-padded. Finally, each MPDU is
       // sent to the UHF radio for transmission in transparent mode.
 
-      // The message buffer is eventually encoded to give the codeword
-      std::vector<uint8_t> message;
-
       // Set up the MPDU payload
-      std::vector<uint8_t> mpduPayload;
-      mpduPayload.resize(0); // ensure it's empty
+      m_mpduPayload.resize(0); // ensure it's empty
       uint32_t mpduPayloadBytesRemaining = MPDU::maxMTU();
       uint32_t mpduCodewordFragmentCount = 0;
 
@@ -427,46 +526,47 @@ namespace ex2 {
       uint32_t dataOffset = 0;
       uint32_t bytesRemaining = packetLength;
 
-      message.resize(0);
+      // The message buffer is eventually encoded to give the codeword
+      m_message.resize(0);
       do {
         // Fill the rest of the message buffer with data; if not enough data is
         // available, use what's there and pad
-        if (message.size() < messageLength) {
+        if (m_message.size() < messageLength) {
           // Check if we can fill the rest of the message
-          if (bytesRemaining >= messageLength - message.size()) {
+          if (bytesRemaining >= messageLength - m_message.size()) {
             // More than enough packet data remaining, so fill up the message
-            uint32_t bytesToAppend = messageLength - message.size();
-            message.insert(message.end(),
+            uint32_t bytesToAppend = messageLength - m_message.size();
+            m_message.insert(m_message.end(),
                            packet + dataOffset,
-                           packet + dataOffset + messageLength - message.size());
+                           packet + dataOffset + messageLength - m_message.size());
             bytesRemaining -= bytesToAppend;
             dataOffset += bytesToAppend;
           }
           else {
             // Not enough packet data remaining, so put what there is in message
-            message.insert(message.end(),
+            m_message.insert(m_message.end(),
                            packet + dataOffset, packet + dataOffset + bytesRemaining);
             dataOffset += bytesRemaining; // @todo don't really need to update this
             bytesRemaining -= bytesRemaining;
             // Zero-pad the rest of the message
-            message.resize(messageLength, 0);
+            m_message.resize(messageLength, 0);
           }
         }
 
         // Now apply the FEC encoding
         try {
-          std::vector<uint8_t> cw = m_FEC->encode(message);
+          std::vector<uint8_t> cw = m_FEC->encode(m_message);
 
           // Add codeword to current mpduPayload
           uint32_t codewordBytesRemaining = cw.size(); // @TODO this is always the same, so could get only somewhere.
 
           // Don't assiume the mpduPayload is empty
-          mpduPayloadBytesRemaining = MPDU::maxMTU() - mpduPayload.size();
+          mpduPayloadBytesRemaining = MPDU::maxMTU() - m_mpduPayload.size();
           // The codeword could be really long, so make as many MPDUs as possible
           uint32_t codewordOffset = 0;
           while (codewordBytesRemaining >= mpduPayloadBytesRemaining) {
             // fill the mpduPayload
-            mpduPayload.insert(mpduPayload.end(),
+            m_mpduPayload.insert(m_mpduPayload.end(),
               cw.begin()+codewordOffset, cw.begin()+codewordOffset+mpduPayloadBytesRemaining);
             codewordOffset += mpduPayloadBytesRemaining;
             codewordBytesRemaining -= mpduPayloadBytesRemaining;
@@ -475,20 +575,18 @@ namespace ex2 {
             // payload. Note, the MPDUHeader constructor cannot fail since the
             // only possible error would be from a bad ErrorCorrection, but that
             // would have been caught when m_errorCorrection was made.
-            MPDUHeader *mpduHeader = new MPDUHeader(m_rfModeNumber, *m_errorCorrection,
+            MPDUHeader mpduHeader(m_rfModeNumber, *m_errorCorrection,
               mpduCodewordFragmentCount++, packetLength, MPDU_HEADER_USER_PACKET_FRAGMENT_INDEX_DEFAULT);
             // Make an MPDU.
             // Just the same as for the MPDUHeader, there is no way for this
             // constructor to generate an exception because the only check that
             // could be made is for the MPDUHeader, which as noted above can't
             // fail.
-            MPDU *mpdu = new MPDU(*mpduHeader, mpduPayload);
-            std::vector<uint8_t> rawMPDU = mpdu->getRawMPDU();
+            MPDU mpdu(mpduHeader, m_mpduPayload);
+            const std::vector<uint8_t>& rawMPDU = mpdu.getRawMPDU();
             m_transparentModePayloads.insert(m_transparentModePayloads.end(), rawMPDU.begin(), rawMPDU.end());
-            delete mpdu;
-            delete mpduHeader;
             // reset the mpduPayload
-            mpduPayload.resize(0);
+            m_mpduPayload.resize(0);
             mpduPayloadBytesRemaining = MPDU::maxMTU();
           }
 
@@ -496,14 +594,14 @@ namespace ex2 {
           // mpduPayload, which must have enough room since the loop above fell
           // through
           if (codewordBytesRemaining > 0) {
-            mpduPayload.insert(mpduPayload.end(),
+            m_mpduPayload.insert(m_mpduPayload.end(),
               cw.begin()+codewordOffset, cw.end());
             mpduPayloadBytesRemaining -= codewordBytesRemaining;
             codewordBytesRemaining = 0;
           }
 
           // prepare to make another message
-          message.resize(0);
+          m_message.resize(0);
         }
         catch (FECException& e) { // @todo need an FEC exception that all subclasses inherit
           // @note No FEC method will throw an exception for encoding at this time.
@@ -516,23 +614,21 @@ namespace ex2 {
       // are needed to make a whole MPDU. Thus, there has to be fewer than a
       // whole mpduPayload's worth...
       if (mpduPayloadBytesRemaining > 0 && mpduPayloadBytesRemaining < MPDU::maxMTU()) {
-        mpduPayload.resize(MPDU::maxMTU(),0); // zero-pad to length
+        m_mpduPayload.resize(MPDU::maxMTU(),0); // zero-pad to length
         // Now have a full MPDU payload, so make the MPDU and stash the raw
         // payload. Note, the MPDUHeader constructor cannot fail since the
         // only possible error would be from a bad ErrorCorrection, but that
         // would have been caught when m_errorCorrection was made.
-        MPDUHeader *mpduHeader = new MPDUHeader(m_rfModeNumber, *m_errorCorrection,
+        MPDUHeader mpduHeader(m_rfModeNumber, *m_errorCorrection,
           mpduCodewordFragmentCount++, packetLength, MPDU_HEADER_USER_PACKET_FRAGMENT_INDEX_DEFAULT);
         // Make an MPDU.
         // Just the same as for the MPDUHeader, there is no way for this
         // constructor to generate an exception because the only check that
         // could be made is for the MPDUHeader, which as noted above can't
         // fail.
-        MPDU *mpdu = new MPDU(*mpduHeader, mpduPayload);
-        std::vector<uint8_t> rawMPDU = mpdu->getRawMPDU();
+        MPDU mpdu(mpduHeader, m_mpduPayload);
+        const std::vector<uint8_t>& rawMPDU = mpdu.getRawMPDU();
         m_transparentModePayloads.insert(m_transparentModePayloads.end(), rawMPDU.begin(), rawMPDU.end());
-        delete mpdu;
-        delete mpduHeader;
       }
 
 #if MAC_DEBUG
@@ -15,159 +15,501 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <cstring>
+
+#include "cpuFeatures.hpp"
+
+#if EX2_SDR_X86_KERNELS
+#include <immintrin.h>
+#endif
 
 namespace ex2
 {
   namespace sdr
   {
 
+    namespace {
+
+      typedef void (*BitKernelFn)(const uint8_t *in, size_t count, uint8_t *out);
+
+      // Pack 8 1-bit symbols, one per byte of the little endian word @p w,
+      // into a byte with the first symbol in the msb. Each symbol bit k lands
+      // at bit 63 - k of the product and no partial products overlap
+      inline uint8_t packWord(uint64_t w)
+      {
+        return (uint8_t) (((w & 0x0101010101010101ULL) * 0x8040201008040201ULL) >> 56);
+      }
+
+      // Pack count/8 whole bytes of 1-bit symbols; @p out may be @p in
+      void packScalar(const uint8_t *in, size_t count, uint8_t *out)
+      {
+        for (size_t i = 0; i < count / 8; i++) {
+          uint64_t w;
+          std::memcpy(&w, in + 8 * i, 8);
+          out[i] = packWord(w);
+        }
+      } // packScalar
+
+      // Each byte value unpacked to 8 1-bit symbols, msb first, as it
+      // appears in memory
+      const uint64_t *unpackTable()
+      {
+        static const std::vector<uint64_t> table = [] {
+          std::vector<uint64_t> t(256);
+          for (unsigned int v = 0; v < 256; v++) {
+            uint8_t bits[8];
+            for (int b = 0; b < 8; b++) {
+              bits[b] = (v >> (7 - b)) & 0x01;
+            }
+            std::memcpy(&t[v], bits, 8);
+          }
+          return t;
+        }();
+        return table.data();
+      }
+
+      // Unpack @p count bytes to 8 * count 1-bit symbols; @p out may be
+      // @p in, so work from the end
+      void unpackScalar(const uint8_t *in, size_t count, uint8_t *out)
+      {
+        const uint64_t *table = unpackTable();
+        for (size_t i = count; i-- > 0; ) {
+          std::memcpy(out + 8 * i, &table[in[i]], 8);
+        }
+      } // unpackScalar
+
+#if EX2_SDR_X86_KERNELS
+      __attribute__((target("bmi2")))
+      void packBMI2(const uint8_t *in, size_t count, uint8_t *out)
+      {
+        for (size_t i = 0; i < count / 8; i++) {
+          uint64_t w;
+          std::memcpy(&w, in + 8 * i, 8);
+          // Byte swap so the first symbol is extracted to the msb
+          out[i] = (uint8_t) _pext_u64(__builtin_bswap64(w), 0x0101010101010101ULL);
+        }
+      } // packBMI2
+
+      __attribute__((target("bmi2")))
+      void unpackBMI2(const uint8_t *in, size_t count, uint8_t *out)
+      {
+        for (size_t i = count; i-- > 0; ) {
+          uint64_t w = __builtin_bswap64(_pdep_u64(in[i], 0x0101010101010101ULL));
+          std::memcpy(out + 8 * i, &w, 8);
+        }
+      } // unpackBMI2
+
+      __attribute__((target("avx2")))
+      void packAVX2(const uint8_t *in, size_t count, uint8_t *out)
+      {
+        // Reverse each group of 8 symbols so the movemask puts the first in
+        // the msb of its byte
+        const __m256i reverse8 = _mm256_setr_epi8(
+          7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+          7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+          __m256i v = _mm256_loadu_si256((const __m256i *) (in + i));
+          v = _mm256_slli_epi16(_mm256_shuffle_epi8(v, reverse8), 7);
+          uint32_t m = (uint32_t) _mm256_movemask_epi8(v);
+          std::memcpy(out + i / 8, &m, 4);
+        }
+        packScalar(in + i, count - i, out + i / 8);
+      } // packAVX2
+
+      __attribute__((target("avx2")))
+      void unpackAVX2(const uint8_t *in, size_t count, uint8_t *out)
+      {
+        // Copy each of 4 bytes to 8 lanes and test one bit per lane
+        const __m256i spread = _mm256_setr_epi8(
+          0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+          2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+        const __m256i bit = _mm256_setr_epi8(
+          (char) 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+          (char) 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+          (char) 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+          (char) 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+        const __m256i one = _mm256_set1_epi8(1);
+        size_t i = count;
+        for (; i >= 4; i -= 4) {
+          uint32_t w;
+          std::memcpy(&w, in + i - 4, 4);
+          __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32((int) w), spread);
+          v = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(v, bit), bit), one);
+          _mm256_storeu_si256((__m256i *) (out + 8 * (i - 4)), v);
+        }
+        unpackScalar(in, i, out);
+      } // unpackAVX2
+#endif
+
+      const DispatchedKernel<BitKernelFn> packKernel({
+#if EX2_SDR_X86_KERNELS
+        { "avx2", CPUFeatures::AVX2, packAVX2 },
+        { "bmi2", CPUFeatures::BMI2, packBMI2 },
+#endif
+        { "scalar", CPUFeatures::NONE, packScalar }
+      });
+
+      const DispatchedKernel<BitKernelFn> unpackKernel({
+#if EX2_SDR_X86_KERNELS
+        { "avx2", CPUFeatures::AVX2, unpackAVX2 },
+        { "bmi2", CPUFeatures::BMI2, unpackBMI2 },
+#endif
+        { "scalar", CPUFeatures::NONE, unpackScalar }
+      });
+
+      // Big endian word access so bit 63 is the first bit in memory
+      inline uint64_t loadBE(const uint8_t *p)
+      {
+        uint64_t w = 0;
+        for (int i = 0; i < 8; i++) {
+          w = (w << 8) | p[i];
+        }
+        return w;
+      }
+
+      inline void storeBE(uint8_t *p, uint64_t w)
+      {
+        for (int i = 7; i >= 0; i--) {
+          p[i] = (uint8_t) w;
+          w >>= 8;
+        }
+      }
+
+      // Reverse all 64 bits, which reverses the bits of 8 bytes in memory
+      // whatever the byte order
+      inline uint64_t reverse64(uint64_t w)
+      {
+        w = ((w >> 1) & 0x5555555555555555ULL) | ((w & 0x5555555555555555ULL) << 1);
+        w = ((w >> 2) & 0x3333333333333333ULL) | ((w & 0x3333333333333333ULL) << 2);
+        w = ((w >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((w & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        w = ((w >> 8) & 0x00FF00FF00FF00FFULL) | ((w & 0x00FF00FF00FF00FFULL) << 8);
+        w = ((w >> 16) & 0x0000FFFF0000FFFFULL) | ((w & 0x0000FFFF0000FFFFULL) << 16);
+        return (w >> 32) | (w << 32);
+      }
+
+      inline uint8_t reverse8(uint8_t b)
+      {
+        b = ((b >> 1) & 0x55) | ((b & 0x55) << 1);
+        b = ((b >> 2) & 0x33) | ((b & 0x33) << 2);
+        return (b >> 4) | (b << 4);
+      }
+
+      // Shift @p count bytes of bits left by @p shift bits, shifting in zeros
+      void shiftLeft(uint8_t *data, size_t count, size_t shift)
+      {
+        size_t q = std::min(shift / 8, count);
+        unsigned int r = shift % 8;
+        std::memmove(data, data + q, count - q);
+        std::memset(data + count - q, 0, q);
+        if (r == 0) return;
+
+        // Funnel each word with the top bits of the next byte
+        size_t i = 0;
+        for (; i + 8 < count; i += 8) {
+          storeBE(data + i, (loadBE(data + i) << r) | (data[i + 8] >> (8 - r)));
+        }
+        for (; i < count; i++) {
+          data[i] = (data[i] << r) | ((i + 1 < count) ? (data[i + 1] >> (8 - r)) : 0);
+        }
+      } // shiftLeft
+
+      // Shift @p count bytes of bits right by @p shift bits, shifting in zeros
+      void shiftRight(uint8_t *data, size_t count, size_t shift)
+      {
+        size_t q = std::min(shift / 8, count);
+        unsigned int r = shift % 8;
+        std::memmove(data + q, data, count - q);
+        std::memset(data, 0, q);
+        if (r == 0) return;
+
+        // Funnel each word with the bottom bits of the previous byte
+        size_t i = count;
+        for (; i >= 9; i -= 8) {
+          uint64_t previous = data[i - 9];
+          storeBE(data + i - 8, (loadBE(data + i - 8) >> r) | (previous << (64 - r)));
+        }
+        for (; i-- > 0; ) {
+          data[i] = (data[i] >> r) | ((i > 0) ? (uint8_t) (data[i - 1] << (8 - r)) : 0);
+        }
+      } // shiftRight
+
+    } /* anonymous namespace */
+
+    size_t
+    MPDUUtility::repackedLength (
+      size_t count,
+      BitsPerSymbol currentBps,
+      BitsPerSymbol newBps)
+    {
+      return (count * currentBps + newBps - 1) / newBps;
+    }
+
     void
     MPDUUtility::repack (
-      std::vector<uint8_t>& payload,
+      const uint8_t *in,
+      size_t count,
       BitsPerSymbol currentBps,
-      BitsPerSymbol newBps)
+      BitsPerSymbol newBps,
+      uint8_t *out)
     {
-      // already done?
-      if (currentBps == newBps) return;
+      if (count == 0) return;
+
+      if (currentBps == newBps) {
+        if (out != in) std::memmove(out, in, count);
+        return;
+      }
 
       if (currentBps == BitsPerSymbol::BPSymb_8 and newBps == BitsPerSymbol::BPSymb_1)
-        unpack (payload);
+        unpack (in, count, out);
       else if (currentBps == BitsPerSymbol::BPSymb_1 and newBps == BitsPerSymbol::BPSymb_8)
-        pack (payload);
+        pack (in, count, out);
+      else if (newBps > currentBps)
+      {
+        // Shift symbols into a register and take a new symbol off the top
+        // whenever enough bits are there. The output never gets ahead of
+        // the input, so this works in place
+        const uint32_t currentMask = (1U << currentBps) - 1;
+        const uint32_t newMask = (1U << newBps) - 1;
+        uint32_t reg = 0;
+        unsigned int regBits = 0;
+        size_t o = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+          reg = (reg << currentBps) | (in[i] & currentMask);
+          regBits += currentBps;
+          if (regBits >= (unsigned int) newBps)
+          {
+            regBits -= newBps;
+            out[o++] = (reg >> regBits) & newMask;
+          }
+        }
+        // A partial last symbol is left justified
+        if (regBits > 0)
+          out[o] = (reg << (newBps - regBits)) & newMask;
+      }
       else
       {
-        // Determine how many output bytes are needed
-        unsigned int packedBitsCount = payload.size () * currentBps;
-        div_t symbs = div (packedBitsCount, newBps);
-        unsigned int repackedCount = symbs.quot;
-        if (symbs.rem > 0) repackedCount++;
-
-        std::vector<uint8_t> repackedPayload (repackedCount);
-
-        uint8_t packedSymb = 0;
-        uint8_t repackedSymb = 0;
-
-        unsigned int packedSymbsProcessed = 0;
-        unsigned int packedBitsProcessed = 0;
-        unsigned int repackedSymbsProcessed = 0;
-        unsigned int repackedBitsProcessed = 0;
-        uint8_t mask;
-
-        for (unsigned int bits = 0; bits < packedBitsCount; bits++)
+        // Fewer bits per symbol, so more symbols out than in. Work from the
+        // end, shifting symbols into the top of a register and taking new
+        // symbols off the bottom, so this also works in place
+        const uint32_t currentMask = (1U << currentBps) - 1;
+        size_t o = repackedLength (count, currentBps, newBps);
+        unsigned int need = count * currentBps - (o - 1) * newBps;
+        uint32_t reg = 0;
+        unsigned int regBits = 0;
+        for (size_t i = count; i-- > 0; )
         {
-          repackedSymb <<= 1;
-
-          if (packedBitsProcessed == 0) // new packed symbol
-            packedSymb = payload[packedSymbsProcessed++];
-
-          mask = currentBps - packedBitsProcessed - 1;
-          repackedSymb |= (packedSymb >> mask) & 0x01;
-
-          if (repackedBitsProcessed == (unsigned int)(newBps - 1))
+          reg |= (in[i] & currentMask) << regBits;
+          regBits += currentBps;
+          while (regBits >= need)
           {
-            repackedPayload[repackedSymbsProcessed++] = repackedSymb;
-            repackedSymb = 0;
+            // A partial last symbol is left justified
+            out[--o] = (reg & ((1U << need) - 1)) << (newBps - need);
+            reg >>= need;
+            regBits -= need;
+            need = newBps;
           }
+        }
+      }
+    }
 
-          packedBitsProcessed = (packedBitsProcessed + 1) % currentBps;
-          repackedBitsProcessed = (repackedBitsProcessed + 1) % newBps;
-        } // for
+    void
+    MPDUUtility::repack (
+      const std::vector<uint8_t>& in,
+      BitsPerSymbol currentBps,
+      BitsPerSymbol newBps,
+      std::vector<uint8_t>& out)
+    {
+      out.resize (repackedLength (in.size (), currentBps, newBps));
+      repack (in.data (), in.size (), currentBps, newBps, out.data ());
+    }
 
-        if (repackedSymbsProcessed < repackedCount)
-        {
-          repackedSymb <<= (newBps - repackedBitsProcessed);
-          repackedPayload[repackedSymbsProcessed++] = repackedSymb;
-        }
+    void
+    MPDUUtility::repack (
+      ConstBitSpan bits,
+      BitsPerSymbol newBps,
+      std::vector<uint8_t>& out)
+    {
+      if (!bits.byteAligned ())
+      {
+        // Copy to the start of a byte first
+        BitBuffer aligned (bits);
+        repack (aligned.span (), newBps, out);
+        return;
+      }
 
-        payload = repackedPayload;
+      // Repack the whole bytes, then drop the symbols and clear the bits
+      // beyond the end of the span
+      size_t count = (bits.size () + 7) / 8;
+      size_t repackedCount = (bits.size () + newBps - 1) / newBps;
+      out.resize (repackedLength (count, BitsPerSymbol::BPSymb_8, newBps));
+      repack (bits.data (), count, BitsPerSymbol::BPSymb_8, newBps, out.data ());
+      out.resize (repackedCount);
+      if (repackedCount > 0)
+      {
+        unsigned int lastBits = bits.size () - (repackedCount - 1) * newBps;
+        out.back () &= (uint8_t) (((1U << lastBits) - 1) << (newBps - lastBits));
       }
     }
 
     void
-    MPDUUtility::pack (std::vector<uint8_t>& payload)
+    MPDUUtility::repack (
+      const std::vector<uint8_t>& in,
+      BitsPerSymbol currentBps,
+      BitBuffer& out)
     {
+      // The packed bytes are left justified with zero padding, as a
+      // BitBuffer requires
+      out.resize (in.size () * currentBps);
+      repack (in.data (), in.size (), currentBps, BitsPerSymbol::BPSymb_8, out.data ());
+    }
 
-      // Determine how many output bytes are needed
-      div_t symbs = div (payload.size (), 8);
-      unsigned int packedCount = symbs.quot;
-      if (symbs.rem > 0) packedCount++;
+    void
+    MPDUUtility::repack (
+      std::vector<uint8_t>& payload,
+      BitsPerSymbol currentBps,
+      BitsPerSymbol newBps)
+    {
+      // already done?
+      if (currentBps == newBps) return;
 
-      std::vector<uint8_t> packedPayload (packedCount);
+      // Repack in place, growing the payload first or shrinking it after
+      size_t count = payload.size ();
+      size_t repackedCount = repackedLength (count, currentBps, newBps);
+      if (repackedCount > count) payload.resize (repackedCount);
+      repack (payload.data (), count, currentBps, newBps, payload.data ());
+      payload.resize (repackedCount);
+    }
 
-      unsigned int uIdx; // unpacked index
-      unsigned int pIdx; // packed index
-      unsigned int bIdx; // bit index
-      uint8_t packing = 0;
+    const char *
+    MPDUUtility::packKernelName ()
+    {
+      return packKernel.name ();
+    }
 
-      bIdx = 0;
-      pIdx = 0;
-      for (uIdx = 0; uIdx < payload.size (); uIdx++)
-      {
-        // OR the current unpacked sample into the packing var
-        packing |= (payload[uIdx] & 0x01);
-        bIdx++;
-        if (bIdx == 8) // if packing full, save it
-        {
-          packedPayload[pIdx] = packing;
-          pIdx++;
-          packing = 0;
-          bIdx = 0;
-        }
-        else
-          packing <<= 1;
-      }
+    const char *
+    MPDUUtility::unpackKernelName ()
+    {
+      return unpackKernel.name ();
+    }
 
-      // If the last byte was not full, may need an extra shift.
-      // Keep in mind that there is one last shift above if symbs.rem > 0
-      if (symbs.rem > 0) packedPayload[pIdx] = packing << (7 - symbs.rem);
+    void
+    MPDUUtility::pack (const uint8_t *in, size_t count, uint8_t *out)
+    {
+      // Whole bytes by the kernel, then any partial last byte left justified
+      packKernel.get () (in, count, out);
 
-      payload = packedPayload;
+      size_t rem = count % 8;
+      if (rem > 0)
+      {
+        uint8_t packing = 0;
+        for (size_t i = count - rem; i < count; i++)
+          packing = (packing << 1) | (in[i] & 0x01);
+        out[count / 8] = packing << (8 - rem);
+      }
     } // pack
 
     void
-    MPDUUtility::unpack (std::vector<uint8_t>& payload)
+    MPDUUtility::unpack (const uint8_t *in, size_t count, uint8_t *out)
     {
       // have to assume that all bits in a packed payload are required,
       // so the number of unpacked samples will always be a multiple of 8
-      unsigned int unpackedCount = payload.size () * 8;
-      std::vector<uint8_t> unpackedPayload (unpackedCount);
+      unpackKernel.get () (in, count, out);
+    } // unpack
 
-      unsigned int uIdx = 0; // unpacked index
-      uint8_t packedSample;
+    void
+    MPDUUtility::pack (std::vector<uint8_t>& payload)
+    {
+      repack (payload, BitsPerSymbol::BPSymb_1, BitsPerSymbol::BPSymb_8);
+    } // pack
 
-      for (unsigned int pIdx = 0; pIdx < payload.size (); pIdx++)
-      {
-        packedSample = payload[pIdx];
+    void
+    MPDUUtility::unpack (std::vector<uint8_t>& payload)
+    {
+      repack (payload, BitsPerSymbol::BPSymb_8, BitsPerSymbol::BPSymb_1);
+    } // unpack
 
-        // might as un-roll the loop
-        unpackedPayload[uIdx++] = (packedSample >> 7) & 0x01;
-        unpackedPayload[uIdx++] = (packedSample >> 6) & 0x01;
-        unpackedPayload[uIdx++] = (packedSample >> 5) & 0x01;
-        unpackedPayload[uIdx++] = (packedSample >> 4) & 0x01;
-        unpackedPayload[uIdx++] = (packedSample >> 3) & 0x01;
-        unpackedPayload[uIdx++] = (packedSample >> 2) & 0x01;
-        unpackedPayload[uIdx++] = (packedSample >> 1) & 0x01;
-        unpackedPayload[uIdx++] = packedSample & 0x01;
+    void
+    MPDUUtility::reverseBits(uint8_t *data, size_t bits)
+    {
+      size_t count = (bits + 7) / 8;
+
+      // Swap and reverse words from both ends, then the bytes left over
+      size_t i = 0;
+      size_t j = count;
+      for (; j - i >= 16; i += 8, j -= 8) {
+        uint64_t front, back;
+        std::memcpy(&front, data + i, 8);
+        std::memcpy(&back, data + j - 8, 8);
+        front = reverse64(front);
+        back = reverse64(back);
+        std::memcpy(data + i, &back, 8);
+        std::memcpy(data + j - 8, &front, 8);
+      }
+      for (; j - i > 1; i++, j--) {
+        uint8_t front = data[i];
+        data[i] = reverse8(data[j - 1]);
+        data[j - 1] = reverse8(front);
       }
+      if (j - i == 1) data[i] = reverse8(data[i]);
 
-      payload = unpackedPayload;
+      // The padding at the end of the last byte is now at the start
+      if (bits % 8 > 0) shiftLeft(data, count, 8 - bits % 8);
+    }
 
-    } // unpack
+    void
+    MPDUUtility::rotateBits(uint8_t *data, size_t bits, size_t numBits, bool left)
+    {
+      if (bits == 0) return;
+      size_t shift = numBits % bits;
+      if (shift == 0) return;
+      if (!left) shift = bits - shift;
+
+      size_t count = (bits + 7) / 8;
+      if (bits % 8 == 0)
+      {
+        // Rotate whole bytes, then the remaining bits through the last byte
+        std::rotate(data, data + shift / 8, data + count);
+        unsigned int r = shift % 8;
+        if (r > 0)
+        {
+          uint8_t carry = data[0] >> (8 - r);
+          shiftLeft(data, count, r);
+          data[count - 1] |= carry;
+        }
+      }
+      else
+      {
+        // The rotation crosses the padding, so OR the bits shifted left with
+        // those shifted right in a copy, and clear the padding
+        data[count - 1] &= 0xFF << (8 * count - bits);
+        std::vector<uint8_t> wrapped(data, data + count);
+        shiftLeft(data, count, shift);
+        shiftRight(wrapped.data(), count, bits - shift);
+        for (size_t i = 0; i < count; i++)
+          data[i] |= wrapped[i];
+        data[count - 1] &= 0xFF << (8 * count - bits);
+      }
+    }
 
     void
     MPDUUtility::reverse(std::vector<uint8_t>& payload, BitsPerSymbol currentBps, bool byteLevel)
     {
-      BitsPerSymbol tempBPS = currentBps;
-      if (!byteLevel) {
-        if (tempBPS != BitsPerSymbol::BPSymb_1) {
-          unpack(payload);
-        }
+      if (byteLevel) {
+        std::reverse(payload.begin(), payload.end());
+        return;
       }
-      std::reverse(payload.begin(), payload.end());
-      if (!byteLevel) {
-        if (tempBPS != BitsPerSymbol::BPSymb_1) {
-          repack(payload, BitsPerSymbol::BPSymb_1, tempBPS);
-        }
+
+      // Reverse the packed bit stream rather than unpacking it
+      size_t count = payload.size();
+      if (currentBps != BitsPerSymbol::BPSymb_8) {
+        repack(payload, currentBps, BitsPerSymbol::BPSymb_8);
+      }
+      reverseBits(payload.data(), count * currentBps);
+      if (currentBps != BitsPerSymbol::BPSymb_8) {
+        repack(payload, BitsPerSymbol::BPSymb_8, currentBps);
+        payload.resize(count);
       }
     }
 
@@ -175,15 +517,17 @@ namespace ex2
     MPDUUtility::roll(std::vector<uint8_t>& payload, BitsPerSymbol currentBps, uint32_t numBits, bool left)
     {
       if (numBits == 0) return;
-      BitsPerSymbol tempBPS = currentBps;
-      repack(payload, currentBps, BitsPerSymbol::BPSymb_1);
-      uint32_t shiftPositions = numBits % payload.size();
-      if (left) {
-        std::rotate(payload.begin(), payload.begin()+shiftPositions, payload.end());
-      } else {
-        std::rotate(payload.begin(), payload.end()-shiftPositions, payload.end());
-      }
-      repack(payload, BitsPerSymbol::BPSymb_1, tempBPS);
+
+      // Rotate the packed bit stream rather than unpacking it
+      size_t count = payload.size();
+      if (currentBps != BitsPerSymbol::BPSymb_8) {
+        repack(payload, currentBps, BitsPerSymbol::BPSymb_8);
+      }
+      rotateBits(payload.data(), count * currentBps, numBits, left);
+      if (currentBps != BitsPerSymbol::BPSymb_8) {
+        repack(payload, BitsPerSymbol::BPSymb_8, currentBps);
+        payload.resize(count);
+      }
     }
 
   } /* namespace sdr */
@@ -63,3 +63,10 @@ sdr_uhf_baud_rate_t get_uhf_baud_t_from_rf_mode_number(uint8_t rf_mode_number)
 
     return obj.getBaudRateEnum();
 }
+
+uint16_t get_bit_rate_from_rf_mode_number(uint8_t rf_mode_number)
+{
+    ex2::sdr::RF_Mode obj((ex2::sdr::RF_Mode::RF_ModeNumber)rf_mode_number);
+
+    return obj.getBitRate();
+}
@@ -0,0 +1,76 @@
+/*!
+ * @file bitBuffer.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Packed bit spans and buffers shared by the PHY, MAC and FEC.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include "bitBuffer.hpp"
+
+namespace ex2 {
+  namespace sdr {
+
+    BitBuffer::BitBuffer(size_t size) : m_bytes((size + 7) / 8, 0), m_size(size) {
+    }
+
+    BitBuffer::BitBuffer(const std::vector<uint8_t>& bytes) : m_bytes(bytes), m_size(bytes.size() * 8) {
+    }
+
+    BitBuffer::BitBuffer(ConstBitSpan bits) : m_size(0) {
+      append(bits);
+    }
+
+    void
+    BitBuffer::resize(size_t size) {
+      m_bytes.resize((size + 7) / 8, 0);
+      m_size = size;
+      // Keep the unused bits zero
+      if (m_size % 8 > 0) {
+        m_bytes.back() &= (uint8_t) (0xFF << (8 - m_size % 8));
+      }
+    }
+
+    void
+    BitBuffer::append(bool bit) {
+      if (m_size % 8 == 0) {
+        m_bytes.push_back(0);
+      }
+      if (bit) {
+        m_bytes.back() |= 0x80 >> (m_size % 8);
+      }
+      m_size++;
+    }
+
+    void
+    BitBuffer::append(uint64_t value, unsigned int count) {
+      size_t pos = m_size;
+      resize(m_size + count);
+      deposit(pos, count, value);
+    }
+
+    void
+    BitBuffer::append(ConstBitSpan bits) {
+      size_t pos = m_size;
+      if (pos % 8 == 0 && bits.byteAligned()) {
+        // Whole bytes, then clear anything past the last bit
+        m_bytes.insert(m_bytes.end(), bits.data(), bits.data() + (bits.size() + 7) / 8);
+        resize(pos + bits.size());
+        return;
+      }
+
+      resize(pos + bits.size());
+      size_t i = 0;
+      for (; i + 32 <= bits.size(); i += 32) {
+        deposit(pos + i, 32, bits.extract(i, 32));
+      }
+      deposit(pos + i, bits.size() - i, bits.extract(i, bits.size() - i));
+    }
+
+  } /* namespace sdr */
+} /* namespace ex2 */
@@ -0,0 +1,120 @@
+/*!
+ * @file bufferPool.c
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Fixed-size buffer pools carved from static arenas.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include "bufferPool.h"
+#include "osal.h"
+
+/* The OS comes from the build configuration through osal.h; without it the
+   pthread lock would quietly be built for FreeRTOS */
+#if defined(OS_FREERTOS) == defined(OS_POSIX)
+#error "bufferPool.c needs exactly one of OS_FREERTOS and OS_POSIX"
+#endif
+
+#if defined(OS_FREERTOS)
+
+#include <FreeRTOS.h>
+#include <os_task.h>
+
+#define POOL_LOCK() taskENTER_CRITICAL()
+#define POOL_UNLOCK() taskEXIT_CRITICAL()
+
+/* A critical section can't be entered from an interrupt handler the task
+   way; the handler masks interrupts and restores the mask it found */
+typedef UBaseType_t pool_isr_state_t;
+#define POOL_LOCK_FROM_ISR(state) ((state) = taskENTER_CRITICAL_FROM_ISR())
+#define POOL_UNLOCK_FROM_ISR(state) taskEXIT_CRITICAL_FROM_ISR(state)
+
+#else
+
+#include <pthread.h>
+
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+#define POOL_LOCK() pthread_mutex_lock(&pool_mutex)
+#define POOL_UNLOCK() pthread_mutex_unlock(&pool_mutex)
+
+/* Receive "interrupts" are threads on POSIX */
+typedef int pool_isr_state_t;
+#define POOL_LOCK_FROM_ISR(state) ((state) = pthread_mutex_lock(&pool_mutex))
+#define POOL_UNLOCK_FROM_ISR(state) ((void)(state), pthread_mutex_unlock(&pool_mutex))
+
+#endif /* OS_FREERTOS */
+
+/* Called with the pool locked */
+static void *pool_take(os_pool_t *pool) {
+    void *block = NULL;
+
+    if (pool->free_list) {
+        block = pool->free_list;
+        pool->free_list = *(void **)block;
+    } else if (pool->used < pool->block_count) {
+        block = pool->arena + pool->used * pool->block_size;
+        pool->used++;
+    }
+    if (block) {
+        pool->available--;
+    }
+
+    return block;
+}
+
+/* Called with the pool locked */
+static void pool_give(os_pool_t *pool, void *block) {
+    *(void **)block = pool->free_list;
+    pool->free_list = block;
+    pool->available++;
+}
+
+void *os_pool_alloc(os_pool_t *pool) {
+    POOL_LOCK();
+    void *block = pool_take(pool);
+    POOL_UNLOCK();
+
+    return block;
+}
+
+void os_pool_free(os_pool_t *pool, void *block) {
+    if (!block) {
+        return;
+    }
+
+    POOL_LOCK();
+    pool_give(pool, block);
+    POOL_UNLOCK();
+}
+
+void *os_pool_alloc_from_isr(os_pool_t *pool) {
+    pool_isr_state_t state;
+
+    POOL_LOCK_FROM_ISR(state);
+    void *block = pool_take(pool);
+    POOL_UNLOCK_FROM_ISR(state);
+
+    return block;
+}
+
+void os_pool_free_from_isr(os_pool_t *pool, void *block) {
+    pool_isr_state_t state;
+
+    if (!block) {
+        return;
+    }
+
+    POOL_LOCK_FROM_ISR(state);
+    pool_give(pool, block);
+    POOL_UNLOCK_FROM_ISR(state);
+}
+
+size_t os_pool_available(const os_pool_t *pool) {
+    return pool->available;
+}
@@ -0,0 +1,95 @@
+/*!
+ * @file cpuFeatures.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Runtime CPU feature detection and dispatch of hot kernels.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include "cpuFeatures.hpp"
+
+namespace ex2 {
+  namespace sdr {
+
+    std::atomic<uint32_t> CPUFeatures::m_mask(CPUFeatures::ALL);
+    std::atomic<uint32_t> CPUFeatures::m_generation(1);
+
+    uint32_t
+    CPUFeatures::detected()
+    {
+      static const uint32_t features = []() {
+        uint32_t f = NONE;
+#if EX2_SDR_X86_KERNELS
+        // The builtins also confirm the OS saves the wider register state
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse2")) {
+          f |= SSE2;
+        }
+        if (__builtin_cpu_supports("ssse3")) {
+          f |= SSSE3;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+          f |= AVX2;
+        }
+        if (__builtin_cpu_supports("avx512bw")) {
+          f |= AVX512BW;
+        }
+        if (__builtin_cpu_supports("bmi2")) {
+          f |= BMI2;
+        }
+        if (__builtin_cpu_supports("pclmul")) {
+          f |= PCLMUL;
+        }
+#endif
+        return f;
+      }();
+      return features;
+    } // detected
+
+    uint32_t
+    CPUFeatures::enabled()
+    {
+      return detected() & m_mask.load(std::memory_order_relaxed);
+    } // enabled
+
+    void
+    CPUFeatures::setMask(uint32_t mask)
+    {
+      m_mask.store(mask & ALL, std::memory_order_relaxed);
+      m_generation.fetch_add(1, std::memory_order_acq_rel);
+    } // setMask
+
+    std::string
+    CPUFeatures::toString(uint32_t features)
+    {
+      static const struct {
+        Feature f;
+        const char *name;
+      } names[] = {
+        { SSE2, "SSE2" },
+        { SSSE3, "SSSE3" },
+        { AVX2, "AVX2" },
+        { AVX512BW, "AVX512BW" },
+        { BMI2, "BMI2" },
+        { PCLMUL, "PCLMUL" }
+      };
+
+      std::string s;
+      for (const auto& n : names) {
+        if (features & n.f) {
+          if (!s.empty()) {
+            s += " ";
+          }
+          s += n.name;
+        }
+      }
+      return s.empty() ? "none" : s;
+    } // toString
+
+  } /* namespace sdr */
+} /* namespace ex2 */
@@ -45,6 +45,11 @@ int os_queue_enqueue(os_queue_handle_t handle, const void *value) {
 	return pthread_queue_enqueue(handle, value, 0);
 }
 
+int os_queue_enqueue_from_isr(os_queue_handle_t handle, const void *value, void *task_woken) {
+	(void)task_woken;
+	return pthread_queue_enqueue(handle, value, 0);
+}
+
 int os_queue_dequeue(os_queue_handle_t handle, void *buf, uint32_t timeout) {
   return pthread_queue_dequeue(handle, buf, timeout);
 }
@@ -108,6 +113,10 @@ int os_queue_enqueue(os_queue_handle_t handle, const void* value) {
 	return xQueueSendToBack(handle, value, QUEUE_NO_WAIT);
 }
 
+int os_queue_enqueue_from_isr(os_queue_handle_t handle, const void* value, void *task_woken) {
+	return xQueueSendToBackFromISR(handle, value, (BaseType_t *)task_woken);
+}
+
 int os_queue_dequeue(os_queue_handle_t handle, void* buf, uint32_t timeout) {
 	return xQueueReceive(handle, buf, timeout);
 }
@@ -12,90 +12,272 @@
  */
 
 #include <vectorTools.h>
+#include "cpuFeatures.hpp"
+
+#include <algorithm>
+#include <exception>
+
+#if EX2_SDR_X86_KERNELS
+#include <immintrin.h>
+#endif
 
 namespace ex2 {
   namespace sdr {
 
-    void
-    VectorTools::floatToBytes(float threshold, bool reverseBitOrder, std::vector<float>& in, std::vector<uint8_t>& out)
-    {
+    namespace {
+
+      // Hard-decision slicer kernels. Each thresholds numBytes groups of 8
+      // floats into packed bytes, the first float of a group being the msb
+      // unless reverseBitOrder. All implementations produce identical results.
+      typedef void (*SliceKernelFn)(float threshold, bool reverseBitOrder, const float *in,
+        size_t numBytes, uint8_t *out);
 
-      out.resize(0); // lazy way to make sure we get all the bytes...
-
-      if (reverseBitOrder) {
-        for (uint32_t f = 0; f < in.size(); f += 8) {
-          uint8_t byte = 0x00;
-          for (uint32_t b = 0; b < 8; b++) {
-            byte >>= 1;
-            if (f+b < in.size()) {
-              if (in[f+b] > threshold) {
-                byte = byte | 0x80;
-              }
-              else {
-                byte = byte & 0x7F;
-              }
-            }
-          } // for 8 bits
-          out.push_back(byte);
+      void
+      sliceScalar(float threshold, bool reverseBitOrder, const float *in, size_t numBytes, uint8_t *out)
+      {
+        for (size_t i = 0; i < numBytes; i++, in += 8) {
+          uint8_t byte = 0;
+          for (int b = 0; b < 8; b++) {
+            byte |= (uint8_t) (in[b] > threshold) << (reverseBitOrder ? b : 7 - b);
+          }
+          out[i] = byte;
         }
-      }
-      else {
-        for (uint32_t f = 0; f < in.size(); f += 8) {
-          uint8_t byte = 0x00;
-          for (uint32_t b = 0; b < 8; b++) {
-            byte <<= 1;
-            if (f+b < in.size()) {
-              if (in[f+b] > threshold) {
-                byte = byte | 0x01;
-              }
-              else {
-                byte = byte & 0xFE;
-              }
-            }
-          } // for 8 bits
-          out.push_back(byte);
+      } // sliceScalar
+
+#if EX2_SDR_X86_KERNELS
+      // movemask puts the first float in the lsb, so for msb first the
+      // floats are reversed before they are compared
+      __attribute__((target("sse2")))
+      void
+      sliceSSE2(float threshold, bool reverseBitOrder, const float *in, size_t numBytes, uint8_t *out)
+      {
+        const __m128 t = _mm_set1_ps(threshold);
+        for (size_t i = 0; i < numBytes; i++, in += 8) {
+          __m128 lo = _mm_loadu_ps(in);
+          __m128 hi = _mm_loadu_ps(in + 4);
+          if (reverseBitOrder) {
+            out[i] = (uint8_t) (_mm_movemask_ps(_mm_cmpgt_ps(lo, t))
+              | (_mm_movemask_ps(_mm_cmpgt_ps(hi, t)) << 4));
+          }
+          else {
+            lo = _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(0, 1, 2, 3));
+            hi = _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(0, 1, 2, 3));
+            out[i] = (uint8_t) ((_mm_movemask_ps(_mm_cmpgt_ps(lo, t)) << 4)
+              | _mm_movemask_ps(_mm_cmpgt_ps(hi, t)));
+          }
         }
-      }
-    } // floatToBytes
+      } // sliceSSE2
 
-    void
-    VectorTools::bytesToFloat(std::vector<uint8_t>& in, bool packed, bool lsbFirst, bool nrz, float magnitude, std::vector<float>& out)
-    {
-      out.resize(0);
-
-      uint8_t byte;
-      float fbit;
-      for (uint32_t i = 0; i < in.size(); i++) {
-        byte = in[i];
-        if (packed) {
-          for (uint32_t b = 0; b < 8; b++) {
-            if (lsbFirst) {
-              fbit = (float)(byte & 0x01);
-              byte >>= 1;
-            }
-            else {
-              fbit = (float)((byte & 0x80) >> 7);
-              byte <<= 1;
-            }
-            if (nrz) {
-              fbit = fbit*2.0 - 1.0;
-            }
-            fbit *= magnitude;
-            out.push_back(fbit);
-          } // for 8 bits per byte
+      __attribute__((target("avx2")))
+      void
+      sliceAVX2(float threshold, bool reverseBitOrder, const float *in, size_t numBytes, uint8_t *out)
+      {
+        const __m256 t = _mm256_set1_ps(threshold);
+        const __m256i order = reverseBitOrder ? _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+          : _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        size_t i = 0;
+        for (; i + 4 <= numBytes; i += 4, in += 32) {
+          for (int j = 0; j < 4; j++) {
+            __m256 v = _mm256_permutevar8x32_ps(_mm256_loadu_ps(in + 8 * j), order);
+            out[i + j] = (uint8_t) _mm256_movemask_ps(_mm256_cmp_ps(v, t, _CMP_GT_OQ));
+          }
         }
-        else {
-          if (lsbFirst) {
-            fbit = (float)(byte & 0x01);
+        for (; i < numBytes; i++, in += 8) {
+          __m256 v = _mm256_permutevar8x32_ps(_mm256_loadu_ps(in), order);
+          out[i] = (uint8_t) _mm256_movemask_ps(_mm256_cmp_ps(v, t, _CMP_GT_OQ));
+        }
+      } // sliceAVX2
+#endif
+
+      // Packed bit expansion kernels. Each writes 8 floats per input byte,
+      // zero for a 0 bit and one for a 1 bit, the msb first unless lsbFirst.
+      typedef void (*ExpandKernelFn)(const uint8_t *in, size_t length, bool lsbFirst,
+        float zero, float one, float *out);
+
+      void
+      expandScalar(const uint8_t *in, size_t length, bool lsbFirst, float zero, float one, float *out)
+      {
+        for (size_t i = 0; i < length; i++, out += 8) {
+          uint8_t byte = in[i];
+          for (int b = 0; b < 8; b++) {
+            out[b] = ((byte >> (lsbFirst ? b : 7 - b)) & 0x01) ? one : zero;
+          }
+        }
+      } // expandScalar
+
+      // Block reversal kernels. Each reverses every blockSize floats of the
+      // length floats at v in place.
+      typedef void (*ReverseKernelFn)(float *v, size_t length, uint32_t blockSize);
+
+      void
+      reverseScalar(float *v, size_t length, uint32_t blockSize)
+      {
+        for (size_t i = 0; i < length; i += blockSize) {
+          std::reverse(v + i, v + i + blockSize);
+        }
+      } // reverseScalar
+
+#if EX2_SDR_X86_KERNELS
+      // Each bit is selected by comparing the byte, broadcast to every lane,
+      // masked with that lane's bit
+      __attribute__((target("sse2")))
+      void
+      expandSSE2(const uint8_t *in, size_t length, bool lsbFirst, float zero, float one, float *out)
+      {
+        const __m128i first = lsbFirst ? _mm_setr_epi32(0x01, 0x02, 0x04, 0x08)
+          : _mm_setr_epi32(0x80, 0x40, 0x20, 0x10);
+        const __m128i second = lsbFirst ? _mm_setr_epi32(0x10, 0x20, 0x40, 0x80)
+          : _mm_setr_epi32(0x08, 0x04, 0x02, 0x01);
+        const __m128 zeros = _mm_set1_ps(zero);
+        const __m128 ones = _mm_set1_ps(one);
+        for (size_t i = 0; i < length; i++, out += 8) {
+          __m128i byte = _mm_set1_epi32(in[i]);
+          __m128 m = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(byte, first), first));
+          _mm_storeu_ps(out, _mm_or_ps(_mm_and_ps(m, ones), _mm_andnot_ps(m, zeros)));
+          m = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(byte, second), second));
+          _mm_storeu_ps(out + 4, _mm_or_ps(_mm_and_ps(m, ones), _mm_andnot_ps(m, zeros)));
+        }
+      } // expandSSE2
+
+      __attribute__((target("avx2")))
+      void
+      expandAVX2(const uint8_t *in, size_t length, bool lsbFirst, float zero, float one, float *out)
+      {
+        const __m256i bits = lsbFirst ? _mm256_setr_epi32(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80)
+          : _mm256_setr_epi32(0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+        const __m256 zeros = _mm256_set1_ps(zero);
+        const __m256 ones = _mm256_set1_ps(one);
+        for (size_t i = 0; i < length; i++, out += 8) {
+          __m256i byte = _mm256_set1_epi32(in[i]);
+          __m256 m = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(byte, bits), bits));
+          _mm256_storeu_ps(out, _mm256_blendv_ps(zeros, ones, m));
+        }
+      } // expandAVX2
+
+      // Swap reversed vectors from the two ends of each block until they
+      // would overlap, then reverse what is left in the middle
+      __attribute__((target("sse2")))
+      void
+      reverseSSE2(float *v, size_t length, uint32_t blockSize)
+      {
+        for (size_t i = 0; i < length; i += blockSize) {
+          float *lo = v + i;
+          float *hi = v + i + blockSize;
+          for (; hi - lo >= 8; lo += 4, hi -= 4) {
+            __m128 a = _mm_loadu_ps(lo);
+            __m128 z = _mm_loadu_ps(hi - 4);
+            _mm_storeu_ps(lo, _mm_shuffle_ps(z, z, _MM_SHUFFLE(0, 1, 2, 3)));
+            _mm_storeu_ps(hi - 4, _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 1, 2, 3)));
+          }
+          if (hi - lo == 4) {
+            __m128 a = _mm_loadu_ps(lo);
+            _mm_storeu_ps(lo, _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 1, 2, 3)));
           }
           else {
-            fbit = (float)((byte & 0x80) >> 7);
+            std::reverse(lo, hi);
           }
-          if (nrz) {
-            fbit = fbit*2.0 - 1.0;
+        }
+      } // reverseSSE2
+
+      __attribute__((target("avx2")))
+      void
+      reverseAVX2(float *v, size_t length, uint32_t blockSize)
+      {
+        const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        for (size_t i = 0; i < length; i += blockSize) {
+          float *lo = v + i;
+          float *hi = v + i + blockSize;
+          for (; hi - lo >= 16; lo += 8, hi -= 8) {
+            __m256 a = _mm256_loadu_ps(lo);
+            __m256 z = _mm256_loadu_ps(hi - 8);
+            _mm256_storeu_ps(lo, _mm256_permutevar8x32_ps(z, reverse));
+            _mm256_storeu_ps(hi - 8, _mm256_permutevar8x32_ps(a, reverse));
+          }
+          if (hi - lo == 8) {
+            _mm256_storeu_ps(lo, _mm256_permutevar8x32_ps(_mm256_loadu_ps(lo), reverse));
+          }
+          else {
+            std::reverse(lo, hi);
           }
-          fbit *= magnitude;
-          out.push_back(fbit);
+        }
+      } // reverseAVX2
+#endif
+
+      const DispatchedKernel<ExpandKernelFn> expandKernel({
+#if EX2_SDR_X86_KERNELS
+        { "avx2", CPUFeatures::AVX2, expandAVX2 },
+        { "sse2", CPUFeatures::SSE2, expandSSE2 },
+#endif
+        { "scalar", CPUFeatures::NONE, expandScalar } });
+
+      const DispatchedKernel<ReverseKernelFn> reverseKernel({
+#if EX2_SDR_X86_KERNELS
+        { "avx2", CPUFeatures::AVX2, reverseAVX2 },
+        { "sse2", CPUFeatures::SSE2, reverseSSE2 },
+#endif
+        { "scalar", CPUFeatures::NONE, reverseScalar } });
+
+      const DispatchedKernel<SliceKernelFn> sliceKernel({
+#if EX2_SDR_X86_KERNELS
+        { "avx2", CPUFeatures::AVX2, sliceAVX2 },
+        { "sse2", CPUFeatures::SSE2, sliceSSE2 },
+#endif
+        { "scalar", CPUFeatures::NONE, sliceScalar } });
+
+    } // namespace
+
+    void
+    VectorTools::floatToBytes(float threshold, bool reverseBitOrder, const std::vector<float>& in, std::vector<uint8_t>& out)
+    {
+      out.resize((in.size() + 7) / 8);
+      floatToBytes(threshold, reverseBitOrder, in.data(), in.size(), out.data());
+    } // floatToBytes
+
+    void
+    VectorTools::floatToBytes(float threshold, bool reverseBitOrder, const float *in, size_t length, uint8_t *out)
+    {
+      size_t const numBytes = length / 8;
+      sliceKernel.get()(threshold, reverseBitOrder, in, numBytes, out);
+
+      // The missing values of a final partial byte are zeros
+      size_t const remainder = length % 8;
+      if (remainder) {
+        float last[8];
+        for (size_t b = 0; b < 8; b++) {
+          last[b] = (b < remainder) ? in[numBytes * 8 + b] : threshold;
+        }
+        sliceScalar(threshold, reverseBitOrder, last, 1, out + numBytes);
+      }
+    } // floatToBytes
+
+    const char *
+    VectorTools::floatToBytesKernelName()
+    {
+      return sliceKernel.name();
+    }
+
+    void
+    VectorTools::bytesToFloat(const std::vector<uint8_t>& in, bool packed, bool lsbFirst, bool nrz, float magnitude, std::vector<float>& out)
+    {
+      out.resize(packed ? in.size() * 8 : in.size());
+      bytesToFloat(in.data(), in.size(), packed, lsbFirst, nrz, magnitude, out.data());
+    } //bytesToFloat
+
+    void
+    VectorTools::bytesToFloat(const uint8_t *in, size_t length, bool packed, bool lsbFirst, bool nrz,
+      float magnitude, float *out)
+    {
+      // The float for a binary 0 and a binary 1
+      float const zero = (nrz ? -1.0f : 0.0f) * magnitude;
+      float const one = magnitude;
+
+      if (packed) {
+        expandKernel.get()(in, length, lsbFirst, zero, one, out);
+      }
+      else {
+        int const shift = lsbFirst ? 0 : 7;
+        for (size_t i = 0; i < length; i++) {
+          out[i] = ((in[i] >> shift) & 0x01) ? one : zero;
         }
       }
     } //bytesToFloat
@@ -103,30 +285,25 @@ namespace ex2 {
     void
     VectorTools::blockReverse(uint32_t blockSize, std::vector<float>& v)
     {
-      if (v.size() % blockSize != 0) {
+      if (blockSize == 0 || v.size() % blockSize != 0) {
         throw std::exception(); // TODO make more descriptive
       }
 
-      float tmp = 0.0;
-      bool even = (blockSize % 2 == 0);
-      for (uint32_t i = 0; i < v.size(); i += blockSize) {
-        if (even) {
-          for (uint32_t j = 0; j < blockSize/2; j++) {
-            tmp = v[blockSize - 1 - j + i];
-            v[blockSize - 1 - j + i] = v[j + i];
-            v[j + i] = tmp;
-          }
-        }
-        else {
-          for (uint32_t j = 0; j < (blockSize - 1)/2; j++) {
-            tmp = v[blockSize - 1 - j + i];
-            v[blockSize - 1 - j + i] = v[j + i];
-            v[j + i] = tmp;
-          }
-        }
-      }
+      reverseKernel.get()(v.data(), v.size(), blockSize);
 
     } // blockReverse
 
+    const char *
+    VectorTools::bytesToFloatKernelName()
+    {
+      return expandKernel.name();
+    }
+
+    const char *
+    VectorTools::blockReverseKernelName()
+    {
+      return reverseKernel.name();
+    }
+
   } /* namespace sdr */
 } /* namespace ex2 */
@@ -89,6 +89,19 @@ bool set_rf_mode_number (mac_t *m, rf_mode_number_t rf_mode_number)
   return true;
 }
 
+bool set_packet_crc(mac_t *m, bool packet_crc)
+{
+  ex2::sdr::MAC *obj;
+
+  if (m == NULL)
+    return false;
+
+  obj = static_cast<ex2::sdr::MAC *>(m->obj);
+  obj->setPacketCRC(packet_crc);
+
+  return true;
+}
+
 uhf_packet_processing_status_t process_uhf_packet(mac_t *m, const uint8_t *uhf_payload, const uint32_t payload_length)
 {
   ex2::sdr::MAC *obj;
@@ -0,0 +1,25 @@
+/*!
+ * @file crcWrapper.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details C wrapper for the CRC calculations.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+#include "crcWrapper.h"
+
+#include "crc.hpp"
+
+uint16_t crc16_ccitt_update(uint16_t crc, const uint8_t *data, size_t len)
+{
+  return (uint16_t) ex2::sdr::crc::calculate(ex2::sdr::crc::CRC_16_BITS, data, len, crc);
+}
+
+uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+  return ex2::sdr::crc::calculate(ex2::sdr::crc::CRC_32_BITS, data, len, crc);
+}
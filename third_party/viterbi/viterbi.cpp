@@ -4,6 +4,8 @@
 // Date: 01/30/2015
 
 #include "viterbi.hpp"
+#include "cpuFeatures.hpp"
+#include "osal.h"
 
 #include <algorithm>
 #include <cassert>
@@ -13,9 +15,208 @@
 #include <utility>
 #include <vector>
 
+// The flight target has no std::thread, so blocks are decoded serially there
+#ifdef OS_POSIX
+#include <atomic>
+#include <thread>
+#endif
+
+#if EX2_SDR_X86_KERNELS
+#include <immintrin.h>
+#endif
+
 namespace ex2 {
   namespace sdr {
 
+    const uint8_t ViterbiCodec::ERASED_BIT;
+    const int ViterbiCodec::MAX_CONSTRAINT;
+    const unsigned int ViterbiCodec::MAX_POLYNOMIALS;
+
+    namespace {
+
+      // Add-compare-select kernels. The two branches into state i come from
+      // source states 2 * (i mod N/2) and 2 * (i mod N/2) + 1 with branch
+      // metrics bm1[i] and bm2[i]. A path metric of UCHAR_MAX marks an
+      // unreachable state; reachable path metrics saturate just below it so
+      // they never wrap around. The new metrics are renormalized so the best
+      // is zero, keeping them within a byte regardless of the number of bit
+      // errors. All implementations produce identical results.
+      typedef void (*ACSKernelFn)(uint8_t *pm, const uint8_t *bm1, const uint8_t *bm2,
+        uint16_t numStates, uint8_t *tempPm, uint8_t *decisions);
+
+      void acsScalar(uint8_t *pm, const uint8_t *bm1, const uint8_t *bm2,
+        uint16_t numStates, uint8_t *tempPm, uint8_t *decisions)
+      {
+        const unsigned int half = numStates / 2;
+        uint8_t minPathMetric = UCHAR_MAX;
+        for (unsigned int i = 0; i < numStates; i++) {
+          unsigned int s = (i % half) << 1;
+          int pm1 = pm[s];
+          if (pm1 < UCHAR_MAX) {
+            pm1 = std::min(pm1 + bm1[i], UCHAR_MAX - 1);
+          }
+          int pm2 = pm[s + 1];
+          if (pm2 < UCHAR_MAX) {
+            pm2 = std::min(pm2 + bm2[i], UCHAR_MAX - 1);
+          }
+          if (pm1 <= pm2) {
+            tempPm[i] = pm1;
+            decisions[i] = s;
+          }
+          else {
+            tempPm[i] = pm2;
+            decisions[i] = s + 1;
+          }
+          minPathMetric = std::min(minPathMetric, tempPm[i]);
+        }
+
+        for (unsigned int i = 0; i < numStates; i++) {
+          if (tempPm[i] < UCHAR_MAX) {
+            pm[i] = tempPm[i] - minPathMetric;
+          }
+          else {
+            pm[i] = UCHAR_MAX;
+          }
+        }
+      } // acsScalar
+
+#if EX2_SDR_X86_KERNELS
+      // 16 states per iteration; needs at least 32 states (constraint 6)
+      __attribute__((target("sse2")))
+      void acsSSE2(uint8_t *pm, const uint8_t *bm1, const uint8_t *bm2,
+        uint16_t numStates, uint8_t *tempPm, uint8_t *decisions)
+      {
+        if (numStates < 32) {
+          acsScalar(pm, bm1, bm2, numStates, tempPm, decisions);
+          return;
+        }
+        const unsigned int half = numStates / 2;
+
+        // Split the path metrics into even and odd source states
+        uint8_t even[1 << (ViterbiCodec::MAX_CONSTRAINT - 2)];
+        uint8_t odd[1 << (ViterbiCodec::MAX_CONSTRAINT - 2)];
+        const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+        for (unsigned int i = 0; i < numStates; i += 32) {
+          __m128i a = _mm_loadu_si128((const __m128i *) &pm[i]);
+          __m128i b = _mm_loadu_si128((const __m128i *) &pm[i + 16]);
+          _mm_storeu_si128((__m128i *) &even[i / 2],
+            _mm_packus_epi16(_mm_and_si128(a, lowBytes), _mm_and_si128(b, lowBytes)));
+          _mm_storeu_si128((__m128i *) &odd[i / 2],
+            _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+        }
+
+        const __m128i unreachable = _mm_set1_epi8((char) UCHAR_MAX);
+        const __m128i ceiling = _mm_set1_epi8((char) (UCHAR_MAX - 1));
+        const __m128i one = _mm_set1_epi8(1);
+        const __m128i laneSources = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+          16, 18, 20, 22, 24, 26, 28, 30);
+        __m128i minPm = unreachable;
+        for (unsigned int i = 0; i < numStates; i += 16) {
+          unsigned int j = i % half;
+          __m128i pe = _mm_loadu_si128((const __m128i *) &even[j]);
+          __m128i po = _mm_loadu_si128((const __m128i *) &odd[j]);
+          __m128i pm1 = _mm_min_epu8(_mm_adds_epu8(pe, _mm_loadu_si128((const __m128i *) &bm1[i])), ceiling);
+          pm1 = _mm_or_si128(pm1, _mm_cmpeq_epi8(pe, unreachable));
+          __m128i pm2 = _mm_min_epu8(_mm_adds_epu8(po, _mm_loadu_si128((const __m128i *) &bm2[i])), ceiling);
+          pm2 = _mm_or_si128(pm2, _mm_cmpeq_epi8(po, unreachable));
+          __m128i newPm = _mm_min_epu8(pm1, pm2);
+          // Prefer the even source on a tie, as the scalar kernel does
+          __m128i fromOdd = _mm_andnot_si128(_mm_cmpeq_epi8(newPm, pm1), one);
+          __m128i source = _mm_add_epi8(_mm_set1_epi8((char) (2 * j)), laneSources);
+          _mm_storeu_si128((__m128i *) &tempPm[i], newPm);
+          _mm_storeu_si128((__m128i *) &decisions[i], _mm_or_si128(source, fromOdd));
+          minPm = _mm_min_epu8(minPm, newPm);
+        }
+        minPm = _mm_min_epu8(minPm, _mm_srli_si128(minPm, 8));
+        minPm = _mm_min_epu8(minPm, _mm_srli_si128(minPm, 4));
+        minPm = _mm_min_epu8(minPm, _mm_srli_si128(minPm, 2));
+        minPm = _mm_min_epu8(minPm, _mm_srli_si128(minPm, 1));
+        minPm = _mm_set1_epi8((char) (_mm_cvtsi128_si32(minPm) & 0xFF));
+
+        for (unsigned int i = 0; i < numStates; i += 16) {
+          __m128i t = _mm_loadu_si128((const __m128i *) &tempPm[i]);
+          __m128i r = _mm_or_si128(_mm_subs_epu8(t, minPm), _mm_cmpeq_epi8(t, unreachable));
+          _mm_storeu_si128((__m128i *) &pm[i], r);
+        }
+      } // acsSSE2
+
+      // 32 states per iteration; needs at least 64 states (constraint 7)
+      __attribute__((target("avx2")))
+      void acsAVX2(uint8_t *pm, const uint8_t *bm1, const uint8_t *bm2,
+        uint16_t numStates, uint8_t *tempPm, uint8_t *decisions)
+      {
+        if (numStates < 64) {
+          acsSSE2(pm, bm1, bm2, numStates, tempPm, decisions);
+          return;
+        }
+        const unsigned int half = numStates / 2;
+
+        // Split the path metrics into even and odd source states; packus
+        // works within 128-bit lanes, so restore the 64-bit group order
+        uint8_t even[1 << (ViterbiCodec::MAX_CONSTRAINT - 2)];
+        uint8_t odd[1 << (ViterbiCodec::MAX_CONSTRAINT - 2)];
+        const __m256i lowBytes = _mm256_set1_epi16(0x00FF);
+        for (unsigned int i = 0; i < numStates; i += 64) {
+          __m256i a = _mm256_loadu_si256((const __m256i *) &pm[i]);
+          __m256i b = _mm256_loadu_si256((const __m256i *) &pm[i + 32]);
+          __m256i e = _mm256_packus_epi16(_mm256_and_si256(a, lowBytes), _mm256_and_si256(b, lowBytes));
+          __m256i o = _mm256_packus_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+          _mm256_storeu_si256((__m256i *) &even[i / 2], _mm256_permute4x64_epi64(e, 0xD8));
+          _mm256_storeu_si256((__m256i *) &odd[i / 2], _mm256_permute4x64_epi64(o, 0xD8));
+        }
+
+        const __m256i unreachable = _mm256_set1_epi8((char) UCHAR_MAX);
+        const __m256i ceiling = _mm256_set1_epi8((char) (UCHAR_MAX - 1));
+        const __m256i one = _mm256_set1_epi8(1);
+        const __m256i laneSources = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+          16, 18, 20, 22, 24, 26, 28, 30, 32, 34, 36, 38, 40, 42, 44, 46,
+          48, 50, 52, 54, 56, 58, 60, 62);
+        __m256i minPm = unreachable;
+        for (unsigned int i = 0; i < numStates; i += 32) {
+          unsigned int j = i % half;
+          __m256i pe = _mm256_loadu_si256((const __m256i *) &even[j]);
+          __m256i po = _mm256_loadu_si256((const __m256i *) &odd[j]);
+          __m256i pm1 = _mm256_min_epu8(_mm256_adds_epu8(pe, _mm256_loadu_si256((const __m256i *) &bm1[i])), ceiling);
+          pm1 = _mm256_or_si256(pm1, _mm256_cmpeq_epi8(pe, unreachable));
+          __m256i pm2 = _mm256_min_epu8(_mm256_adds_epu8(po, _mm256_loadu_si256((const __m256i *) &bm2[i])), ceiling);
+          pm2 = _mm256_or_si256(pm2, _mm256_cmpeq_epi8(po, unreachable));
+          __m256i newPm = _mm256_min_epu8(pm1, pm2);
+          __m256i fromOdd = _mm256_andnot_si256(_mm256_cmpeq_epi8(newPm, pm1), one);
+          __m256i source = _mm256_add_epi8(_mm256_set1_epi8((char) (2 * j)), laneSources);
+          _mm256_storeu_si256((__m256i *) &tempPm[i], newPm);
+          _mm256_storeu_si256((__m256i *) &decisions[i], _mm256_or_si256(source, fromOdd));
+          minPm = _mm256_min_epu8(minPm, newPm);
+        }
+        __m128i m = _mm_min_epu8(_mm256_castsi256_si128(minPm), _mm256_extracti128_si256(minPm, 1));
+        m = _mm_min_epu8(m, _mm_srli_si128(m, 8));
+        m = _mm_min_epu8(m, _mm_srli_si128(m, 4));
+        m = _mm_min_epu8(m, _mm_srli_si128(m, 2));
+        m = _mm_min_epu8(m, _mm_srli_si128(m, 1));
+        const __m256i minAll = _mm256_set1_epi8((char) (_mm_cvtsi128_si32(m) & 0xFF));
+
+        for (unsigned int i = 0; i < numStates; i += 32) {
+          __m256i t = _mm256_loadu_si256((const __m256i *) &tempPm[i]);
+          __m256i r = _mm256_or_si256(_mm256_subs_epu8(t, minAll), _mm256_cmpeq_epi8(t, unreachable));
+          _mm256_storeu_si256((__m256i *) &pm[i], r);
+        }
+      } // acsAVX2
+#endif
+
+      const DispatchedKernel<ACSKernelFn> acsKernel({
+#if EX2_SDR_X86_KERNELS
+        { "avx2", CPUFeatures::AVX2, acsAVX2 },
+        { "sse2", CPUFeatures::SSE2, acsSSE2 },
+#endif
+        { "scalar", CPUFeatures::NONE, acsScalar }
+      });
+
+    } /* anonymous namespace */
+
+    const char *ViterbiCodec::acsKernelName()
+    {
+      return acsKernel.name();
+    }
+
     int ReverseBits(int num_bits, int input)
     {
       assert(input < (1 << num_bits));
@@ -30,8 +231,11 @@ namespace ex2 {
     ViterbiCodec::ViterbiCodec(int constraint, const std::vector<int>& polynomials)
     : _constraint(constraint)
     , _poly(polynomials)
+    , _tracebackDepth(constraint * 5)
     {
       assert(!_poly.empty());
+      assert(_constraint >= 3 && _constraint <= MAX_CONSTRAINT);
+      assert(_poly.size() <= MAX_POLYNOMIALS);
       for (unsigned int i = 0; i < _poly.size(); i++) {
         assert(_poly[i] > 0);
         assert(_poly[i] < (1 << _constraint));
@@ -89,49 +293,44 @@ namespace ex2 {
 
     std::vector<uint8_t> ViterbiCodec::encodePacked(const std::vector<uint8_t>& bits) const
     {
-      std::vector<uint8_t> encoded;
+      return encodeBits(ConstBitSpan(bits)).bytes();
+    }
+
+    BitBuffer ViterbiCodec::encodeBits(ConstBitSpan bits) const
+    {
+      BitBuffer encoded;
+      encoded.reserve(bits.size() * k_precomputedShiftRegOutputsCols);
       int state = 0;
-      uint8_t t = 0;
       uint8_t bit = 0;
-      uint8_t encodedBits = 0;
-      uint8_t encodedBitCount = 0;
+      uint64_t encodedBits = 0;
+      unsigned int encodedBitCount = 0;
       int rowIndex;
 
       // Encode the message bits.
-      for (unsigned int i = 0; i < bits.size(); i++) {
-        t = bits[i];
-        for (int b = 7; b >= 0; b--) {
-          bit = (t >> b) & 0x01;
-          // Calculate the current row in the precomputed shift register output
-          // matrix based on the current state and the input bit
-          rowIndex = state | (bit << (_constraint - 1));
-          // The resulting encoded bits are in the column of the precomputed
-          // shift register output matrix.
-          //
-          // Save each element of the column in the encodedBits byte until a
-          // full byte is available, then save that in the encoded array.
-          for (unsigned int j = 0; j < k_precomputedShiftRegOutputsCols; j++) {
-            encodedBits <<= 1;
-            encodedBits = encodedBits | m_precomputedShiftRegOutputs[rowIndex][j];
-            encodedBitCount++;
-            if (encodedBitCount >= 8) {
-              encoded.push_back(encodedBits);
-              encodedBitCount = 0;
-              encodedBits = 0;
-            }
-          }
+      for (size_t i = 0; i < bits.size(); i++) {
+        bit = bits.get(i);
+        // Calculate the current row in the precomputed shift register output
+        // matrix based on the current state and the input bit
+        rowIndex = state | (bit << (_constraint - 1));
+        // The resulting encoded bits are in the column of the precomputed
+        // shift register output matrix.
+        //
+        // Save each element of the column in encodedBits until a full word
+        // is available, then append that to the encoded bits.
+        for (unsigned int j = 0; j < k_precomputedShiftRegOutputsCols; j++) {
+          encodedBits = (encodedBits << 1) | m_precomputedShiftRegOutputs[rowIndex][j];
+          encodedBitCount++;
+        }
+        if (encodedBitCount >= 48) {
+          encoded.append(encodedBits, encodedBitCount);
+          encodedBitCount = 0;
+          encodedBits = 0;
+        }
 
-          state = _next_state(state, bit);
-        } // for each bit in a message byte
-      } // for all message bytes
+        state = _next_state(state, bit);
+      } // for all message bits
 
-      // check if the number of encoded bits is not an integral multiple of 8
-      if (encodedBitCount != 0) {
-        encodedBits <<= (8 - encodedBitCount);
-        encoded.push_back(encodedBits);
-        encodedBitCount = 0;
-        encodedBits = 0;
-      }
+      encoded.append(encodedBits, encodedBitCount);
 
       return encoded;
     }
@@ -160,6 +359,22 @@ namespace ex2 {
           m_precomputedShiftRegOutputs[i][j] = output;
         }
       }
+
+      // The output symbols, one bit per polynomial, on the two branches into
+      // each state
+      const unsigned int numStates = 1 << (_constraint - 1);
+      _source_symbols.resize(2 * numStates);
+      for (unsigned int state = 0; state < numStates; state++) {
+        int s = (state & ((1 << (_constraint - 2)) - 1)) << 1;
+        for (int b = 0; b < 2; b++) {
+          int index = (s | b) | ((state >> (_constraint - 2)) << (_constraint - 1));
+          uint8_t symbol = 0;
+          for (unsigned int j = 0; j < k_precomputedShiftRegOutputsCols; j++) {
+            symbol |= m_precomputedShiftRegOutputs[index][j] << j;
+          }
+          _source_symbols[2 * state + b] = symbol;
+        }
+      }
     }
 
     void ViterbiCodec::freePrecomputedShiftRegOutputs()
@@ -172,46 +387,30 @@ namespace ex2 {
       }
     }
 
-    int ViterbiCodec::_branch_metric(const uint8_t* bits, uint8_t numBits, int source_state, int target_state) const
+    void ViterbiCodec::_acs_step(const uint8_t* bits, uint8_t numBits, uint8_t *path_metrics,
+      uint16_t path_metrics_length, uint8_t *temp_path_metrics, uint8_t *trellis_column) const
     {
-      int index = source_state | ((target_state >> (_constraint - 2)) << (_constraint - 1));
-
-      // Calculate the Hamming distance
-      int distance = 0;
-      for (unsigned int i = 0; i < numBits; i++) {
-        distance += (bits[i] != (m_precomputedShiftRegOutputs[index][i]));
+      // The branch metric depends only on the encoder output symbol, so
+      // compute the Hamming distance, ignoring erased bits, for each of the
+      // 2^numBits symbols once and look it up for each state
+      uint8_t symbolMetrics[1 << MAX_POLYNOMIALS];
+      for (unsigned int sym = 0; sym < (1u << numBits); sym++) {
+        uint8_t distance = 0;
+        for (unsigned int j = 0; j < numBits; j++) {
+          distance += (bits[j] != ERASED_BIT) && (bits[j] != ((sym >> j) & 0x01));
+        }
+        symbolMetrics[sym] = distance;
       }
-      return distance;
-    }
-
-//    void ViterbiCodec::_path_metric(const uint8_t* bits, uint8_t numBits,
-//      const std::vector<uint8_t>& prev_path_metrics, int state,
-//      uint8_t *newPathMetric, uint8_t *previousState) const
-    void ViterbiCodec::_path_metric(const uint8_t* bits, uint8_t numBits,
-      const uint8_t *prev_path_metrics, int state,
-      uint8_t *newPathMetric, uint8_t *previousState) const
-    {
-      int s = (state & ((1 << (_constraint - 2)) - 1)) << 1;
-      int source_state1 = s | 0;
-      int source_state2 = s | 1;
 
-      int pm1 = prev_path_metrics[source_state1];
-      if (pm1 < INT_MAX) {
-        pm1 += _branch_metric(bits, numBits, source_state1, state);
-      }
-      int pm2 = prev_path_metrics[source_state2];
-      if (pm2 < INT_MAX) {
-        pm2 += _branch_metric(bits, numBits, source_state2, state);
+      uint8_t branchMetrics1[1 << (MAX_CONSTRAINT - 1)];
+      uint8_t branchMetrics2[1 << (MAX_CONSTRAINT - 1)];
+      for (unsigned int i = 0; i < path_metrics_length; i++) {
+        branchMetrics1[i] = symbolMetrics[_source_symbols[2 * i]];
+        branchMetrics2[i] = symbolMetrics[_source_symbols[2 * i + 1]];
       }
 
-      if (pm1 <= pm2) {
-        *newPathMetric = pm1;
-        *previousState = source_state1;
-      }
-      else {
-        *newPathMetric = pm2;
-        *previousState = source_state2;
-      }
+      acsKernel.get()(path_metrics, branchMetrics1, branchMetrics2, path_metrics_length,
+        temp_path_metrics, trellis_column);
     }
 
 //    void ViterbiCodec::_update_path_metrics(const uint8_t* bits, uint8_t numBits, std::vector<uint8_t>& path_metrics,
@@ -219,18 +418,8 @@ namespace ex2 {
     void ViterbiCodec::_update_path_metrics(const uint8_t* bits, uint8_t numBits, uint8_t *path_metrics, uint16_t path_metrics_length,
       Trellis& trellis) const
     {
-      uint8_t newPathMetric;
-      uint8_t previousState;
-      for (unsigned int i = 0; i < path_metrics_length; i++) {
-        _path_metric(bits, numBits, path_metrics, i, &newPathMetric, &previousState);
-        _temp_path_metrics[i] = newPathMetric;
-        (*_temp_trellis_column)[i] = previousState;
-      }
-
-//      path_metrics = (*_temp_path_metrics);
-      for (unsigned int i = 0; i < path_metrics_length; i++) {
-        path_metrics[i] = _temp_path_metrics[i];
-      }
+      _acs_step(bits, numBits, path_metrics, path_metrics_length, _temp_path_metrics,
+        _temp_trellis_column->data());
       trellis.push_back((*_temp_trellis_column));
     }
 
@@ -281,15 +470,20 @@ namespace ex2 {
 
     ViterbiCodec::bitarr_t ViterbiCodec::decodeTruncated(const bitarr_t& bits) const
     {
+      const unsigned int poly_len = _poly.size();
 
       bitarr_t decoded;
-      decoded.resize(bits.size()/2,0);
+      decoded.resize(bits.size()/poly_len,0);
 
       unsigned int truncLength = 0;
 
-      // Compute path metrics and generate trellis.
+      // The trellis holds at most truncation length + traceback depth columns.
+      // Each time it fills, trace back from the best state and keep only the
+      // oldest truncation length decisions; the newest traceback depth
+      // decisions are not yet reliable and are revisited next time.
+      const unsigned int truncation = _constraint*5;
       Trellis trellis;
-      trellis.reserve(_constraint*5);
+      trellis.reserve(truncation + _tracebackDepth);
 
 //      std::vector<uint8_t> path_metrics(1 << (_constraint - 1), UCHAR_MAX);
 //      path_metrics.front() = 0;
@@ -300,7 +494,6 @@ namespace ex2 {
       }
       path_metrics[0] = 0;
 
-      const unsigned int poly_len = _poly.size();
       const uint8_t* encodedBits;
       // @note we never need to worry that stepping throught the encodedBits array
       // we will end up with too few bits in the last iteration because the
@@ -309,7 +502,7 @@ namespace ex2 {
       encodedBits = &bits[0];
       for (unsigned int i = 0; i < bits.size(); i += poly_len) {
         _update_path_metrics(encodedBits, poly_len, path_metrics, path_metrics_length, trellis);
-        if (trellis.size() >= trellis.capacity()) {
+        if (trellis.size() >= truncation + _tracebackDepth) {
 //          int state = std::min_element(path_metrics.begin(), path_metrics.end()) - path_metrics.begin();
           // Find the first index of the minimum element in the path_metrics
           int state = 0;
@@ -319,11 +512,13 @@ namespace ex2 {
             }
           }
           for (int i = trellis.size() - 1; i >= 0; i--) {
-            decoded[i + truncLength] = (state >> (_constraint - 2));
+            if (i < (int) truncation) {
+              decoded[i + truncLength] = (state >> (_constraint - 2));
+            }
             state = trellis[i][state];
-            trellis.pop_back();
           }
-          truncLength += (_constraint*5);
+          trellis.erase(trellis.begin(), trellis.begin() + truncation);
+          truncLength += truncation;
         }
         encodedBits += poly_len;
 
@@ -349,6 +544,217 @@ namespace ex2 {
       return decoded;
     } // decodeTruncated
 
+    void ViterbiCodec::_decodeBlock(const bitarr_t& bits, unsigned int startStep, unsigned int endStep,
+      bitarr_t& decoded) const
+    {
+      const unsigned int poly_len = _poly.size();
+      const unsigned int numSteps = bits.size() / poly_len;
+      const unsigned int firstStep = (startStep > _tracebackDepth) ? startStep - _tracebackDepth : 0;
+      const unsigned int lastStep = std::min(numSteps, endStep + _tracebackDepth);
+      const uint16_t path_metrics_length = (1 << (_constraint - 1));
+
+      // Only the first block knows the encoder starts in state 0; the others
+      // start with all states equally likely and rely on the warm-up steps.
+      std::vector<uint8_t> path_metrics(path_metrics_length, (firstStep == 0) ? UCHAR_MAX : 0);
+      path_metrics[0] = 0;
+      std::vector<uint8_t> temp_path_metrics(path_metrics_length);
+
+      // Flat trellis, one column of path_metrics_length entries per step
+      std::vector<uint8_t> trellis((lastStep - firstStep) * path_metrics_length);
+
+      for (unsigned int step = firstStep; step < lastStep; step++) {
+        _acs_step(&bits[step * poly_len], poly_len, path_metrics.data(), path_metrics_length,
+          temp_path_metrics.data(), &trellis[(step - firstStep) * path_metrics_length]);
+      }
+
+      // Find the first index of the minimum element in the path_metrics
+      int state = 0;
+      for (unsigned int i = 0; i < path_metrics_length; i++) {
+        if (path_metrics[i] < path_metrics[state]) {
+          state = i;
+        }
+      }
+      for (unsigned int step = lastStep; step-- > firstStep; ) {
+        if (step >= startStep && step < endStep) {
+          decoded[step] = (state >> (_constraint - 2));
+        }
+        state = trellis[(step - firstStep) * path_metrics_length + state];
+      }
+    } // _decodeBlock
+
+    ViterbiCodec::bitarr_t ViterbiCodec::decodeParallel(const bitarr_t& bits, unsigned int blockLength,
+      unsigned int numThreads) const
+    {
+      const unsigned int numSteps = bits.size() / _poly.size();
+
+      bitarr_t decoded(numSteps, 0);
+      if (numSteps == 0) {
+        return decoded;
+      }
+
+      if (blockLength == 0) {
+        blockLength = numSteps;
+      }
+      const unsigned int numBlocks = (numSteps + blockLength - 1) / blockLength;
+
+#ifdef OS_POSIX
+      if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+      }
+      numThreads = std::min(numThreads, numBlocks);
+
+      // Blocks are handed out in order from a shared counter; each writes a
+      // disjoint range of decoded, so no further synchronization is needed.
+      std::atomic<unsigned int> nextBlock(0);
+      auto worker = [&]() {
+        unsigned int block;
+        while ((block = nextBlock++) < numBlocks) {
+          unsigned int startStep = block * blockLength;
+          unsigned int endStep = std::min(numSteps, startStep + blockLength);
+          _decodeBlock(bits, startStep, endStep, decoded);
+        }
+      };
+
+      std::vector<std::thread> threads;
+      for (unsigned int t = 1; t < numThreads; t++) {
+        threads.emplace_back(worker);
+      }
+      worker();
+      for (auto& t : threads) {
+        t.join();
+      }
+#else
+      (void) numThreads;
+      for (unsigned int block = 0; block < numBlocks; block++) {
+        unsigned int startStep = block * blockLength;
+        unsigned int endStep = std::min(numSteps, startStep + blockLength);
+        _decodeBlock(bits, startStep, endStep, decoded);
+      }
+#endif
+
+      return decoded;
+    } // decodeParallel
+
+    std::vector<ViterbiCodec::bitarr_t> ViterbiCodec::decodeList(const bitarr_t& bits,
+      unsigned int listSize) const
+    {
+      const unsigned int poly_len = _poly.size();
+      const unsigned int numSteps = bits.size() / poly_len;
+      const unsigned int numStates = 1 << (_constraint - 1);
+      const unsigned int half = numStates / 2;
+      const int unreachable = INT_MAX / 2;
+
+      std::vector<bitarr_t> decodedList;
+      if (numSteps == 0) {
+        decodedList.emplace_back();
+        return decodedList;
+      }
+
+      // Full precision path metrics and, for every step and state, the
+      // surviving source state and how much worse the discarded one was
+      std::vector<int> path_metrics(numStates, unreachable);
+      std::vector<int> temp_path_metrics(numStates);
+      path_metrics[0] = 0;
+      std::vector<uint8_t> trellis(numSteps * numStates);
+      std::vector<uint16_t> gaps(numSteps * numStates);
+
+      for (unsigned int step = 0; step < numSteps; step++) {
+        const uint8_t *received = &bits[step * poly_len];
+        uint8_t symbolMetrics[1 << MAX_POLYNOMIALS];
+        for (unsigned int sym = 0; sym < (1u << poly_len); sym++) {
+          uint8_t distance = 0;
+          for (unsigned int j = 0; j < poly_len; j++) {
+            distance += (received[j] != ERASED_BIT) && (received[j] != ((sym >> j) & 0x01));
+          }
+          symbolMetrics[sym] = distance;
+        }
+
+        for (unsigned int i = 0; i < numStates; i++) {
+          unsigned int s = (i % half) << 1;
+          int pm1 = path_metrics[s] + symbolMetrics[_source_symbols[2 * i]];
+          int pm2 = path_metrics[s + 1] + symbolMetrics[_source_symbols[2 * i + 1]];
+          // Prefer the even source on a tie, as the ACS kernels do
+          bool odd = pm2 < pm1;
+          temp_path_metrics[i] = odd ? pm2 : pm1;
+          trellis[step * numStates + i] = s + odd;
+          int gap = odd ? pm1 - pm2 : pm2 - pm1;
+          gaps[step * numStates + i] = (std::max(pm1, pm2) >= unreachable) ? UINT16_MAX
+            : (uint16_t) std::min(gap, UINT16_MAX - 1);
+        }
+        path_metrics.swap(temp_path_metrics);
+      }
+
+      // Trace back from state at step, filling decoded up to and including step
+      auto traceback = [&](unsigned int step, unsigned int state, bitarr_t& decoded) {
+        for (unsigned int t = step + 1; t-- > 0; ) {
+          decoded[t] = (state >> (_constraint - 2));
+          state = trellis[t * numStates + state];
+        }
+      };
+
+      // Find the first index of the minimum element in the path_metrics
+      unsigned int best = 0;
+      for (unsigned int i = 0; i < numStates; i++) {
+        if (path_metrics[i] < path_metrics[best]) {
+          best = i;
+        }
+      }
+      decodedList.emplace_back(numSteps);
+      traceback(numSteps - 1, best, decodedList.front());
+
+      // The states on the best path
+      std::vector<uint8_t> bestStates(numSteps);
+      unsigned int state = best;
+      for (unsigned int t = numSteps; t-- > 0; ) {
+        bestStates[t] = state;
+        state = trellis[t * numStates + state];
+      }
+
+      // An alternative costs the extra metric of the discarded path where it
+      // merged with the best path, or of its final state
+      struct Alternative {
+        int cost;
+        unsigned int step;
+        unsigned int state;
+        bool merged;
+        bool operator<(const Alternative& other) const
+        {
+          return (cost != other.cost) ? cost < other.cost : step > other.step;
+        }
+      };
+      std::vector<Alternative> alternatives;
+      for (unsigned int i = 0; i < numStates; i++) {
+        if (i != best && path_metrics[i] < unreachable) {
+          alternatives.push_back({ path_metrics[i] - path_metrics[best], numSteps - 1, i, false });
+        }
+      }
+      for (unsigned int t = 1; t < numSteps; t++) {
+        uint16_t gap = gaps[t * numStates + bestStates[t]];
+        if (gap != UINT16_MAX) {
+          alternatives.push_back({ gap, t, bestStates[t], true });
+        }
+      }
+
+      listSize = std::min<size_t>(std::max(listSize, 1u) - 1, alternatives.size());
+      std::partial_sort(alternatives.begin(), alternatives.begin() + listSize, alternatives.end());
+      for (unsigned int a = 0; a < listSize; a++) {
+        const Alternative& alternative = alternatives[a];
+        decodedList.push_back(decodedList.front());
+        bitarr_t& decoded = decodedList.back();
+        if (alternative.merged) {
+          // Same as the best path from the merge on; before it, the survivor
+          // path of the discarded source state
+          unsigned int discarded = trellis[alternative.step * numStates + alternative.state] ^ 0x01;
+          traceback(alternative.step - 1, discarded, decoded);
+        }
+        else {
+          traceback(alternative.step, alternative.state, decoded);
+        }
+      }
+
+      return decodedList;
+    } // decodeList
+
   } /* namespace sdr */
 } /* namespace ex2 */
 
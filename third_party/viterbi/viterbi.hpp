@@ -26,6 +26,8 @@
 #include <utility>
 #include <vector>
 
+#include "bitBuffer.hpp"
+
 namespace ex2 {
   namespace sdr {
 
@@ -36,6 +38,14 @@ namespace ex2 {
 
       typedef std::vector<uint8_t> bitarr_t;
 
+      // A received bit with this value is treated as an erasure (e.g., a
+      // punctured bit) and contributes nothing to the branch metric.
+      static const uint8_t ERASED_BIT = 0x02;
+
+      // Limits imposed by the uint8_t trellis entries and symbol tables
+      static const int MAX_CONSTRAINT = 9;
+      static const unsigned int MAX_POLYNOMIALS = 8;
+
       // Note about Polynomial Descriptor of a Convolutional Encoder / Decoder.
       // A generator polymonial is built as follows: Build a binary number
       // representation by placing a 1 in each spot where a connection line from
@@ -59,11 +69,42 @@ namespace ex2 {
 
       bitarr_t encode(const bitarr_t& bits) const;
       std::vector<uint8_t> encodePacked(const std::vector<uint8_t>& bits) const;
+      // Encode packed bits of any length to packed bits, e.g., a 324 bit
+      // message; encodePacked is this for whole bytes
+      BitBuffer encodeBits(ConstBitSpan bits) const;
       bitarr_t decode(const bitarr_t& bits) const;
       bitarr_t decodeTruncated(const bitarr_t& bits) const;
+
+      // Decode a long input by splitting it into blocks of blockLength trellis
+      // steps that are decoded concurrently by up to numThreads threads (0
+      // means use the hardware concurrency). Each block starts tracebackDepth()
+      // steps early to let the path metrics converge from an unknown state,
+      // and runs tracebackDepth() steps past its end before tracing back, so
+      // the output matches decode() except where a block overlap is too short
+      // to resolve the survivor path. Without OS_POSIX the blocks are decoded
+      // serially and numThreads is ignored.
+      bitarr_t decodeParallel(const bitarr_t& bits, unsigned int blockLength = 4096,
+        unsigned int numThreads = 0) const;
+
+      // Decode to the most likely input and up to listSize - 1 alternatives,
+      // most likely first. Each alternative is the most likely path with one
+      // error event replaced by the path the decoder discarded where the two
+      // merged, or the best path ending in another state, so an outer check
+      // such as a CRC can pick the right input when the most likely is wrong.
+      std::vector<bitarr_t> decodeList(const bitarr_t& bits, unsigned int listSize) const;
       int constraint() const { return _constraint; }
+
+      // The number of trellis steps traced back before a decision is made in
+      // decodeTruncated. Defaults to 5 * constraint, which suits rate 1/2;
+      // punctured codes need more.
+      unsigned int tracebackDepth() const { return _tracebackDepth; }
+      void setTracebackDepth(unsigned int depth) { _tracebackDepth = depth; }
       const std::vector<int>& polynomials() const { return _poly; }
 
+      // The name of the add-compare-select implementation chosen for the host
+      // CPU, e.g., "avx2" or "scalar"
+      static const char *acsKernelName();
+
     private:
       // Suppose
       //
@@ -80,17 +121,6 @@ namespace ex2 {
 
       int _next_state(int current_state, int input) const;
 
-      int _branch_metric(const uint8_t* bits, uint8_t numBits, int source_state, int target_state) const;
-
-      // Given len(_poly) received bits, compute and returns path
-      // metric and its corresponding previous state.
-//      void _path_metric(const uint8_t* bits, uint8_t numBits,
-//        const std::vector<uint8_t>& prev_path_metrics, int state,
-//        uint8_t *newPathMetric, uint8_t *previousState) const;
-      void _path_metric(const uint8_t* bits, uint8_t numBits,
-        const uint8_t *prev_path_metrics, int state,
-        uint8_t *newPathMetric, uint8_t *previousState) const;
-
       // Given len(_poly) received bits, update path metrics of all states
       // in the current iteration, and append new traceback vector to trellis.
 //      void _update_path_metrics(const uint8_t* bits, uint8_t numBits, std::vector<uint8_t>& path_metrics,
@@ -98,8 +128,21 @@ namespace ex2 {
       void _update_path_metrics(const uint8_t* bits, uint8_t numBits, uint8_t *path_metrics, uint16_t path_metrics_length,
         Trellis& trellis) const;
 
+      // Add-compare-select for one trellis step using caller supplied scratch
+      // space so that it may be called concurrently. The work is done by the
+      // best ACS kernel for the host CPU; see cpuFeatures.hpp
+      void _acs_step(const uint8_t* bits, uint8_t numBits, uint8_t *path_metrics,
+        uint16_t path_metrics_length, uint8_t *temp_path_metrics, uint8_t *trellis_column) const;
+
+      // Decode trellis steps [startStep, endStep) of bits into decoded,
+      // including the warm-up and traceback overlap described for
+      // decodeParallel.
+      void _decodeBlock(const bitarr_t& bits, unsigned int startStep, unsigned int endStep,
+        bitarr_t& decoded) const;
+
       const int _constraint = 0;
       const std::vector<int> _poly;
+      unsigned int _tracebackDepth;
 
       // The output table.
       // The index is current input bit combined with previous inputs in the shift
@@ -111,6 +154,11 @@ namespace ex2 {
       uint16_t k_precomputedShiftRegOutputsRows;
       uint16_t k_precomputedShiftRegOutputsCols;
 
+      // _source_symbols[2 * s + b] is the encoder output symbol, bit j from
+      // polynomial j, on the branch into state s from the source state whose
+      // lsb is b
+      std::vector<uint8_t> _source_symbols;
+
       // some working variables
 //      std::vector<uint8_t> *_temp_path_metrics;
       uint8_t *_temp_path_metrics;
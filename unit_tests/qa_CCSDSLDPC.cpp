@@ -0,0 +1,173 @@
+/*!
+ * @file qa_CCSDSLDPC.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the CCSDS AR4JA LDPC codec.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "CCSDSLDPC.hpp"
+#include "cpuFeatures.hpp"
+
+using namespace std;
+using namespace ex2::sdr;
+
+#include "gtest/gtest.h"
+
+#define QA_CCSDSLDPC_DEBUG 0 // set to 1 for debugging output
+
+static const ErrorCorrection::ErrorCorrectionScheme ar4jaSchemes[] = {
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_1280,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_1536,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_2048
+};
+
+/*!
+ * @brief Confirm the encoder makes systematic codewords that satisfy every
+ * parity check, including the punctured bits
+ */
+TEST(CCSDSLDPC, Encode)
+{
+  const uint16_t submatrixSizes[] = { 128, 256, 512 };
+
+  std::srand(32);
+  for (int s = 0; s < 3; s++) {
+    FEC *fec = FEC::makeFECCodec(ar4jaSchemes[s]);
+    ASSERT_NE(fec, nullptr);
+    CCSDSLDPC *codec = dynamic_cast<CCSDSLDPC *>(fec);
+    ASSERT_NE(codec, nullptr);
+    ASSERT_EQ(codec->submatrixSize(), submatrixSizes[s]);
+
+    ErrorCorrection ec(ar4jaSchemes[s], 8192);
+    ASSERT_EQ(ec.getMessageLen(), 1024u);
+
+    std::vector<uint8_t> payload(ec.getMessageLen() / 8);
+    for (int trial = 0; trial < 10; trial++) {
+      for (auto& b : payload) {
+        b = std::rand() & 0xFF;
+      }
+      std::vector<uint8_t> codeword = codec->encode(payload);
+      ASSERT_EQ(codeword.size(), ec.getCodewordLen() / 8);
+      ASSERT_TRUE(std::equal(payload.begin(), payload.end(), codeword.begin()));
+
+      std::vector<uint8_t> full = codec->lastFullCodeword();
+      ASSERT_EQ(full.size(), (ec.getCodewordLen() + codec->submatrixSize()) / 8);
+      ASSERT_TRUE(std::equal(codeword.begin(), codeword.end(), full.begin()));
+      ASSERT_EQ(codec->unsatisfiedChecks(full), 0u) << ErrorCorrection::ErrorCorrectionName(ar4jaSchemes[s]);
+
+      // Every bit takes part in at least one check
+      uint32_t b = std::rand() % (full.size() * 8);
+      full[b / 8] ^= 0x80 >> (b % 8);
+      ASSERT_GT(codec->unsatisfiedChecks(full), 0u);
+    }
+
+    payload.pop_back();
+    ASSERT_THROW(codec->encode(payload), FECException);
+    delete fec;
+  }
+}
+
+/*!
+ * @brief Confirm hard decision decoding corrects bit errors and recovers the
+ * punctured bits
+ */
+TEST(CCSDSLDPC, DecodeHard)
+{
+  std::srand(32);
+  for (auto scheme : ar4jaSchemes) {
+    CCSDSLDPC codec(scheme);
+    ErrorCorrection ec(scheme, 8192);
+
+    std::vector<uint8_t> payload(ec.getMessageLen() / 8);
+    for (int trial = 0; trial < 10; trial++) {
+      for (auto& b : payload) {
+        b = std::rand() & 0xFF;
+      }
+      std::vector<uint8_t> codeword = codec.encode(payload);
+
+      // Flip 2 distinct bits
+      uint32_t e1 = std::rand() % (codeword.size() * 8);
+      uint32_t e2 = (e1 + 1 + std::rand() % (codeword.size() * 8 - 1)) % (codeword.size() * 8);
+      codeword[e1 / 8] ^= 0x80 >> (e1 % 8);
+      codeword[e2 / 8] ^= 0x80 >> (e2 % 8);
+
+      std::vector<uint8_t> decoded;
+      uint32_t corrected = codec.decode(codeword, 5.0, decoded);
+      ASSERT_TRUE(codec.lastConverged()) << ErrorCorrection::ErrorCorrectionName(scheme);
+      ASSERT_EQ(corrected, 2u);
+      ASSERT_EQ(decoded, payload);
+    }
+
+    std::vector<uint8_t> codeword = codec.encode(payload);
+    codeword.pop_back();
+    std::vector<uint8_t> decoded;
+    ASSERT_EQ(codec.decode(codeword, 5.0, decoded), UINT32_MAX);
+  }
+}
+
+/*!
+ * @brief Confirm soft decision decoding near the waterfall, and that every
+ * min-sum kernel gives the same result
+ */
+TEST(CCSDSLDPC, DecodeLLR)
+{
+  // Eb/N0 in dB where the frame error rate is a few percent or less
+  const float ebN0dB[] = { 3.5f, 2.5f, 2.0f };
+
+  std::mt19937 gen(32);
+  for (int s = 0; s < 3; s++) {
+    CCSDSLDPC codec(ar4jaSchemes[s]);
+    ErrorCorrection ec(ar4jaSchemes[s], 8192);
+    std::vector<uint8_t> payload(ec.getMessageLen() / 8);
+
+    const float rate = (float) ec.getMessageLen() / (float) ec.getCodewordLen();
+    const float esN0 = std::pow(10.0f, ebN0dB[s] / 10.0f) * rate;
+    const float sigma = std::sqrt(1.0f / (2.0f * esN0));
+    std::normal_distribution<float> noise(0.0f, sigma);
+
+    uint32_t frameErrors = 0;
+    for (int trial = 0; trial < 50; trial++) {
+      for (auto& b : payload) {
+        b = gen() & 0xFF;
+      }
+      std::vector<uint8_t> codeword = codec.encode(payload);
+      std::vector<float> llrs(codeword.size() * 8);
+      for (uint32_t i = 0; i < llrs.size(); i++) {
+        float symbol = ((codeword[i / 8] >> (7 - (i % 8))) & 0x01) ? -1.0f : 1.0f;
+        llrs[i] = 2.0f * (symbol + noise(gen)) / (sigma * sigma);
+      }
+
+      std::vector<uint8_t> decoded;
+      CPUFeatures::setMask(CPUFeatures::NONE);
+      uint32_t corrected = codec.decodeLLR(llrs, decoded);
+      uint32_t iterations = codec.lastIterations();
+      frameErrors += (decoded != payload);
+
+      CPUFeatures::setMask(CPUFeatures::ALL);
+      std::vector<uint8_t> decodedSIMD;
+      ASSERT_EQ(codec.decodeLLR(llrs, decodedSIMD), corrected);
+      ASSERT_EQ(codec.lastIterations(), iterations);
+      ASSERT_EQ(decodedSIMD, decoded);
+    }
+#if QA_CCSDSLDPC_DEBUG
+    printf("%s frame errors %u\n", ErrorCorrection::ErrorCorrectionName(ar4jaSchemes[s]).c_str(),
+      frameErrors);
+#endif
+    EXPECT_LE(frameErrors, 2u);
+
+    std::vector<float> llrs(ec.getCodewordLen() - 1);
+    std::vector<uint8_t> decoded;
+    ASSERT_EQ(codec.decodeLLR(llrs, decoded), UINT32_MAX);
+  }
+}
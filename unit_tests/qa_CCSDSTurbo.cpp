@@ -0,0 +1,190 @@
+/*!
+ * @file qa_CCSDSTurbo.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the CCSDS Turbo codec.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "CCSDSTurbo.hpp"
+#include "cpuFeatures.hpp"
+
+using namespace std;
+using namespace ex2::sdr;
+
+#include "gtest/gtest.h"
+
+#define QA_CCSDS_TURBO_DEBUG 0 // set to 1 for debugging output
+
+static const ErrorCorrection::ErrorCorrectionScheme turboSchemes[] = {
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_2,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_3,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_4,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_6,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_2,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_3,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_4,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_3568_R_1_6,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_2,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_3,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_4,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_6,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_2,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_3,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_4,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_6
+};
+
+/*!
+ * @brief Confirm the permutation, the codeword lengths and that the codewords
+ * are systematic
+ */
+TEST(CCSDSTurbo, Encode)
+{
+  const uint16_t rateInverse[] = { 2, 3, 4, 6 };
+
+  std::srand(35);
+  for (int s = 0; s < 16; s++) {
+    FEC *fec = FEC::makeFECCodec(turboSchemes[s]);
+    ASSERT_NE(fec, nullptr);
+    CCSDSTurbo *codec = dynamic_cast<CCSDSTurbo *>(fec);
+    ASSERT_NE(codec, nullptr);
+
+    ErrorCorrection ec(turboSchemes[s], 8192);
+    const uint16_t k = codec->informationLen();
+    const uint16_t n = rateInverse[s % 4];
+    ASSERT_EQ(k, ec.getMessageLen());
+    ASSERT_EQ(codec->codewordBits(), (k + 4u) * n);
+    ASSERT_EQ(ec.getCodewordLen(), (codec->codewordBits() + 7) / 8 * 8);
+
+    std::vector<bool> seen(k, false);
+    for (uint16_t p : codec->permutation()) {
+      ASSERT_LT(p, k);
+      ASSERT_FALSE(seen[p]);
+      seen[p] = true;
+    }
+
+    std::vector<uint8_t> payload(k / 8);
+    for (auto& b : payload) {
+      b = std::rand() & 0xFF;
+    }
+    std::vector<uint8_t> codeword = codec->encode(payload);
+    ASSERT_EQ(codeword.size(), ec.getCodewordLen() / 8);
+    for (uint32_t t = 0; t < k; t++) {
+      uint32_t i = t * n;
+      ASSERT_EQ((codeword[i / 8] >> (7 - i % 8)) & 1, (payload[t / 8] >> (7 - t % 8)) & 1);
+    }
+
+    payload.pop_back();
+    ASSERT_THROW(codec->encode(payload), FECException);
+    delete fec;
+  }
+}
+
+/*!
+ * @brief Confirm hard decision decoding corrects scattered bit errors
+ */
+TEST(CCSDSTurbo, DecodeHard)
+{
+  std::srand(35);
+  for (auto scheme : turboSchemes) {
+    CCSDSTurbo codec(scheme);
+    std::vector<uint8_t> payload(codec.informationLen() / 8);
+    for (int trial = 0; trial < 2; trial++) {
+      for (auto& b : payload) {
+        b = std::rand() & 0xFF;
+      }
+      std::vector<uint8_t> codeword = codec.encode(payload);
+
+      // One error per 200 codeword bits, at least 100 bits apart
+      uint32_t errors = 0;
+      for (uint32_t i = std::rand() % 100; i < codec.codewordBits(); i += 100 + std::rand() % 200) {
+        codeword[i / 8] ^= 0x80 >> (i % 8);
+        errors++;
+      }
+
+      std::vector<uint8_t> decoded;
+      ASSERT_EQ(codec.decode(codeword, 5.0, decoded), errors) << ErrorCorrection::ErrorCorrectionName(scheme);
+      ASSERT_TRUE(codec.lastConverged());
+      ASSERT_EQ(decoded, payload);
+    }
+
+    std::vector<uint8_t> codeword = codec.encode(payload);
+    codeword.pop_back();
+    std::vector<uint8_t> decoded;
+    ASSERT_EQ(codec.decode(codeword, 5.0, decoded), UINT32_MAX);
+  }
+}
+
+/*!
+ * @brief Confirm soft decision decoding at low SNR, and that every
+ * max-log-MAP kernel gives the same result
+ */
+TEST(CCSDSTurbo, DecodeLLR)
+{
+  // Eb/N0 in dB where the frame error rate is a few percent or less
+  const ErrorCorrection::ErrorCorrectionScheme schemes[] = {
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_2,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_6,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_8920_R_1_3
+  };
+  const float ebN0dB[] = { 1.5f, 0.5f, 1.0f };
+
+  std::mt19937 gen(35);
+  for (int s = 0; s < 3; s++) {
+    CCSDSTurbo codec(schemes[s]);
+    std::vector<uint8_t> payload(codec.informationLen() / 8);
+
+    const float rate = (float) codec.informationLen() / (float) codec.codewordBits();
+    const float esN0 = std::pow(10.0f, ebN0dB[s] / 10.0f) * rate;
+    const float sigma = std::sqrt(1.0f / (2.0f * esN0));
+    std::normal_distribution<float> noise(0.0f, sigma);
+
+    uint32_t frameErrors = 0;
+    uint32_t iterations = 0;
+    for (int trial = 0; trial < 20; trial++) {
+      for (auto& b : payload) {
+        b = gen() & 0xFF;
+      }
+      std::vector<uint8_t> codeword = codec.encode(payload);
+      std::vector<float> llrs(codec.codewordBits());
+      for (uint32_t i = 0; i < llrs.size(); i++) {
+        float symbol = ((codeword[i / 8] >> (7 - (i % 8))) & 0x01) ? -1.0f : 1.0f;
+        llrs[i] = 2.0f * (symbol + noise(gen)) / (sigma * sigma);
+      }
+
+      std::vector<uint8_t> decoded;
+      CPUFeatures::setMask(CPUFeatures::NONE);
+      uint32_t corrected = codec.decodeLLR(llrs, decoded);
+      uint32_t scalarIterations = codec.lastIterations();
+      frameErrors += (decoded != payload);
+      iterations += scalarIterations;
+
+      CPUFeatures::setMask(CPUFeatures::ALL);
+      std::vector<uint8_t> decodedSIMD;
+      ASSERT_EQ(codec.decodeLLR(llrs, decodedSIMD), corrected) << CCSDSTurbo::sisoKernelName();
+      ASSERT_EQ(codec.lastIterations(), scalarIterations);
+      ASSERT_EQ(decodedSIMD, decoded);
+    }
+#if QA_CCSDS_TURBO_DEBUG
+    printf("%s frame errors %u mean iterations %.1f\n", ErrorCorrection::ErrorCorrectionName(schemes[s]).c_str(),
+      frameErrors, iterations / 20.0);
+#endif
+    EXPECT_LE(frameErrors, 1u);
+
+    std::vector<float> llrs(codec.codewordBits() + 1);
+    std::vector<uint8_t> decoded;
+    ASSERT_EQ(codec.decodeLLR(llrs, decoded), UINT32_MAX);
+  }
+}
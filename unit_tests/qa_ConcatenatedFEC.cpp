@@ -0,0 +1,104 @@
+/*!
+ * @file qa_ConcatenatedFEC.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the concatenated FEC codec.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "ConcatenatedFEC.hpp"
+#include "mpdu.hpp"
+
+using namespace std;
+using namespace ex2::sdr;
+
+#include "gtest/gtest.h"
+
+#define QA_CONCATENATED_FEC_DEBUG 0 // set to 1 for debugging output
+
+static const ErrorCorrection::ErrorCorrectionScheme concatenatedScheme =
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2;
+
+/*!
+ * @brief Confirm the scheme lengths and an error free round trip
+ */
+TEST(ConcatenatedFEC, EncodeDecode)
+{
+  ErrorCorrection ec(concatenatedScheme, MPDU::maxMTU() * 8);
+  ASSERT_EQ(ec.getMessageLen(), 223 * 4 * 8u);
+  ASSERT_EQ(ec.getCodewordLen(), 255 * 4 * 2 * 8u);
+
+  FEC *fec = FEC::makeFECCodec(concatenatedScheme);
+  ASSERT_NE(fec, nullptr);
+  ConcatenatedFEC *codec = dynamic_cast<ConcatenatedFEC *>(fec);
+  ASSERT_NE(codec, nullptr);
+  ASSERT_EQ(codec->interleavingDepth(), 4);
+  ASSERT_EQ(codec->messageLen(), ec.getMessageLen() / 8);
+
+  std::srand(34);
+  std::vector<uint8_t> payload(ec.getMessageLen() / 8);
+  for (int trial = 0; trial < 3; trial++) {
+    for (auto& b : payload) {
+      b = std::rand() & 0xFF;
+    }
+    std::vector<uint8_t> codeword = fec->encode(payload);
+    ASSERT_EQ(codeword.size(), ec.getCodewordLen() / 8);
+
+    std::vector<uint8_t> decoded;
+    ASSERT_EQ(fec->decode(codeword, 100.0, decoded), 0u);
+    ASSERT_EQ(decoded, payload);
+  }
+
+  payload.pop_back();
+  ASSERT_THROW(fec->encode(payload), FECException);
+  delete fec;
+}
+
+/*!
+ * @brief Confirm bursts that the inner code cannot correct are spread over
+ * the outer codewords and corrected by them
+ */
+TEST(ConcatenatedFEC, DecodeBursts)
+{
+  ConcatenatedFEC codec(concatenatedScheme);
+  const uint32_t messageLen = codec.messageLen();
+
+  std::srand(34);
+  std::vector<uint8_t> payload(messageLen);
+  for (int trial = 0; trial < 5; trial++) {
+    for (auto& b : payload) {
+      b = std::rand() & 0xFF;
+    }
+    std::vector<uint8_t> codeword = codec.encode(payload);
+
+    // Two bursts of 24 inverted inner codeword bytes, far beyond what the
+    // Viterbi decoder can correct, and sparse single bit errors it can
+    for (int burst = 0; burst < 2; burst++) {
+      uint32_t start = (burst * codeword.size() / 2) + std::rand() % (codeword.size() / 2 - 24);
+      for (uint32_t i = start; i < start + 24; i++) {
+        codeword[i] = ~codeword[i];
+      }
+    }
+    for (uint32_t i = 37; i < codeword.size(); i += 101) {
+      codeword[i] ^= 0x10;
+    }
+
+    std::vector<uint8_t> decoded;
+    uint32_t corrected = codec.decode(codeword, 100.0, decoded);
+#if QA_CONCATENATED_FEC_DEBUG
+    printf("trial %d corrected %u outer bits\n", trial, corrected);
+#endif
+    ASSERT_GT(corrected, 0u);
+    ASSERT_NE(corrected, UINT32_MAX);
+    ASSERT_EQ(decoded, payload);
+  }
+}
@@ -12,6 +12,7 @@
  * This software may not be modified or distributed in any form, except as described in the LICENSE file.
  */
 
+#include <cmath>
 #include <cstdio>
 #include <iostream>
 #include <random>
@@ -219,64 +220,44 @@ check_decoder_ber (
 TEST(convolutional_codec_hd, constructor_accessor )
 {
   /* ----------------------------------------------------------------------
-   * Confirm rate 2/3, 3/4, 5/6, and 7/8 CCSDS cannot be instantiated.
-   * Confirm rate 1/2 CCSDS can be instantiated.
+   * Confirm all the CCSDS rates can be instantiated and that a
+   * non-convolutional scheme cannot.
    * ----------------------------------------------------------------------
    */
   ConvolutionalCodecHD *ccHDCodec = 0;
 
   try {
-    ccHDCodec = new ConvolutionalCodecHD(ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_2_3);
-    FAIL() << "Should not be able to instantiate FEC for CCSDS_CONVOLUTIONAL_CODING_R_2_3.";
+    ccHDCodec = new ConvolutionalCodecHD(ErrorCorrection::ErrorCorrectionScheme::NO_FEC);
+    FAIL() << "Should not be able to instantiate FEC for NO_FEC.";
   }
-  catch (FECException *e) {
+  catch (FECException &e) {
     if (ccHDCodec != NULL) {
       delete ccHDCodec;
+      ccHDCodec = 0;
     }
-    delete e;
   }
-  try {
-    ccHDCodec = new ConvolutionalCodecHD(ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_3_4);
-    FAIL() << "Should not be able to instantiate FEC for CCSDS_CONVOLUTIONAL_CODING_R_3_4.";
-  }
-  catch (FECException *e) {
-    if (ccHDCodec != NULL) {
-      delete ccHDCodec;
+
+  ErrorCorrection::ErrorCorrectionScheme schemes[] = {
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_1_2,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_2_3,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_3_4,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_5_6,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_7_8
+  };
+
+  for (ErrorCorrection::ErrorCorrectionScheme ecs : schemes) {
+    try {
+      ccHDCodec = new ConvolutionalCodecHD(ecs);
     }
-    delete e;
-  }
-  try {
-    ccHDCodec = new ConvolutionalCodecHD(ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_5_6);
-    FAIL() << "Should not be able to instantiate FEC for CCSDS_CONVOLUTIONAL_CODING_R_5_6.";
-  }
-  catch (FECException *e) {
-    if (ccHDCodec != NULL) {
-      delete ccHDCodec;
+    catch (FECException &e) {
+      FAIL() << "Should be able to instantiate FEC for " << ErrorCorrection::ErrorCorrectionName(ecs);
     }
-    delete e;
-  }
-  try {
-    ccHDCodec = new ConvolutionalCodecHD(ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_7_8);
-    FAIL() << "Should not be able to instantiate FEC for CCSDS_CONVOLUTIONAL_CODING_R_7_8.";
-  }
-  catch (FECException *e) {
+
     if (ccHDCodec != NULL) {
+      // Other than the encode and decode methods, there are no other methods to test.
       delete ccHDCodec;
+      ccHDCodec = 0;
     }
-    delete e;
-  }
-
-  try {
-    ccHDCodec = new ConvolutionalCodecHD(ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_1_2);
-  }
-  catch (FECException *e) {
-    FAIL() << "Should be able to instantiate FEC for CCSDS_CONVOLUTIONAL_CODING_R_1_2.";
-    delete e;
-  }
-
-  if (ccHDCodec != NULL) {
-    // Other than the encode and decode methods, there are no other methods to test.
-    delete ccHDCodec;
   }
 }
 
@@ -362,7 +343,7 @@ TEST(convolutional_codec_hd, r_1_2_simple_encode_decode_no_errs )
     delete ccHDCodec;
 
   }
-  catch (FECException *e) {
+  catch (FECException &e) {
     FAIL() << "Should be able to instantiate FEC for CCSDS_CONVOLUTIONAL_CODING_R_1_2.";
   }
 
@@ -428,3 +409,133 @@ TEST(convolutional_codec_hd, r_1_2_ber_match )
 
 }
 
+TEST(convolutional_codec_hd, punctured_encode_decode_no_errs )
+{
+  /* ----------------------------------------------------------------------
+   * Create the punctured rate CCSDS codecs and test encode and decode with no
+   * errors. Check that a message of the length defined by the ErrorCorrection
+   * object encodes to exactly the codeword length so the MAC can split
+   * received data back into codewords.
+   * ----------------------------------------------------------------------
+   */
+  ErrorCorrection::ErrorCorrectionScheme schemes[] = {
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_2_3,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_3_4,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_5_6,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_7_8
+  };
+  double rates[] = { 2.0/3.0, 3.0/4.0, 5.0/6.0, 7.0/8.0 };
+
+  uint16_t const numPackets = 6;
+  uint16_t packetDataLengths[numPackets] = {1, 10, 103, 119, 358, 4095};
+
+  for (int s = 0; s < 4; s++) {
+    ConvolutionalCodecHD ccHDCodec(schemes[s]);
+    ErrorCorrection ec(schemes[s], MPDU::maxMTU()*8);
+    std::string ecn = ec.ErrorCorrectionName(schemes[s]);
+
+    // The codeword for a full message must fit in an MPDU
+    std::vector<uint8_t> message(ec.getMessageLen()/8, 0xA5);
+    std::vector<uint8_t> codeword = ccHDCodec.encode(message);
+    ASSERT_TRUE(codeword.size() == ec.getCodewordLen()/8) << "codeword length mismatch for " << ecn;
+    ASSERT_TRUE(codeword.size() <= MPDU::maxMTU()) << "codeword does not fit in an MPDU for " << ecn;
+
+    std::vector<uint8_t> packet;
+    for (uint16_t currentPacket = 0; currentPacket < numPackets; currentPacket++) {
+
+      packet.resize(0);
+
+      // Set the payload to readable ASCII
+      for (unsigned long i = 0; i < packetDataLengths[currentPacket]; i++) {
+        packet.push_back( (i % 79) + 0x30 ); // ASCII numbers through to ~
+      }
+
+      std::vector<uint8_t> encodedPayload = ccHDCodec.encode(packet);
+
+      // Punctured codeword length is the message length divided by the rate,
+      // rounded up to whole bytes
+      uint32_t expectedBits = (uint32_t) std::ceil(packet.size() * 8 / rates[s] - 1e-9);
+      ASSERT_TRUE(encodedPayload.size() == (expectedBits + 7) / 8) << "encoded payload length wrong for " << ecn;
+
+      // Decode the encoded payload
+      std::vector<uint8_t> dPayload;
+      uint32_t bitErrors = ccHDCodec.decode(encodedPayload, 100.0, dPayload);
+      ASSERT_TRUE(bitErrors == 0) << "Bit error count > 0; Convolutional coding does not proivide this number...";
+
+      // Check the decoded and original messages match
+      ASSERT_TRUE(packet.size() == dPayload.size()) << "decoded payload size does not match input payload size for " << ecn;
+      bool same = true;
+      for (unsigned long i = 0; i < packet.size(); i++) {
+        same = same & (packet[i] == dPayload[i]);
+      }
+      ASSERT_TRUE(same) << "decoded payload does not match input payload for " << ecn;
+
+    } // for various packet lengths
+  } // for punctured schemes
+}
+
+TEST(convolutional_codec_hd, punctured_ber_match )
+{
+  /* ----------------------------------------------------------------------
+   * Check the punctured CCSDS codecs correct errors. At 9 dB SNR the channel
+   * bit error rate is about 3e-5 and all rates should better 1e-4 after
+   * decoding, even with the unterminated trellis at the end of each codeword.
+   * At 0 dB SNR they should all fail to reach it.
+   * ----------------------------------------------------------------------
+   */
+  ErrorCorrection::ErrorCorrectionScheme schemes[] = {
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_2_3,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_3_4,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_5_6,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_7_8
+  };
+
+  for (ErrorCorrection::ErrorCorrectionScheme ecs : schemes) {
+    check_decoder_ber (ecs,
+      9 /* dB */,
+      0.0001,
+      false,
+      10.0);
+    check_decoder_ber (ecs,
+      0 /* dB */,
+      0.0001,
+      true,
+      10.0);
+  }
+}
+
+TEST(convolutional_codec_hd, decode_list )
+{
+  /* ----------------------------------------------------------------------
+   * Check the list decoder gives the message first, then distinct
+   * alternatives of the same length, for the mother code and a punctured
+   * code
+   * ----------------------------------------------------------------------
+   */
+  ErrorCorrection::ErrorCorrectionScheme schemes[] = {
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_1_2,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_3_4
+  };
+
+  for (auto scheme : schemes) {
+    ConvolutionalCodecHD ccHDCodec(scheme);
+    ASSERT_TRUE(ccHDCodec.supportsListDecoding());
+    ErrorCorrection ec(scheme, MPDU::maxMTU()*8);
+
+    std::vector<uint8_t> message(ec.getMessageLen()/8);
+    for (unsigned long i = 0; i < message.size(); i++) {
+      message[i] = (i % 79) + 0x30;
+    }
+    std::vector<uint8_t> codeword = ccHDCodec.encode(message);
+
+    std::vector<std::vector<uint8_t>> decodedPayloads;
+    uint32_t bitErrors = ccHDCodec.decodeList(codeword, 100.0, 4, decodedPayloads);
+    ASSERT_EQ(bitErrors, 0u);
+    ASSERT_EQ(decodedPayloads.size(), 4u);
+    ASSERT_EQ(decodedPayloads[0], message);
+    for (size_t a = 1; a < decodedPayloads.size(); a++) {
+      ASSERT_EQ(decodedPayloads[a].size(), message.size());
+      ASSERT_NE(decodedPayloads[a], message);
+    }
+  }
+}
@@ -0,0 +1,402 @@
+/*!
+ * @file qa_QCLDPC.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the IEEE 802.11n QC-LDPC codec.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "QCLDPC.hpp"
+#include "QCLDPCFixedPoint.hpp"
+#include "QCLDPCMatrices.hpp"
+#include "cpuFeatures.hpp"
+#include "mpdu.hpp"
+
+using namespace std;
+using namespace ex2::sdr;
+
+#include "gtest/gtest.h"
+
+#define QA_QCLDPC_DEBUG 0 // set to 1 for debugging output
+
+static const ErrorCorrection::ErrorCorrectionScheme qcldpcSchemes[] = {
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_648_R_1_2,
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_648_R_2_3,
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_648_R_3_4,
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_648_R_5_6,
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1296_R_1_2,
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1296_R_2_3,
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1296_R_3_4,
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1296_R_5_6,
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1944_R_1_2,
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1944_R_2_3,
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1944_R_3_4,
+  ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1944_R_5_6
+};
+
+static uint8_t codewordBit(const std::vector<uint8_t>& codeword, uint32_t i)
+{
+  return (codeword[i / 8] >> (7 - (i % 8))) & 0x01;
+}
+
+/*!
+ * @brief Count the unsatisfied parity checks by expanding the base matrix one
+ * bit at a time, independent of the encoder's block operations
+ */
+static uint32_t unsatisfiedChecks(const QCLDPCBaseMatrix& H, const std::vector<uint8_t>& codeword)
+{
+  uint32_t unsatisfied = 0;
+  for (uint32_t r = 0; r < H.rows; r++) {
+    for (uint32_t i = 0; i < H.z; i++) {
+      uint8_t parity = 0;
+      for (uint32_t c = 0; c < QCLDPCBaseMatrix::BLOCK_COLS; c++) {
+        int8_t h = H.shift(r, c);
+        if (h >= 0) {
+          // Row i of P^h has its 1 in column (i + h) mod z
+          parity ^= codewordBit(codeword, c * H.z + (i + h) % H.z);
+        }
+      }
+      unsatisfied += parity;
+    }
+  }
+  return unsatisfied;
+}
+
+/*!
+ * @brief Confirm the base matrices have the 802.11n structure the encoder
+ * relies on
+ */
+TEST(QCLDPC, BaseMatrices)
+{
+  for (auto scheme : qcldpcSchemes) {
+    const QCLDPCBaseMatrix& H = QCLDPCBaseMatrix::forScheme(scheme);
+    ErrorCorrection ec(scheme, MPDU::maxMTU() * 8);
+
+    ASSERT_EQ(H.n, ec.getCodewordLen());
+    ASSERT_EQ(H.n, H.z * QCLDPCBaseMatrix::BLOCK_COLS);
+    ASSERT_EQ(ec.getMessageLen(), H.infoCols() * H.z);
+
+    // First parity column is 1, 0 somewhere in between, and 1
+    const uint16_t kb = H.infoCols();
+    uint32_t weight = 0;
+    for (uint16_t r = 0; r < H.rows; r++) {
+      weight += (H.shift(r, kb) >= 0);
+    }
+    ASSERT_EQ(weight, 3);
+    ASSERT_EQ(H.shift(0, kb), 1);
+    ASSERT_EQ(H.shift(H.rows - 1, kb), 1);
+
+    // The rest of the parity part is the dual diagonal of identities
+    for (uint16_t r = 0; r < H.rows; r++) {
+      for (uint16_t c = 1; c < H.rows; c++) {
+        int8_t expected = (r == c - 1 || r == c) ? 0 : -1;
+        ASSERT_EQ(H.shift(r, kb + c), expected);
+      }
+    }
+  }
+
+  ASSERT_THROW(QCLDPCBaseMatrix::forScheme(ErrorCorrection::ErrorCorrectionScheme::NO_FEC),
+    FECException);
+}
+
+/*!
+ * @brief Confirm random payloads encode to systematic codewords that satisfy
+ * every parity check
+ */
+TEST(QCLDPC, Encode)
+{
+  std::srand(29);
+  for (auto scheme : qcldpcSchemes) {
+    QCLDPC codec(scheme);
+    const QCLDPCBaseMatrix& H = QCLDPCBaseMatrix::forScheme(scheme);
+    ErrorCorrection ec(scheme, MPDU::maxMTU() * 8);
+
+#if QA_QCLDPC_DEBUG
+    printf("%s\n", ErrorCorrection::ErrorCorrectionName(scheme).c_str());
+#endif
+
+    std::vector<uint8_t> payload(ec.getMessageLen() / 8);
+
+    // All zeros encodes to all zeros
+    std::vector<uint8_t> codeword = codec.encode(payload);
+    ASSERT_EQ(codeword.size(), ec.getCodewordLen() / 8);
+    for (auto b : codeword) {
+      ASSERT_EQ(b, 0);
+    }
+
+    for (int trial = 0; trial < 20; trial++) {
+      for (auto& b : payload) {
+        b = std::rand() & 0xFF;
+      }
+      codeword = codec.encode(payload);
+      ASSERT_EQ(codeword.size(), ec.getCodewordLen() / 8);
+
+      // Systematic, with the message bits beyond the payload zero
+      for (uint32_t i = 0; i < payload.size(); i++) {
+        ASSERT_EQ(codeword[i], payload[i]);
+      }
+      for (uint32_t i = payload.size() * 8; i < ec.getMessageLen(); i++) {
+        ASSERT_EQ(codewordBit(codeword, i), 0);
+      }
+
+      ASSERT_EQ(unsatisfiedChecks(H, codeword), 0u);
+
+      std::vector<uint8_t> decoded;
+      codec.decode(codeword, 0.0, decoded);
+      ASSERT_EQ(decoded, payload);
+    }
+
+    payload.push_back(0);
+    ASSERT_THROW(codec.encode(payload), FECException);
+  }
+}
+
+/*!
+ * @brief Confirm hard decision decoding corrects a few bit errors and reports
+ * how many it corrected
+ */
+TEST(QCLDPC, DecodeHard)
+{
+  std::srand(30);
+  for (auto scheme : qcldpcSchemes) {
+    QCLDPC codec(scheme);
+    ErrorCorrection ec(scheme, MPDU::maxMTU() * 8);
+
+    std::vector<uint8_t> payload(ec.getMessageLen() / 8);
+    for (int trial = 0; trial < 10; trial++) {
+      for (auto& b : payload) {
+        b = std::rand() & 0xFF;
+      }
+      std::vector<uint8_t> codeword = codec.encode(payload);
+
+      // Flip 2 distinct bits in the payload part
+      uint32_t e1 = std::rand() % (payload.size() * 8);
+      uint32_t e2 = (e1 + 1 + std::rand() % (payload.size() * 8 - 1)) % (payload.size() * 8);
+      codeword[e1 / 8] ^= 0x80 >> (e1 % 8);
+      codeword[e2 / 8] ^= 0x80 >> (e2 % 8);
+
+      std::vector<uint8_t> decoded;
+      uint32_t corrected = codec.decode(codeword, 5.0, decoded);
+      ASSERT_TRUE(codec.lastConverged()) << ErrorCorrection::ErrorCorrectionName(scheme);
+      ASSERT_EQ(corrected, 2u);
+      ASSERT_EQ(decoded, payload);
+    }
+
+    // Error free codewords need no iterations
+    std::vector<uint8_t> codeword = codec.encode(payload);
+    std::vector<uint8_t> decoded;
+    ASSERT_EQ(codec.decode(codeword, 5.0, decoded), 0u);
+    ASSERT_EQ(codec.lastIterations(), 0u);
+    ASSERT_EQ(decoded, payload);
+
+    codeword.pop_back();
+    ASSERT_EQ(codec.decode(codeword, 5.0, decoded), UINT32_MAX);
+  }
+}
+
+/*!
+ * @brief Make BPSK LLRs for a codeword sent over an AWGN channel
+ */
+static std::vector<float> awgnLLRs(const std::vector<uint8_t>& codeword, float esN0dB,
+  std::mt19937& gen)
+{
+  const float esN0 = std::pow(10.0f, esN0dB / 10.0f);
+  const float sigma = std::sqrt(1.0f / (2.0f * esN0));
+  std::normal_distribution<float> noise(0.0f, sigma);
+  std::vector<float> llrs(codeword.size() * 8);
+  for (uint32_t i = 0; i < llrs.size(); i++) {
+    float symbol = codewordBit(codeword, i) ? -1.0f : 1.0f;
+    llrs[i] = 2.0f * (symbol + noise(gen)) / (sigma * sigma);
+  }
+  return llrs;
+}
+
+/*!
+ * @brief Confirm soft decision decoding for the normalized and offset
+ * variants, and that every min-sum kernel gives the same result
+ */
+TEST(QCLDPC, DecodeLLR)
+{
+  const ErrorCorrection::ErrorCorrectionScheme schemes[] = {
+    ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_648_R_1_2,
+    ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1944_R_5_6
+  };
+  // Es/N0 about 2 dB above the rate's waterfall
+  const float esN0dB[] = { 0.5f, 5.5f };
+
+  std::mt19937 gen(30);
+  for (int s = 0; s < 2; s++) {
+    QCLDPC codec(schemes[s]);
+    ErrorCorrection ec(schemes[s], MPDU::maxMTU() * 8);
+    std::vector<uint8_t> payload(ec.getMessageLen() / 8);
+
+    uint32_t frameErrors = 0;
+    uint32_t frameErrorsOffset = 0;
+    for (int trial = 0; trial < 50; trial++) {
+      for (auto& b : payload) {
+        b = gen() & 0xFF;
+      }
+      std::vector<float> llrs = awgnLLRs(codec.encode(payload), esN0dB[s], gen);
+
+      std::vector<uint8_t> decoded;
+      CPUFeatures::setMask(CPUFeatures::NONE);
+      codec.setMinSumVariant(QCLDPC::MinSumVariant::NORMALIZED, QCLDPC::DEFAULT_NORMALIZATION);
+      uint32_t corrected = codec.decodeLLR(llrs, decoded);
+      uint32_t iterations = codec.lastIterations();
+      frameErrors += (decoded != payload);
+
+      // The SIMD kernels must match the scalar one exactly
+      CPUFeatures::setMask(CPUFeatures::ALL);
+      std::vector<uint8_t> decodedSIMD;
+      ASSERT_EQ(codec.decodeLLR(llrs, decodedSIMD), corrected);
+      ASSERT_EQ(codec.lastIterations(), iterations);
+      ASSERT_EQ(decodedSIMD, decoded);
+
+      codec.setMinSumVariant(QCLDPC::MinSumVariant::OFFSET, 0.5f);
+      codec.decodeLLR(llrs, decoded);
+      frameErrorsOffset += (decoded != payload);
+    }
+#if QA_QCLDPC_DEBUG
+    printf("%s frame errors normalized %u offset %u\n",
+      ErrorCorrection::ErrorCorrectionName(schemes[s]).c_str(), frameErrors, frameErrorsOffset);
+#endif
+    EXPECT_LE(frameErrors, 2u);
+    EXPECT_LE(frameErrorsOffset, 2u);
+  }
+
+  // The iteration cap is respected
+  QCLDPC codec(schemes[0]);
+  ErrorCorrection ec(schemes[0], MPDU::maxMTU() * 8);
+  std::vector<uint8_t> payload(ec.getMessageLen() / 8, 0x5A);
+  std::vector<float> llrs = awgnLLRs(codec.encode(payload), -3.0f, gen);
+  std::vector<uint8_t> decoded;
+  codec.setMaxIterations(3);
+  codec.decodeLLR(llrs, decoded);
+  ASSERT_LE(codec.lastIterations(), 3u);
+}
+
+/*!
+ * @brief Confirm whole messages that are not a whole number of bytes encode
+ * and decode without losing their last bits
+ */
+TEST(QCLDPC, EncodeDecodeBits)
+{
+  std::mt19937 gen(38);
+  for (auto scheme : qcldpcSchemes) {
+    QCLDPC codec(scheme);
+    const QCLDPCBaseMatrix& H = QCLDPCBaseMatrix::forScheme(scheme);
+    ErrorCorrection ec(scheme, MPDU::maxMTU() * 8);
+
+    for (int trial = 0; trial < 5; trial++) {
+      BitBuffer message;
+      for (uint32_t i = 0; i < ec.getMessageLen(); i++) {
+        message.append((bool) (gen() & 0x01));
+      }
+      BitBuffer codeword = codec.encodeBits(message);
+      ASSERT_EQ(codeword.size(), ec.getCodewordLen());
+      for (uint32_t i = 0; i < message.size(); i++) {
+        ASSERT_EQ(codeword[i], message[i]);
+      }
+      ASSERT_EQ(unsatisfiedChecks(H, codeword.bytes()), 0u);
+
+      // The payload methods agree on the whole bytes
+      std::vector<uint8_t> payload(message.bytes().begin(), message.bytes().begin() + ec.getMessageLen() / 8);
+      BitBuffer truncated{ConstBitSpan(payload)};
+      truncated.resize(message.size());
+      ASSERT_EQ(codec.encode(payload), codec.encodeBits(truncated).bytes());
+
+      std::vector<float> llrs = awgnLLRs(codeword.bytes(), 4.0f, gen);
+      BitBuffer decoded;
+      codec.decodeLLR(llrs, decoded);
+      ASSERT_EQ(decoded, message) << ErrorCorrection::ErrorCorrectionName(scheme);
+    }
+
+    ASSERT_THROW(codec.encodeBits(BitBuffer(ec.getMessageLen() - 1)), FECException);
+    BitBuffer decoded;
+    ASSERT_EQ(codec.decodeLLR(std::vector<float>(ec.getCodewordLen() + 1), decoded), UINT32_MAX);
+  }
+}
+
+/*!
+ * @brief Confirm the fixed-point decoder corrects errors and decodes about as
+ * well as the float one near the waterfall
+ */
+TEST(QCLDPC, DecodeFixedPoint)
+{
+  ASSERT_EQ(QCLDPCFixedPoint::quantize(100.0f, 4.0f), QCLDPCFixedPoint::MAX_LLR);
+  ASSERT_EQ(QCLDPCFixedPoint::quantize(-100.0f, 4.0f), -QCLDPCFixedPoint::MAX_LLR);
+  ASSERT_EQ(QCLDPCFixedPoint::quantize(-1.2f, 4.0f), -5);
+
+  std::srand(31);
+  for (auto scheme : qcldpcSchemes) {
+    QCLDPC codec(scheme);
+    ErrorCorrection ec(scheme, MPDU::maxMTU() * 8);
+    QCLDPCFixedPoint fixedPoint(QCLDPCBaseMatrix::forScheme(scheme), ec.getMessageLen(),
+      QCLDPC::DEFAULT_MAX_ITERATIONS);
+
+    std::vector<uint8_t> payload(ec.getMessageLen() / 8);
+    std::vector<uint8_t> decoded(payload.size());
+    for (int trial = 0; trial < 5; trial++) {
+      for (auto& b : payload) {
+        b = std::rand() & 0xFF;
+      }
+      std::vector<uint8_t> codeword = codec.encode(payload);
+      ASSERT_EQ(fixedPoint.decodeHard(codeword.data(), 16, decoded.data()), 0u);
+      ASSERT_EQ(fixedPoint.lastIterations(), 0u);
+      ASSERT_EQ(decoded, payload);
+
+      // Flip 2 distinct bits
+      uint32_t e1 = std::rand() % (codeword.size() * 8);
+      uint32_t e2 = (e1 + 1 + std::rand() % (codeword.size() * 8 - 1)) % (codeword.size() * 8);
+      codeword[e1 / 8] ^= 0x80 >> (e1 % 8);
+      codeword[e2 / 8] ^= 0x80 >> (e2 % 8);
+      ASSERT_EQ(fixedPoint.decodeHard(codeword.data(), 16, decoded.data()), 2u)
+        << ErrorCorrection::ErrorCorrectionName(scheme);
+      ASSERT_TRUE(fixedPoint.lastConverged());
+      ASSERT_EQ(decoded, payload);
+    }
+  }
+
+  // Near the waterfall the fixed-point decoder should lose at most a few
+  // frames more than the float one
+  const ErrorCorrection::ErrorCorrectionScheme scheme =
+    ErrorCorrection::ErrorCorrectionScheme::IEEE_802_11N_QCLDPC_1944_R_1_2;
+  QCLDPC codec(scheme);
+  ErrorCorrection ec(scheme, MPDU::maxMTU() * 8);
+  QCLDPCFixedPoint fixedPoint(QCLDPCBaseMatrix::forScheme(scheme), ec.getMessageLen(),
+    QCLDPC::DEFAULT_MAX_ITERATIONS);
+  std::vector<uint8_t> payload(ec.getMessageLen() / 8);
+  std::vector<uint8_t> decodedFixed(payload.size());
+
+  std::mt19937 gen(31);
+  uint32_t frameErrors = 0;
+  uint32_t frameErrorsFixed = 0;
+  for (int trial = 0; trial < 100; trial++) {
+    for (auto& b : payload) {
+      b = gen() & 0xFF;
+    }
+    // Eb/N0 1.5 dB
+    std::vector<float> llrs = awgnLLRs(codec.encode(payload), -1.5f, gen);
+    std::vector<uint8_t> decoded;
+    codec.decodeLLR(llrs, decoded);
+    frameErrors += (decoded != payload);
+    fixedPoint.decode(llrs.data(), QCLDPCFixedPoint::DEFAULT_LLR_SCALE, decodedFixed.data());
+    frameErrorsFixed += (decodedFixed != payload);
+  }
+#if QA_QCLDPC_DEBUG
+  printf("frame errors float %u fixed %u\n", frameErrors, frameErrorsFixed);
+#endif
+  EXPECT_LE(frameErrors, 10u);
+  EXPECT_LE(frameErrorsFixed, frameErrors + 3);
+}
@@ -0,0 +1,266 @@
+/*!
+ * @file qa_ReedSolomon.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the CCSDS Reed-Solomon codec.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "ReedSolomon.hpp"
+#include "cpuFeatures.hpp"
+
+using namespace std;
+using namespace ex2::sdr;
+
+#include "gtest/gtest.h"
+
+#define QA_REED_SOLOMON_DEBUG 0 // set to 1 for debugging output
+
+static const ErrorCorrection::ErrorCorrectionScheme rsSchemes[] = {
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_1,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_2,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_3,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_4,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_5,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_8,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_1,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_2,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_3,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_4,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_5,
+  ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_8
+};
+
+static const uint16_t rsDepths[] = { 1, 2, 3, 4, 5, 8, 1, 2, 3, 4, 5, 8 };
+
+/*!
+ * @brief GF(2^8) multiply, modulo x^8 + x^7 + x^2 + x + 1, bit by bit
+ */
+static uint8_t
+gfMultiply(uint8_t a, uint8_t b)
+{
+  uint16_t p = 0;
+  for (int i = 0; i < 8; i++) {
+    if (b & (1 << i)) {
+      p ^= (uint16_t) a << i;
+    }
+  }
+  for (int i = 14; i >= 8; i--) {
+    if (p & (1 << i)) {
+      p ^= 0x187 << (i - 8);
+    }
+  }
+  return (uint8_t) p;
+}
+
+static uint8_t
+gfPower(uint8_t a, uint32_t n)
+{
+  uint8_t p = 1;
+  for (uint32_t i = 0; i < n; i++) {
+    p = gfMultiply(p, a);
+  }
+  return p;
+}
+
+/*!
+ * @brief Confirm the generator polynomial and the syndromes against a direct
+ * evaluation of the codeword polynomial at each root alpha^(11 j)
+ */
+TEST(ReedSolomon, Syndromes)
+{
+  std::srand(33);
+  for (uint16_t parity : { 16, 32 }) {
+    ErrorCorrection::ErrorCorrectionScheme scheme = (parity == 16) ? rsSchemes[0] : rsSchemes[6];
+    ReedSolomon rs(scheme);
+    rs.setDualBasis(false);
+    ASSERT_EQ(rs.parityLen(), parity);
+
+    // The remainder of x^(2E) is g(x) less its leading term, and the CCSDS
+    // generator is palindromic
+    std::vector<uint8_t> payload(ReedSolomon::N - parity, 0);
+    payload.back() = 1;
+    std::vector<uint8_t> codeword = rs.encode(payload);
+    ASSERT_EQ(codeword[ReedSolomon::N - 1], 1);
+    for (uint16_t i = 0; i < parity - 1; i++) {
+      ASSERT_EQ(codeword[ReedSolomon::N - parity + i], codeword[ReedSolomon::N - 2 - i]);
+    }
+
+    for (int trial = 0; trial < 20; trial++) {
+      for (auto& b : payload) {
+        b = std::rand() & 0xFF;
+      }
+      codeword = rs.encode(payload);
+      uint16_t errors = trial % 4;
+      for (uint16_t e = 0; e < errors; e++) {
+        codeword[std::rand() % ReedSolomon::N] ^= 1 + std::rand() % 255;
+      }
+
+      uint8_t expected[ReedSolomon::MAX_PARITY];
+      for (uint16_t r = 0; r < parity; r++) {
+        uint8_t root = gfPower(2, (11 * (128 - parity / 2 + r)) % 255);
+        uint8_t s = 0;
+        for (uint16_t j = 0; j < ReedSolomon::N; j++) {
+          s = gfMultiply(s, root) ^ codeword[j];
+        }
+        expected[r] = s;
+      }
+
+      uint8_t syndromes[ReedSolomon::MAX_PARITY];
+      CPUFeatures::setMask(CPUFeatures::NONE);
+      rs.syndromes(codeword.data(), syndromes);
+      ASSERT_TRUE(std::equal(syndromes, syndromes + parity, expected));
+
+      CPUFeatures::setMask(CPUFeatures::ALL);
+      rs.syndromes(codeword.data(), syndromes);
+      ASSERT_TRUE(std::equal(syndromes, syndromes + parity, expected)) << ReedSolomon::syndromeKernelName();
+    }
+  }
+}
+
+/*!
+ * @brief Confirm up to E symbol errors per codeword are corrected in every
+ * scheme, in both symbol representations
+ */
+TEST(ReedSolomon, DecodeErrors)
+{
+  std::srand(33);
+  for (int s = 0; s < 12; s++) {
+    FEC *fec = FEC::makeFECCodec(rsSchemes[s]);
+    ASSERT_NE(fec, nullptr);
+    ReedSolomon *rs = dynamic_cast<ReedSolomon *>(fec);
+    ASSERT_NE(rs, nullptr);
+    ASSERT_EQ(rs->interleavingDepth(), rsDepths[s]);
+
+    ErrorCorrection ec(rsSchemes[s], 8192);
+    const uint16_t depth = rsDepths[s];
+    const uint16_t k = ReedSolomon::N - rs->parityLen();
+    ASSERT_EQ(ec.getMessageLen(), k * depth * 8u);
+    ASSERT_EQ(ec.getCodewordLen(), ReedSolomon::N * depth * 8u);
+
+    for (bool dual : { true, false }) {
+      rs->setDualBasis(dual);
+      std::vector<uint8_t> payload(ec.getMessageLen() / 8);
+      for (int trial = 0; trial < 5; trial++) {
+        for (auto& b : payload) {
+          b = std::rand() & 0xFF;
+        }
+        std::vector<uint8_t> codewords = rs->encode(payload);
+        ASSERT_EQ(codewords.size(), ec.getCodewordLen() / 8);
+        ASSERT_TRUE(std::equal(payload.begin(), payload.end(), codewords.begin()));
+
+        // E errors in distinct symbols of each codeword
+        uint32_t flipped = 0;
+        for (uint16_t c = 0; c < depth; c++) {
+          std::vector<bool> hit(ReedSolomon::N, false);
+          for (uint16_t e = 0; e < rs->parityLen() / 2; e++) {
+            uint16_t j;
+            do {
+              j = std::rand() % ReedSolomon::N;
+            } while (hit[j]);
+            hit[j] = true;
+            uint8_t error = 1 + std::rand() % 255;
+            codewords[j * depth + c] ^= error;
+            flipped += __builtin_popcount(error);
+          }
+        }
+
+        std::vector<uint8_t> decoded;
+        ASSERT_EQ(rs->decode(codewords, 100.0, decoded), flipped);
+        ASSERT_EQ(rs->lastUncorrectable(), 0u);
+        ASSERT_EQ(decoded, payload) << ErrorCorrection::ErrorCorrectionName(rsSchemes[s]);
+      }
+    }
+
+    std::vector<uint8_t> payload(ec.getMessageLen() / 8 + 1);
+    ASSERT_THROW(rs->encode(payload), FECException);
+    std::vector<uint8_t> decoded;
+    ASSERT_EQ(rs->decode(payload, 100.0, decoded), UINT32_MAX);
+    ASSERT_EQ(decoded.size(), 0u);
+    delete fec;
+  }
+}
+
+/*!
+ * @brief Confirm interleaving corrects a burst of E x I bytes
+ */
+TEST(ReedSolomon, DecodeBurst)
+{
+  std::srand(33);
+  for (int s = 0; s < 12; s++) {
+    ReedSolomon rs(rsSchemes[s]);
+    const uint16_t depth = rsDepths[s];
+    const uint32_t burst = rs.parityLen() / 2 * depth;
+
+    std::vector<uint8_t> payload((ReedSolomon::N - rs.parityLen()) * depth);
+    for (auto& b : payload) {
+      b = std::rand() & 0xFF;
+    }
+    std::vector<uint8_t> codewords = rs.encode(payload);
+    uint32_t start = std::rand() % (codewords.size() - burst);
+    for (uint32_t i = start; i < start + burst; i++) {
+      codewords[i] = ~codewords[i];
+    }
+
+    std::vector<uint8_t> decoded;
+    ASSERT_EQ(rs.decode(codewords, 100.0, decoded), burst * 8);
+    ASSERT_EQ(decoded, payload) << ErrorCorrection::ErrorCorrectionName(rsSchemes[s]);
+  }
+}
+
+/*!
+ * @brief Confirm codewords with more than E errors are reported and passed
+ * through, without disturbing the other codewords of the block
+ */
+TEST(ReedSolomon, DecodeUncorrectable)
+{
+  std::srand(33);
+  ReedSolomon rs(ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_223_INTERLEAVING_2);
+
+  uint32_t detected = 0;
+  const int trials = 50;
+  for (int trial = 0; trial < trials; trial++) {
+    std::vector<uint8_t> payload(223 * 2);
+    for (auto& b : payload) {
+      b = std::rand() & 0xFF;
+    }
+    std::vector<uint8_t> codewords = rs.encode(payload);
+
+    // 20 errors in codeword 0, 1 error in codeword 1
+    std::vector<bool> hit(ReedSolomon::N, false);
+    for (int e = 0; e < 20; e++) {
+      uint16_t j;
+      do {
+        j = std::rand() % ReedSolomon::N;
+      } while (hit[j]);
+      hit[j] = true;
+      codewords[j * 2] ^= 1 + std::rand() % 255;
+    }
+    codewords[1] ^= 0x01;
+    std::vector<uint8_t> received = codewords;
+
+    std::vector<uint8_t> decoded;
+    rs.decode(codewords, 100.0, decoded);
+    if (rs.lastUncorrectable() == 1) {
+      detected++;
+      for (uint16_t j = 0; j < 223; j++) {
+        ASSERT_EQ(decoded[j * 2], received[j * 2]);
+        ASSERT_EQ(decoded[j * 2 + 1], payload[j * 2 + 1]);
+      }
+    }
+  }
+#if QA_REED_SOLOMON_DEBUG
+  printf("detected %u of %d\n", detected, trials);
+#endif
+  // Miscorrection beyond E errors is very unlikely for E = 16
+  EXPECT_EQ(detected, (uint32_t) trials);
+}
@@ -0,0 +1,175 @@
+/*!
+ * @file qa_bitBuffer.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the packed bit spans and buffers.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bitBuffer.hpp"
+#include "mpduUtility.hpp"
+
+using namespace std;
+using namespace ex2::sdr;
+
+#include "gtest/gtest.h"
+
+#define QA_BIT_BUFFER_DEBUG 0 // set to 1 for debugging output
+
+/*!
+ * @brief Confirm span accessors at every offset against one bool per bit
+ */
+TEST(bitBuffer, SpanAccess)
+{
+  std::mt19937 gen(38);
+  std::vector<uint8_t> bytes(24);
+  for (auto& b : bytes) {
+    b = gen() & 0xFF;
+  }
+  std::vector<bool> reference(bytes.size() * 8);
+  for (size_t i = 0; i < reference.size(); i++) {
+    reference[i] = (bytes[i / 8] >> (7 - i % 8)) & 0x01;
+  }
+
+  for (size_t offset = 0; offset < 16; offset++) {
+    ConstBitSpan span(bytes.data(), 100, offset);
+    ASSERT_EQ(span.size(), 100u);
+    for (size_t i = 0; i < span.size(); i++) {
+      ASSERT_EQ(span[i], reference[offset + i]);
+    }
+    for (unsigned int count = 0; count <= 64; count++) {
+      uint64_t expected = 0;
+      for (unsigned int i = 0; i < count; i++) {
+        expected = (expected << 1) | reference[offset + 3 + i];
+      }
+      ASSERT_EQ(span.extract(3, count), expected) << "offset " << offset << " count " << count;
+    }
+    ConstBitSpan sub = span.subspan(9, 20);
+    for (size_t i = 0; i < sub.size(); i++) {
+      ASSERT_EQ(sub[i], reference[offset + 9 + i]);
+    }
+  }
+
+  // Deposit only changes the bits it is given
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (unsigned int count = 1; count <= 64; count += 7) {
+      std::vector<uint8_t> modified(bytes);
+      std::vector<bool> expected(reference);
+      uint64_t value = ((uint64_t) gen() << 32) | gen();
+      BitSpan span(modified.data(), 90, offset);
+      span.deposit(11, count, value);
+      for (unsigned int i = 0; i < count; i++) {
+        expected[offset + 11 + i] = (value >> (count - 1 - i)) & 0x01;
+      }
+      for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ((bool) ((modified[i / 8] >> (7 - i % 8)) & 0x01), expected[i]);
+      }
+      span.set(0, !span[0]);
+      ASSERT_NE(span[0], expected[offset]);
+    }
+  }
+}
+
+/*!
+ * @brief Confirm appending bits, integers and spans keeps the padding zero
+ */
+TEST(bitBuffer, Append)
+{
+  std::mt19937 gen(38);
+  BitBuffer buffer;
+  std::vector<bool> reference;
+  for (int trial = 0; trial < 200; trial++) {
+    switch (gen() % 3) {
+      case 0: {
+        bool bit = gen() & 0x01;
+        buffer.append(bit);
+        reference.push_back(bit);
+        break;
+      }
+      case 1: {
+        unsigned int count = gen() % 65;
+        uint64_t value = ((uint64_t) gen() << 32) | gen();
+        buffer.append(value, count);
+        for (unsigned int i = 0; i < count; i++) {
+          reference.push_back((value >> (count - 1 - i)) & 0x01);
+        }
+        break;
+      }
+      default: {
+        std::vector<uint8_t> bytes(8);
+        for (auto& b : bytes) {
+          b = gen() & 0xFF;
+        }
+        size_t offset = gen() % 8;
+        size_t count = gen() % (64 - offset);
+        ConstBitSpan span(bytes.data(), count, offset);
+        buffer.append(span);
+        for (size_t i = 0; i < count; i++) {
+          reference.push_back(span[i]);
+        }
+        break;
+      }
+    }
+    ASSERT_EQ(buffer.size(), reference.size());
+    ASSERT_EQ(buffer.bytes().size(), (reference.size() + 7) / 8);
+    for (size_t i = 0; i < reference.size(); i++) {
+      ASSERT_EQ(buffer[i], reference[i]);
+    }
+    if (buffer.size() % 8 > 0) {
+      ASSERT_EQ(buffer.bytes().back() & (0xFF >> (buffer.size() % 8)), 0);
+    }
+  }
+
+  BitBuffer copy(buffer.span());
+  ASSERT_EQ(copy, buffer);
+  copy.resize(copy.size() - 3);
+  copy.resize(copy.size() + 3);
+  for (size_t i = copy.size() - 3; i < copy.size(); i++) {
+    ASSERT_FALSE(copy[i]);
+  }
+}
+
+/*!
+ * @brief Confirm repacking spans to symbols and back
+ */
+TEST(bitBuffer, Repack)
+{
+  std::mt19937 gen(38);
+  std::vector<uint8_t> bytes(40);
+  for (auto& b : bytes) {
+    b = gen() & 0xFF;
+  }
+
+  for (unsigned int bps = 1; bps <= 8; bps++) {
+    for (size_t offset : { 0, 3, 8, 13 }) {
+      for (size_t count : { 0, 1, 7, 8, 29, 64, 251 }) {
+        ConstBitSpan span(bytes.data(), count, offset);
+        std::vector<uint8_t> symbols;
+        MPDUUtility::repack(span, (MPDUUtility::BitsPerSymbol) bps, symbols);
+        ASSERT_EQ(symbols.size(), (count + bps - 1) / bps);
+
+        // Symbol bits, msb first, then zero padding
+        for (size_t i = 0; i < symbols.size() * bps; i++) {
+          bool bit = (symbols[i / bps] >> (bps - 1 - i % bps)) & 0x01;
+          ASSERT_EQ(bit, (i < count) ? span[i] : false) << bps << " bps, offset " << offset
+            << ", count " << count << ", bit " << i;
+        }
+
+        BitBuffer bits;
+        MPDUUtility::repack(symbols, (MPDUUtility::BitsPerSymbol) bps, bits);
+        ASSERT_EQ(bits.size(), symbols.size() * bps);
+        bits.resize(count);
+        ASSERT_EQ(bits, BitBuffer(span));
+      }
+    }
+  }
+}
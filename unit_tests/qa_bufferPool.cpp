@@ -0,0 +1,112 @@
+/*!
+ * @file qa_bufferPool.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the static buffer pools.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "bufferPool.h"
+#include "radio.h"
+
+using namespace std;
+
+#include "gtest/gtest.h"
+
+#define QA_BUFFER_POOL_DEBUG 0 // set to 1 for debugging output
+
+#define QA_POOL_BLOCKS 5
+
+OS_POOL_DEFINE(qa_mpdu_pool, UHF_TRANSPARENT_MODE_DATA_FIELD_2_MAX_LENGTH + 3, QA_POOL_BLOCKS);
+OS_POOL_DEFINE(qa_packet_pool, MAC_MAX_USER_PACKET_LENGTH, 4);
+
+/*!
+ * @brief Confirm every block is distinct, aligned and in the arena, that an
+ * empty pool returns NULL and that returned blocks are reused
+ */
+TEST(bufferPool, AllocFree)
+{
+  const size_t blockSize = qa_mpdu_pool.block_size;
+  ASSERT_GE(blockSize, (size_t) UHF_TRANSPARENT_MODE_DATA_FIELD_2_MAX_LENGTH + 3);
+  ASSERT_EQ(blockSize % OS_POOL_ALIGN, 0u);
+  ASSERT_EQ(os_pool_available(&qa_mpdu_pool), (size_t) QA_POOL_BLOCKS);
+
+  std::vector<uint8_t *> blocks;
+  for (int i = 0; i < QA_POOL_BLOCKS; i++) {
+    uint8_t *block = (uint8_t *) os_pool_alloc(&qa_mpdu_pool);
+    ASSERT_NE(block, nullptr);
+    ASSERT_EQ((uintptr_t) block % OS_POOL_ALIGN, 0u);
+    ASSERT_GE(block, qa_mpdu_pool.arena);
+    ASSERT_LE(block + blockSize, qa_mpdu_pool.arena + QA_POOL_BLOCKS * blockSize);
+    // The whole block is usable
+    memset(block, i, blockSize);
+    blocks.push_back(block);
+  }
+  ASSERT_EQ(std::set<uint8_t *>(blocks.begin(), blocks.end()).size(), blocks.size());
+  ASSERT_EQ(os_pool_available(&qa_mpdu_pool), 0u);
+  ASSERT_EQ(os_pool_alloc(&qa_mpdu_pool), nullptr);
+
+  // Returning a block overwrites only its start; the others are untouched
+  os_pool_free(&qa_mpdu_pool, blocks[2]);
+  os_pool_free(&qa_mpdu_pool, nullptr);
+  ASSERT_EQ(os_pool_available(&qa_mpdu_pool), 1u);
+  for (int i = 0; i < QA_POOL_BLOCKS; i++) {
+    if (i != 2) {
+      ASSERT_EQ(blocks[i][blockSize - 1], i);
+    }
+  }
+  ASSERT_EQ(os_pool_alloc(&qa_mpdu_pool), blocks[2]);
+  ASSERT_EQ(os_pool_alloc(&qa_mpdu_pool), nullptr);
+
+  for (uint8_t *block : blocks) {
+    os_pool_free(&qa_mpdu_pool, block);
+  }
+  ASSERT_EQ(os_pool_available(&qa_mpdu_pool), (size_t) QA_POOL_BLOCKS);
+}
+
+/*!
+ * @brief Confirm the pool stays consistent when tasks and interrupt handlers
+ * share it
+ */
+TEST(bufferPool, Shared)
+{
+  const int numThreads = 4;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < numThreads; t++) {
+    threads.emplace_back([t]() {
+      for (int i = 0; i < 10000; i++) {
+        // Odd threads stand in for an interrupt handler
+        uint8_t *block = (uint8_t *) (t % 2 ? os_pool_alloc_from_isr(&qa_packet_pool) :
+          os_pool_alloc(&qa_packet_pool));
+        if (block) {
+          // Each block is held by one task at a time
+          block[0] = t;
+          block[MAC_MAX_USER_PACKET_LENGTH - 1] = t;
+          std::this_thread::yield();
+          EXPECT_EQ(block[0], t);
+          EXPECT_EQ(block[MAC_MAX_USER_PACKET_LENGTH - 1], t);
+          if (t % 2) {
+            os_pool_free_from_isr(&qa_packet_pool, block);
+          } else {
+            os_pool_free(&qa_packet_pool, block);
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(os_pool_available(&qa_packet_pool), 4u);
+}
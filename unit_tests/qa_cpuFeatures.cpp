@@ -0,0 +1,83 @@
+/*!
+ * @file qa_cpuFeatures.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the CPU feature detection and kernel dispatch.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "cpuFeatures.hpp"
+
+using namespace ex2::sdr;
+
+#include "gtest/gtest.h"
+
+#define QA_CPU_FEATURES_DEBUG 0 // set to 1 for debugging output
+
+typedef int (*TestKernelFn)();
+
+static int kernelScalar() { return 0; }
+static int kernelSSE2() { return 1; }
+static int kernelAVX2() { return 2; }
+
+/*!
+ * @brief Test the feature masks
+ */
+TEST(cpuFeatures, Detection)
+{
+  uint32_t detected = CPUFeatures::detected();
+
+#if QA_CPU_FEATURES_DEBUG
+  printf("detected features: %s\n", CPUFeatures::toString(detected).c_str());
+#endif
+
+  ASSERT_EQ(detected & ~CPUFeatures::ALL, 0u);
+  ASSERT_EQ(CPUFeatures::enabled(), detected);
+#if EX2_SDR_X86_KERNELS && defined(__x86_64__)
+  // SSE2 is part of the x86-64 baseline
+  ASSERT_TRUE(CPUFeatures::has(CPUFeatures::SSE2));
+#endif
+
+  CPUFeatures::setMask(CPUFeatures::NONE);
+  ASSERT_EQ(CPUFeatures::enabled(), 0u);
+  CPUFeatures::setMask(CPUFeatures::SSE2);
+  ASSERT_EQ(CPUFeatures::enabled(), detected & CPUFeatures::SSE2);
+  CPUFeatures::setMask(CPUFeatures::ALL);
+  ASSERT_EQ(CPUFeatures::enabled(), detected);
+
+  ASSERT_EQ(CPUFeatures::toString(CPUFeatures::NONE), "none");
+  ASSERT_EQ(CPUFeatures::toString(CPUFeatures::SSE2 | CPUFeatures::AVX2), "SSE2 AVX2");
+}
+
+/*!
+ * @brief Test the kernel is bound to the best enabled implementation and
+ * rebound when the enabled features change
+ */
+TEST(cpuFeatures, Dispatch)
+{
+  static const DispatchedKernel<TestKernelFn> kernel({
+    { "avx2", CPUFeatures::AVX2, kernelAVX2 },
+    { "sse2", CPUFeatures::SSE2, kernelSSE2 },
+    { "scalar", CPUFeatures::NONE, kernelScalar } });
+
+  int expected = CPUFeatures::has(CPUFeatures::AVX2) ? 2 : (CPUFeatures::has(CPUFeatures::SSE2) ? 1 : 0);
+  ASSERT_EQ(kernel.get()(), expected);
+
+  CPUFeatures::setMask(CPUFeatures::NONE);
+  ASSERT_EQ(kernel.get()(), 0);
+  ASSERT_STREQ(kernel.name(), "scalar");
+
+  CPUFeatures::setMask(CPUFeatures::SSE2);
+  ASSERT_EQ(kernel.get()(), CPUFeatures::has(CPUFeatures::SSE2) ? 1 : 0);
+
+  CPUFeatures::setMask(CPUFeatures::ALL);
+  ASSERT_EQ(kernel.get()(), expected);
+}
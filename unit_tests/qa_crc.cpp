@@ -0,0 +1,156 @@
+/*!
+ * @file qa_crc.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the CRC calculations.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "crc.hpp"
+#include "crcWrapper.h"
+#include "cpuFeatures.hpp"
+
+using namespace std;
+using namespace ex2::sdr;
+
+#include "gtest/gtest.h"
+
+#define QA_CRC_DEBUG 0 // set to 1 for debugging output
+
+// One bit at a time, as the UHF radio framing used to be checked
+static uint16_t referenceCRC16(const uint8_t *data, size_t length)
+{
+  uint16_t crc = 0xFFFF;
+  while (length--) {
+    crc ^= *data++ << 8;
+    for (int i = 0; i < 8; i++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+static uint32_t referenceCRC32(const uint8_t *data, size_t length)
+{
+  uint32_t crc = 0xFFFFFFFF;
+  while (length--) {
+    crc ^= *data++;
+    for (int i = 0; i < 8; i++) {
+      crc = (crc & 0x01) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+    }
+  }
+  return crc ^ 0xFFFFFFFF;
+}
+
+/*!
+ * @brief Confirm the standard check values and that every kernel matches a
+ * bitwise calculation for all lengths and alignments
+ */
+TEST(crc, Calculate)
+{
+  const uint8_t check[] = "123456789";
+  ASSERT_EQ(crc::calculate(crc::CRC_16_BITS, check, 9), 0x29B1u);
+  ASSERT_EQ(crc::calculate(crc::CRC_32_BITS, check, 9), 0xCBF43926u);
+  ASSERT_EQ(crc::calculate(crc::CRC_16_BITS, check, 0), crc::initial(crc::CRC_16_BITS));
+  ASSERT_EQ(crc::calculate(crc::CRC_32_BITS, check, 0), 0u);
+
+  std::mt19937 gen(41);
+  std::vector<uint8_t> data(1100);
+  for (auto& b : data) {
+    b = gen() & 0xFF;
+  }
+
+  for (uint32_t mask : { CPUFeatures::NONE, CPUFeatures::ALL }) {
+    CPUFeatures::setMask(mask);
+#if QA_CRC_DEBUG
+    printf("crc kernel %s\n", crc::kernelName());
+#endif
+    for (size_t offset = 0; offset < 8; offset++) {
+      for (size_t length = 0; length + offset <= data.size(); length += (length < 200) ? 1 : 37) {
+        const uint8_t *p = data.data() + offset;
+        ASSERT_EQ(crc::calculate(crc::CRC_16_BITS, p, length), referenceCRC16(p, length))
+          << crc::kernelName() << " offset " << offset << " length " << length;
+        ASSERT_EQ(crc::calculate(crc::CRC_32_BITS, p, length), referenceCRC32(p, length))
+          << crc::kernelName() << " offset " << offset << " length " << length;
+      }
+    }
+  }
+  CPUFeatures::setMask(CPUFeatures::ALL);
+}
+
+/*!
+ * @brief Confirm a checksum updated over fragments is the same as one over
+ * all the data
+ */
+TEST(crc, Update)
+{
+  std::mt19937 gen(41);
+  std::vector<uint8_t> data(2000);
+  for (auto& b : data) {
+    b = gen() & 0xFF;
+  }
+
+  for (crc::crc_size_t crcSize : { crc::CRC_16_BITS, crc::CRC_32_BITS }) {
+    const uint32_t whole = crc::calculate(crcSize, data.data(), data.size());
+    for (int trial = 0; trial < 50; trial++) {
+      crc fragments(crcSize);
+      uint16_t crc16 = CRC16_CCITT_INITIAL;
+      uint32_t crc32 = CRC32_INITIAL;
+      size_t pos = 0;
+      while (pos < data.size()) {
+        size_t length = std::min<size_t>(gen() % 300, data.size() - pos);
+        fragments.update(data.data() + pos, length);
+        crc16 = crc16_ccitt_update(crc16, data.data() + pos, length);
+        crc32 = crc32_update(crc32, data.data() + pos, length);
+        pos += length;
+      }
+      ASSERT_EQ(fragments.checksum(), whole);
+      ASSERT_EQ((crcSize == crc::CRC_16_BITS) ? crc16 : crc32, whole);
+    }
+
+    crc restarted(crcSize);
+    restarted.update(data);
+    restarted.reset();
+    restarted.update(data);
+    ASSERT_EQ(restarted.checksum(), whole);
+  }
+}
+
+/*!
+ * @brief Confirm adding and checking syndromes
+ */
+TEST(crc, AddCheck)
+{
+  crc c;
+  for (crc::crc_size_t crcSize : { crc::CRC_16_BITS, crc::CRC_32_BITS }) {
+    std::vector<uint8_t> pdu(std::begin("123456789"), std::end("123456789") - 1);
+    const std::vector<uint8_t> original = pdu;
+    c.add(pdu, crcSize);
+    ASSERT_EQ(pdu.size(), original.size() + crcSize / 8);
+    if (crcSize == crc::CRC_16_BITS) {
+      ASSERT_EQ(pdu[9], 0x29);
+      ASSERT_EQ(pdu[10], 0xB1);
+    }
+    ASSERT_TRUE(crc::valid(pdu.data(), pdu.size(), crcSize));
+
+    std::vector<uint8_t> corrupt = pdu;
+    corrupt[3] ^= 0x10;
+    ASSERT_FALSE(crc::valid(corrupt.data(), corrupt.size(), crcSize));
+    ASSERT_THROW(c.check(corrupt, crcSize), std::runtime_error);
+    ASSERT_FALSE(crc::valid(pdu.data(), 1, crcSize));
+
+    c.check(pdu, crcSize);
+    ASSERT_EQ(pdu, original);
+  }
+}
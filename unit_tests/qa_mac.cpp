@@ -11,6 +11,7 @@
  * This software may not be modified or distributed in any form, except as described in the LICENSE file.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <iostream>
 #include <random>
@@ -22,6 +23,7 @@
 #include "mpdu.hpp"
 #include "mpduHeader.hpp"
 #include "MACWrapper.h"
+#include "radio.h"
 
 using namespace std;
 using namespace ex2::sdr;
@@ -31,8 +33,7 @@ using namespace ex2::sdr;
 #define QA_MAC_DEBUG 0         // set to 1 for debugging output
 #define QA_MAC_VERBOSE_DEBUG 0 // set to 1 for verbose debugging output
 
-// @todo should be 14
-#define NUM_ERROR_CORRECTION_SCHEMES_TO_TEST 14
+#define NUM_ERROR_CORRECTION_SCHEMES_TO_TEST 18
 
 ErrorCorrection::ErrorCorrectionScheme getScheme(int ecScheme) {
   ErrorCorrection::ErrorCorrectionScheme ecs;
@@ -211,14 +212,14 @@ TEST(mac, PacketLoopbackNoDroppedPackets) {
     {3,3,3,5,47}, // IEEE_802_11N_QCLDPC_1944_R_3_4, n = 243 m = 182.25 -> 182 bytes
     {3,3,3,5,43}, // IEEE_802_11N_QCLDPC_1944_R_5_6, n = 243 m = 202.5 -> 202 bytes
     {1,1,3,7,70}, // CCSDS_CONVOLUTIONAL_CODING_R_1_2, n = 118 m = 59 bytes
-    {1,1,2,5,53}, // CCSDS_CONVOLUTIONAL_CODING_R_2_3, n = 119 m = 79
+    {1,1,2,5,52}, // CCSDS_CONVOLUTIONAL_CODING_R_2_3, n = 119 m = 79
     {1,1,2,5,47}, // CCSDS_CONVOLUTIONAL_CODING_R_3_4, n = 119 m = 89 bytes
     {1,1,2,4,42}, // CCSDS_CONVOLUTIONAL_CODING_R_5_6, n = 119 m = 99 bytes
     {1,1,2,4,40}  // CCSDS_CONVOLUTIONAL_CODING_R_7_8, n = 119 m = 104 bytes
   };
 
   // @note, not all schemes are currently supported; the QCLDPC are stubbed for
-  // now, and all but the rate 1/2 convolutional coding schemes are skipped.
+  // now.
 
   for (int ecScheme = 0; ecScheme < NUM_ERROR_CORRECTION_SCHEMES_TO_TEST; ecScheme++) {
 
@@ -361,15 +362,15 @@ TEST(mac, PacketLoopbackDroppedPackets) {
     {5,47}, // IEEE_802_11N_QCLDPC_1944_R_3_4, n = 243 m = 182.25 -> 182 bytes
     {5,43}, // IEEE_802_11N_QCLDPC_1944_R_5_6, n = 243 m = 202.5 -> 202 bytes
     {7,70}, // CCSDS_CONVOLUTIONAL_CODING_R_1_2, n = 118 m = 59 bytes
-    {5,53}, // CCSDS_CONVOLUTIONAL_CODING_R_2_3, n = 119 m = 79
+    {5,52}, // CCSDS_CONVOLUTIONAL_CODING_R_2_3, n = 119 m = 79
     {5,47}, // CCSDS_CONVOLUTIONAL_CODING_R_3_4, n = 119 m = 89 bytes
     {4,42}, // CCSDS_CONVOLUTIONAL_CODING_R_5_6, n = 119 m = 99 bytes
     {4,40}  // CCSDS_CONVOLUTIONAL_CODING_R_7_8, n = 119 m = 104 bytes
   };
 
   // @note, not all schemes are currently supported; the QCLDPC are stubbed for
-  // now, and all but the rate 1/2 convolutional coding schemes are skipped.
-  std::vector<int> schemes({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, 13});
+  // now.
+  std::vector<int> schemes({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, 13, 14, 15, 16, 17});
 
   for (int ecScheme : schemes) {
 
@@ -815,3 +816,124 @@ TEST(mac, PacketLoopbackDroppedPackets) {
 
 } // PacketLoopbackDroppedPackets
 
+
+/*!
+ * @brief Test packets carrying a CRC are received intact and packets that
+ * fail the CRC are dropped
+ */
+TEST(mac, PacketCRC) {
+
+  MAC mac(RF_Mode::RF_ModeNumber::RF_MODE_3,
+    ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONVOLUTIONAL_CODING_R_1_2);
+  ASSERT_FALSE(mac.getPacketCRC());
+  mac.setPacketCRC(true);
+  ASSERT_TRUE(mac.getPacketCRC());
+
+  uint16_t const packetLength = 358;
+  uint8_t * packet = makePacket(packetLength);
+  ASSERT_TRUE(mac.receivePacket(packet, packetLength));
+
+  // The CRC makes the largest packet 4 bytes shorter
+  uint8_t * bigPacket = makePacket(MAC_MAX_USER_PACKET_LENGTH);
+  ASSERT_FALSE(mac.receivePacket(bigPacket, MAC_MAX_USER_PACKET_LENGTH));
+  free(bigPacket);
+  ASSERT_TRUE(mac.receivePacket(packet, packetLength));
+
+  std::vector<uint8_t> mpdus(mac.mpduPayloadsBuffer(),
+    mac.mpduPayloadsBuffer() + mac.mpduPayloadsBufferLength());
+  uint32_t const numMPDUs = mpdus.size() / MPDU::rawMPDULength();
+
+  // Received intact, without the CRC
+  uint32_t packetsReady = 0;
+  for (uint32_t m = 0; m < numMPDUs; m++) {
+    if (mac.processUHFPacket(&mpdus[m * MPDU::rawMPDULength()], MPDU::rawMPDULength()) ==
+      MAC::MAC_UHFPacketProcessingStatus::PACKET_READY) {
+      packetsReady++;
+      ASSERT_EQ(mac.getRawPacketLength(), packetLength);
+      ASSERT_TRUE(std::equal(packet, packet + packetLength, mac.getRawPacketBuffer()));
+    }
+  }
+  ASSERT_EQ(packetsReady, 1u);
+  ASSERT_EQ(mac.getCorruptPacketCount(), 0u);
+
+  // Wipe out part of a codeword so it can't be corrected
+  uint32_t const headerLength = MPDU::rawMPDULength() - MPDU::maxMTU();
+  for (uint32_t i = headerLength + 10; i < headerLength + 40; i++) {
+    mpdus[MPDU::rawMPDULength() + i] ^= 0xFF;
+  }
+  for (uint32_t m = 0; m < numMPDUs; m++) {
+    ASSERT_EQ(mac.processUHFPacket(&mpdus[m * MPDU::rawMPDULength()], MPDU::rawMPDULength()),
+      MAC::MAC_UHFPacketProcessingStatus::READY_FOR_NEXT_UHF_PACKET);
+  }
+  ASSERT_EQ(mac.getCorruptPacketCount(), 1u);
+
+  free(packet);
+} // PacketCRC
+
+/*!
+ * @brief Test packets loop back for the Reed-Solomon, Turbo, AR4JA LDPC and
+ * concatenated schemes, and packets needing more MPDUs than the MPDU header
+ * can count are refused
+ */
+TEST(mac, PacketLoopbackOtherSchemes) {
+
+  std::vector<ErrorCorrection::ErrorCorrectionScheme> schemes;
+  for (int ecs = (int) ErrorCorrection::ErrorCorrectionScheme::CCSDS_REED_SOLOMON_255_239_INTERLEAVING_1;
+    ecs <= (int) ErrorCorrection::ErrorCorrectionScheme::CCSDS_LDPC_ORANGE_BOOK_2048; ecs++) {
+    schemes.push_back((ErrorCorrection::ErrorCorrectionScheme) ecs);
+  }
+  schemes.push_back(ErrorCorrection::ErrorCorrectionScheme::CCSDS_CONCATENATED_RS_255_223_I_4_CC_R_1_2);
+
+  uint16_t const numPackets = 6;
+  uint16_t packetDataLengths[numPackets] = {0, 10, 119, 358, 2000, 4095};
+
+  MAC mac(RF_Mode::RF_ModeNumber::RF_MODE_3, schemes[0]);
+
+  for (ErrorCorrection::ErrorCorrectionScheme ecs : schemes) {
+    mac.setErrorCorrectionScheme(ecs);
+    ErrorCorrection errorCorrection(ecs, MPDU::maxMTU() * 8);
+
+    for (uint16_t currentPacket = 0; currentPacket < numPackets; currentPacket++) {
+      uint16_t const packetLength = packetDataLengths[currentPacket];
+      uint8_t * packet = makePacket(packetLength);
+      ASSERT_FALSE(packet == NULL) << "Failed to get packet buffer";
+
+      uint16_t const expectedMPDUs = MPDU::mpdusInNBytes(packetLength, errorCorrection);
+      bool const packetEncoded = mac.receivePacket(packet, packetLength);
+      if (expectedMPDUs > MPDUHeader::maxCodewordFragments()) {
+        ASSERT_FALSE(packetEncoded) << "Scheme " << (int) ecs << " encoded a packet of "
+          << expectedMPDUs << " MPDUs";
+        free(packet);
+        continue;
+      }
+      ASSERT_TRUE(packetEncoded) << "Scheme " << (int) ecs << " failed to encode packet";
+
+      uint32_t const numMPDUs = mac.mpduPayloadsBufferLength() / MPDU::rawMPDULength();
+      ASSERT_EQ(numMPDUs, expectedMPDUs);
+
+      std::vector<uint8_t> mpdus(mac.mpduPayloadsBuffer(),
+        mac.mpduPayloadsBuffer() + mac.mpduPayloadsBufferLength());
+      uint32_t packetsReady = 0;
+      for (uint32_t m = 0; m < numMPDUs; m++) {
+        if (mac.processUHFPacket(&mpdus[m * MPDU::rawMPDULength()], MPDU::rawMPDULength()) ==
+          MAC::MAC_UHFPacketProcessingStatus::PACKET_READY) {
+          packetsReady++;
+          ASSERT_EQ(mac.getRawPacketLength(), packetLength);
+          ASSERT_TRUE(std::equal(packet, packet + packetLength, mac.getRawPacketBuffer()))
+            << "Scheme " << (int) ecs << " decoded packet does not match original";
+        }
+      }
+      ASSERT_EQ(packetsReady, 1u) << "Scheme " << (int) ecs << " packet length " << packetLength;
+
+      free(packet);
+    }
+  }
+
+  // Packets just over the limit
+  uint8_t * packet = makePacket(MAC_MAX_USER_PACKET_LENGTH);
+  mac.setErrorCorrectionScheme(ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_1784_R_1_4);
+  ASSERT_FALSE(mac.receivePacket(packet, MAC_MAX_USER_PACKET_LENGTH));
+  mac.setErrorCorrectionScheme(ErrorCorrection::ErrorCorrectionScheme::CCSDS_TURBO_7136_R_1_6);
+  ASSERT_FALSE(mac.receivePacket(packet, 2000));
+  free(packet);
+} // PacketLoopbackOtherSchemes
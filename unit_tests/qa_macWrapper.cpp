@@ -128,7 +128,7 @@ TEST(macWrapper, PacketLoopbackNoDroppedPackets) {
     {3,3,3,5,47}, // IEEE_802_11N_QCLDPC_1944_R_3_4, n = 243 m = 182.25 -> 182 bytes
     {3,3,3,5,43}, // IEEE_802_11N_QCLDPC_1944_R_5_6, n = 243 m = 202.5 -> 202 bytes
     {1,1,3,7,70}, // CCSDS_CONVOLUTIONAL_CODING_R_1_2, n = 118 m = 59 bytes
-    {1,1,2,5,53}, // CCSDS_CONVOLUTIONAL_CODING_R_2_3, n = 119 m = 79
+    {1,1,2,5,52}, // CCSDS_CONVOLUTIONAL_CODING_R_2_3, n = 119 m = 79
     {1,1,2,5,47}, // CCSDS_CONVOLUTIONAL_CODING_R_3_4, n = 119 m = 89 bytes
     {1,1,2,4,42}, // CCSDS_CONVOLUTIONAL_CODING_R_5_6, n = 119 m = 99 bytes
     {1,1,2,4,40}  // CCSDS_CONVOLUTIONAL_CODING_R_7_8, n = 119 m = 104 bytes
@@ -136,7 +136,7 @@ TEST(macWrapper, PacketLoopbackNoDroppedPackets) {
 
   error_correction_scheme_t ecs;
 
-  for (int ecScheme = 0; ecScheme < 14; ecScheme++) {
+  for (int ecScheme = 0; ecScheme < numSchemes; ecScheme++) {
 
     switch(ecScheme) {
       case 0:
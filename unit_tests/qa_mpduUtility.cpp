@@ -14,10 +14,13 @@
  * This software may not be modified or distributed in any form, except as described in the LICENSE file.
  */
 
+#include <algorithm>
 #include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <vector>
 
+#include "cpuFeatures.hpp"
 #include "mpduUtility.hpp"
 
 using namespace std;
@@ -104,6 +107,64 @@ TEST(mpduUtility, PackingUnpacking )
   ASSERT_TRUE(same) << "Repacked data doesn't match expected.";
 }
 
+/*!
+ * @brief Repack bit by bit, msb first, left justifying a partial last symbol
+ */
+static std::vector<uint8_t>
+referenceRepack(const std::vector<uint8_t>& in, unsigned int currentBps, unsigned int newBps)
+{
+  std::vector<uint8_t> out((in.size() * currentBps + newBps - 1) / newBps, 0);
+  unsigned int outBit = 0;
+  for (uint8_t symbol : in) {
+    for (unsigned int b = 0; b < currentBps; b++, outBit++) {
+      uint8_t bit = (symbol >> (currentBps - 1 - b)) & 0x01;
+      out[outBit / newBps] |= bit << (newBps - 1 - outBit % newBps);
+    }
+  }
+  return out;
+}
+
+/*!
+ * @brief Test every repacking, in place and to an output vector, against a
+ * bit by bit reference, with every pack and unpack kernel.
+ */
+TEST(mpduUtility, RepackReference )
+{
+  const uint32_t masks[] = { CPUFeatures::NONE, CPUFeatures::BMI2, CPUFeatures::ALL };
+
+  std::srand(36);
+  std::vector<uint8_t> out;
+  for (uint32_t mask : masks) {
+    CPUFeatures::setMask(mask);
+    for (unsigned int currentBps = 1; currentBps <= 8; currentBps++) {
+      for (unsigned int newBps = 1; newBps <= 8; newBps++) {
+        for (size_t count : { 0, 1, 3, 7, 8, 9, 31, 32, 33, 100, 259 }) {
+          // Symbols with junk above their bits, which must be ignored
+          std::vector<uint8_t> in(count);
+          for (auto& s : in) {
+            s = std::rand() & 0xFF;
+          }
+          std::vector<uint8_t> expected = referenceRepack(in, currentBps, newBps);
+          if (currentBps == newBps) {
+            expected = in;
+          }
+
+          MPDUUtility::repack(in, (MPDUUtility::BitsPerSymbol) currentBps,
+            (MPDUUtility::BitsPerSymbol) newBps, out);
+          ASSERT_EQ(out, expected) << currentBps << " to " << newBps << " bps, " << count
+            << " symbols, " << MPDUUtility::packKernelName() << "/" << MPDUUtility::unpackKernelName();
+
+          MPDUUtility::repack(in, (MPDUUtility::BitsPerSymbol) currentBps,
+            (MPDUUtility::BitsPerSymbol) newBps);
+          ASSERT_EQ(in, expected) << currentBps << " to " << newBps << " bps, " << count
+            << " symbols in place";
+        }
+      }
+    }
+  }
+  CPUFeatures::setMask(CPUFeatures::ALL);
+}
+
 /*!
  * @brief Test that the reverse and roll operations work.
  */
@@ -192,3 +253,61 @@ TEST(mpduUtility, check_reverse_roll )
 //  }
 //  ASSERT_TRUE(same) << "Rolled bits don't match expected.";
 }
+
+/*!
+ * @brief Test bit reversal and rolling of packed payloads against handmade
+ * references and a one bit per byte reference for every bits per symbol.
+ */
+TEST(mpduUtility, ReverseRollReference )
+{
+  std::vector<uint8_t> interesting =
+    {0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,
+     0xF0,0xE0,0xD0,0xC0,0xB0,0xA0,0x90,0x80,0x70,0x60,0x50,0x40,0x30,0x20,0x10,0x00};
+  std::vector<uint8_t> reversedInteresting =
+    {0x00,0x08,0x04,0x0C,0x02,0x0A,0x06,0x0E,0x01,0x09,0x05,0x0D,0x03,0x0B,0x07,0x0F,
+     0xF0,0x70,0xB0,0x30,0xD0,0x50,0x90,0x10,0xE0,0x60,0xA0,0x20,0xC0,0x40,0x80,0x00};
+  MPDUUtility::reverse(interesting, MPDUUtility::BPSymb_8, false);
+  ASSERT_EQ(interesting, reversedInteresting) << "Reversed bits don't match expected.";
+
+  std::vector<uint8_t> bytes = {0x55,0xAA,0x00,0xFF};
+  MPDUUtility::reverse(bytes, MPDUUtility::BPSymb_8, true);
+  ASSERT_EQ(bytes, std::vector<uint8_t>({0xFF,0x00,0xAA,0x55})) << "Reversed bytes don't match expected.";
+
+  std::vector<uint8_t> oneBit = {0x00,0x10,0x00,0x00};
+  MPDUUtility::roll(oneBit, MPDUUtility::BPSymb_8, 5, false);
+  ASSERT_EQ(oneBit, std::vector<uint8_t>({0x00,0x00,0x80,0x00})) << "Rolled bits don't match expected.";
+  MPDUUtility::roll(oneBit, MPDUUtility::BPSymb_8, 9, true);
+  ASSERT_EQ(oneBit, std::vector<uint8_t>({0x01,0x00,0x00,0x00})) << "Rolled bits don't match expected.";
+
+  std::srand(37);
+  for (unsigned int bps = 1; bps <= 8; bps++) {
+    for (size_t count : { 1, 3, 7, 8, 9, 17, 33, 100 }) {
+      std::vector<uint8_t> in(count);
+      for (auto& s : in) {
+        s = std::rand() & ((1 << bps) - 1);
+      }
+      std::vector<uint8_t> bits = referenceRepack(in, bps, 1);
+
+      std::vector<uint8_t> reversed = in;
+      MPDUUtility::reverse(reversed, (MPDUUtility::BitsPerSymbol) bps, false);
+      std::vector<uint8_t> expectedBits(bits.rbegin(), bits.rend());
+      ASSERT_EQ(reversed, referenceRepack(expectedBits, 1, bps)) << bps << " bps, " << count << " symbols";
+
+      for (uint32_t numBits : { 1u, 7u, 8u, 13u, 64u, 200u, 1001u }) {
+        for (bool left : { true, false }) {
+          std::vector<uint8_t> rolled = in;
+          MPDUUtility::roll(rolled, (MPDUUtility::BitsPerSymbol) bps, numBits, left);
+          expectedBits = bits;
+          uint32_t shift = numBits % bits.size();
+          if (left) {
+            std::rotate(expectedBits.begin(), expectedBits.begin() + shift, expectedBits.end());
+          } else {
+            std::rotate(expectedBits.begin(), expectedBits.end() - shift, expectedBits.end());
+          }
+          ASSERT_EQ(rolled, referenceRepack(expectedBits, 1, bps)) << bps << " bps, " << count
+            << " symbols, rolled " << numBits << (left ? " left" : " right");
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,123 @@
+/*!
+ * @file qa_ppdu_u8.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the PDU payload handling of the PHY PDU class for
+ * 8-bit data.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "phy_layer/pdu/ppdu_u8.hpp"
+
+using namespace std;
+using namespace ex2::sdr;
+
+#include "gtest/gtest.h"
+
+#define QA_PPDU_U8_DEBUG 0 // set to 1 for debugging output
+
+/*!
+ * @brief Confirm construction moves or copies the payload once
+ */
+TEST(ppdu_u8, Construct)
+{
+  PPDU_u8::payload_t payload = {0x55, 0xAA, 0x00, 0xFF, 0x0F};
+  const PPDU_u8::payload_t original = payload;
+
+  // An rvalue payload is moved, so the PDU has the same storage
+  const uint8_t *storage = payload.data();
+  PPDU_u8 moved(std::move(payload));
+  ASSERT_EQ(moved.data(), storage);
+  ASSERT_EQ(moved.getPayload(), original);
+
+  PPDU_u8 copied(original);
+  ASSERT_NE(copied.data(), original.data());
+  ASSERT_EQ(copied.getPayload(), original);
+
+  // Symbols are masked to their bits per symbol
+  PPDU_u8 fromPointer(original.data(), original.size(), PPDU_u8::BPSymb_4);
+  ASSERT_EQ(fromPointer.getPayload(), PPDU_u8::payload_t({0x05, 0x0A, 0x00, 0x0F, 0x0F}));
+
+  PPDU_u8 fromBits(ConstBitSpan(original.data(), 12, 4), PPDU_u8::BPSymb_8);
+  ASSERT_EQ(fromBits.getPayload(), PPDU_u8::payload_t({0x5A, 0xA0}));
+  ASSERT_EQ(fromBits.bits().size(), 16u);
+}
+
+/*!
+ * @brief Confirm appending really appends, repacking if needed, without
+ * changing the appended PDU
+ */
+TEST(ppdu_u8, Append)
+{
+  PPDU_u8 packed(PPDU_u8::payload_t({0x55, 0xAA}));
+  PPDU_u8 more(PPDU_u8::payload_t({0x0F}));
+  packed.reserve(16);
+  const uint8_t *storage = packed.data();
+  packed.append(more);
+  ASSERT_EQ(packed.getPayload(), PPDU_u8::payload_t({0x55, 0xAA, 0x0F}));
+  ASSERT_EQ(packed.data(), storage);
+
+  // Unpacked symbols are repacked into the packed payload
+  PPDU_u8 unpacked(PPDU_u8::payload_t({1, 0, 1, 1, 0, 0, 1, 0}), PPDU_u8::BPSymb_1);
+  packed.append(unpacked);
+  ASSERT_EQ(packed.getPayload(), PPDU_u8::payload_t({0x55, 0xAA, 0x0F, 0xB2}));
+  ASSERT_EQ(unpacked.getBps(), PPDU_u8::BPSymb_1);
+  ASSERT_EQ(unpacked.payloadLength(), 8u);
+
+  packed.append(packed);
+  ASSERT_EQ(packed.getPayload(), PPDU_u8::payload_t({0x55, 0xAA, 0x0F, 0xB2, 0x55, 0xAA, 0x0F, 0xB2}));
+
+  const uint8_t raw[] = {0x01, 0x02};
+  packed.append(raw, 2);
+  ASSERT_EQ(packed.payloadLength(), 10u);
+  ASSERT_EQ(packed.getPayload().back(), 0x02);
+}
+
+/*!
+ * @brief Confirm an external buffer is used without copying until the
+ * payload is modified, and is never written
+ */
+TEST(ppdu_u8, ExternalBuffer)
+{
+  const uint8_t buffer[] = {0x00, 0x10, 0x00, 0x00};
+  PPDU_u8 ppdu;
+  ppdu.attach(buffer, sizeof(buffer));
+  ASSERT_TRUE(ppdu.isExternal());
+  ASSERT_EQ(ppdu.data(), buffer);
+  ASSERT_EQ(ppdu.payloadLength(), sizeof(buffer));
+
+  ppdu.roll(5, false);
+  ASSERT_FALSE(ppdu.isExternal());
+  ASSERT_EQ(ppdu.getPayload(), PPDU_u8::payload_t({0x00, 0x00, 0x80, 0x00}));
+  ASSERT_EQ(buffer[1], 0x10);
+
+  ppdu.attach(buffer, 2);
+  ppdu.append(buffer + 2, 2);
+  ASSERT_FALSE(ppdu.isExternal());
+  ASSERT_EQ(ppdu.getPayload(), PPDU_u8::payload_t(buffer, buffer + 4));
+
+  ppdu.attach(buffer, sizeof(buffer));
+  ppdu.clearPayload();
+  ASSERT_FALSE(ppdu.isExternal());
+  ASSERT_EQ(ppdu.payloadLength(), 0u);
+
+  // Symbols that fit the bits per symbol are used in place, others are
+  // copied and masked like the constructors do
+  const uint8_t symbols[] = {0x01, 0x03, 0x00, 0x02};
+  PPDU_u8 dibits(PPDU_u8::BitsPerSymbol::BPSymb_2);
+  dibits.attach(symbols, sizeof(symbols));
+  ASSERT_TRUE(dibits.isExternal());
+  dibits.attach(buffer, sizeof(buffer));
+  ASSERT_FALSE(dibits.isExternal());
+  ASSERT_EQ(dibits.getPayload(), PPDU_u8::payload_t({0x00, 0x00, 0x00, 0x00}));
+  ASSERT_EQ(buffer[1], 0x10);
+}
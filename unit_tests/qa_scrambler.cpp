@@ -0,0 +1,119 @@
+/*!
+ * @file qa_scrambler.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the Galois LFSR and the Scrambler class.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include "galoisLFSR.h"
+#include "scrambler.hpp"
+
+using namespace std;
+using namespace ex2::sdr;
+
+#include "gtest/gtest.h"
+
+#define QA_SCRAMBLER_DEBUG 0 // set to 1 for debugging output
+
+/*!
+ * @brief Confirm the polynomials give maximum length sequences
+ */
+TEST(scrambler, LFSRPeriod)
+{
+  for (uint32_t order = 2; order <= 20; order++) {
+    GaloisLFSR lfsr(GaloisLFSR::polynomialForOrder(order), 1);
+    ASSERT_EQ(lfsr.order(), order);
+    uint64_t period = 0;
+    do {
+      lfsr.nextBit();
+      period++;
+    } while (lfsr.state() != 1 && period < (1ull << order));
+    ASSERT_EQ(period, (1ull << order) - 1) << "order " << order;
+  }
+  ASSERT_EQ(GaloisLFSR::polynomialForOrder(16), 0xB400u);
+  ASSERT_EQ(GaloisLFSR::polynomialForOrder(64) >> 63, 1u);
+
+  ASSERT_THROW(GaloisLFSR::polynomialForOrder(1), std::runtime_error);
+  ASSERT_THROW(GaloisLFSR::polynomialForOrder(65), std::runtime_error);
+  ASSERT_THROW(GaloisLFSR(0xB400, 0), std::runtime_error);
+  ASSERT_THROW(GaloisLFSR(0xB400, 0x10000), std::runtime_error);
+}
+
+/*!
+ * @brief Confirm bytes are scrambled msb first by the sequence from the
+ * initial fill, in place or not, and that scrambling again restores them
+ */
+TEST(scrambler, Bytes)
+{
+  std::srand(43);
+  Scrambler scrambler;
+  for (size_t length : {0, 1, 7, 8, 9, 100, 1000, 12345}) {
+    PPDU_u8::payload_t original(length);
+    for (auto& b : original) {
+      b = std::rand() & 0xFF;
+    }
+
+    GaloisLFSR lfsr(GaloisLFSR::polynomialForOrder(16), Scrambler::InitialRegisterFill);
+    PPDU_u8::payload_t expected(original);
+    for (auto& b : expected) {
+      for (int bit = 7; bit >= 0; bit--) {
+        b ^= lfsr.nextBit() << bit;
+      }
+    }
+
+    PPDU_u8::payload_t scrambled;
+    scrambler.scramble(original, scrambled);
+    ASSERT_EQ(scrambled, expected) << length << " bytes";
+
+    scrambler.scramble(scrambled, scrambled);
+    ASSERT_EQ(scrambled, original) << length << " bytes";
+  }
+}
+
+/*!
+ * @brief Confirm float and complex samples have their signs flipped where
+ * the sequence bit is one
+ */
+TEST(scrambler, Samples)
+{
+  std::srand(44);
+  Scrambler scrambler;
+  for (size_t length : {0, 5, 8, 13, 1001}) {
+    std::vector<float> original(length);
+    std::vector<std::complex<float>> originalComplex(length);
+    for (size_t i = 0; i < length; i++) {
+      original[i] = (std::rand() % 2001 - 1000) / 100.0f;
+      originalComplex[i] = std::complex<float>(original[i], -2.0f * original[i]);
+    }
+
+    GaloisLFSR lfsr(GaloisLFSR::polynomialForOrder(16), Scrambler::InitialRegisterFill);
+    std::vector<float> scrambled;
+    std::vector<std::complex<float>> scrambledComplex;
+    scrambler.scramble(original, scrambled);
+    scrambler.scramble(originalComplex, scrambledComplex);
+    ASSERT_EQ(scrambled.size(), length);
+    ASSERT_EQ(scrambledComplex.size(), length);
+    for (size_t i = 0; i < length; i++) {
+      float sign = lfsr.nextBit() ? -1.0f : 1.0f;
+      ASSERT_EQ(scrambled[i], sign * original[i]) << "sample " << i;
+      ASSERT_EQ(scrambledComplex[i], sign * originalComplex[i]) << "sample " << i;
+    }
+
+    scrambler.scramble(scrambled, scrambled);
+    scrambler.scramble(scrambledComplex, scrambledComplex);
+    ASSERT_EQ(scrambled, original);
+    ASSERT_EQ(scrambledComplex, originalComplex);
+  }
+}
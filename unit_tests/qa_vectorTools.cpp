@@ -0,0 +1,138 @@
+/*!
+ * @file qa_vectorTools.cpp
+ * @author AlbertaSat
+ * @date October 19, 2026
+ *
+ * @details Unit test for the vector tools.
+ *
+ * @copyright AlbertaSat 2026
+ *
+ * @license
+ * This software may not be modified or distributed in any form, except as described in the LICENSE file.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "cpuFeatures.hpp"
+#include "vectorTools.h"
+
+using namespace std;
+using namespace ex2::sdr;
+
+#include "gtest/gtest.h"
+
+#define QA_VECTOR_TOOLS_DEBUG 0 // set to 1 for debugging output
+
+/*!
+ * @brief Confirm every slicer implementation available on this CPU packs
+ * the thresholded floats in either bit order, including partial bytes,
+ * values equal to the threshold and NaNs
+ */
+TEST(vectorTools, FloatToBytes)
+{
+  std::srand(44);
+  float const threshold = 0.25f;
+  for (size_t length : {0, 1, 7, 8, 9, 31, 32, 33, 70, 1001}) {
+    std::vector<float> in(length);
+    for (auto& f : in) {
+      int r = std::rand() % 10;
+      f = (r == 0) ? threshold : (r == 1) ? NAN : (std::rand() % 2001 - 1000) / 1000.0f;
+    }
+
+    for (bool reverseBitOrder : {false, true}) {
+      std::vector<uint8_t> expected((length + 7) / 8, 0);
+      for (size_t i = 0; i < length; i++) {
+        if (in[i] > threshold) {
+          expected[i / 8] |= reverseBitOrder ? (1 << (i % 8)) : (0x80 >> (i % 8));
+        }
+      }
+
+      for (uint32_t mask : {(uint32_t) CPUFeatures::NONE, (uint32_t) CPUFeatures::SSE2,
+        (uint32_t) CPUFeatures::ALL}) {
+        CPUFeatures::setMask(mask);
+#if QA_VECTOR_TOOLS_DEBUG
+        printf("length %zu slicer %s\n", length, VectorTools::floatToBytesKernelName());
+#endif
+        std::vector<uint8_t> out(3, 0xFF);
+        VectorTools::floatToBytes(threshold, reverseBitOrder, in, out);
+        ASSERT_EQ(out, expected) << "length " << length << " slicer "
+          << VectorTools::floatToBytesKernelName();
+      }
+    }
+  }
+  CPUFeatures::setMask(CPUFeatures::ALL);
+}
+
+/*!
+ * @brief Confirm every expansion implementation available on this CPU maps
+ * bits to floats in either order, packed or not, with and without NRZ
+ */
+TEST(vectorTools, BytesToFloat)
+{
+  std::srand(45);
+  std::vector<uint8_t> in(77);
+  for (auto& b : in) {
+    b = std::rand() & 0xFF;
+  }
+
+  for (bool packed : {false, true}) {
+    for (bool lsbFirst : {false, true}) {
+      for (bool nrz : {false, true}) {
+        float const magnitude = 0.75f;
+        std::vector<float> expected;
+        for (uint8_t byte : in) {
+          for (int b = 0; b < (packed ? 8 : 1); b++) {
+            int bit = lsbFirst ? (byte >> b) & 0x01 : (byte >> (7 - b)) & 0x01;
+            expected.push_back(bit ? magnitude : (nrz ? -magnitude : 0.0f));
+          }
+        }
+
+        for (uint32_t mask : {(uint32_t) CPUFeatures::NONE, (uint32_t) CPUFeatures::SSE2,
+          (uint32_t) CPUFeatures::ALL}) {
+          CPUFeatures::setMask(mask);
+          std::vector<float> out(5, 1.0f);
+          VectorTools::bytesToFloat(in, packed, lsbFirst, nrz, magnitude, out);
+          ASSERT_EQ(out, expected) << "packed " << packed << " lsbFirst " << lsbFirst
+            << " nrz " << nrz << " kernel " << VectorTools::bytesToFloatKernelName();
+        }
+      }
+    }
+  }
+  CPUFeatures::setMask(CPUFeatures::ALL);
+}
+
+/*!
+ * @brief Confirm every block reversal implementation available on this CPU
+ * reverses blocks of any size
+ */
+TEST(vectorTools, BlockReverse)
+{
+  std::vector<float> v(720);
+  for (size_t i = 0; i < v.size(); i++) {
+    v[i] = (float) i;
+  }
+
+  for (uint32_t blockSize : {1, 2, 3, 4, 5, 8, 9, 12, 15, 16, 20, 24, 36, 40, 45, 48, 72, 120, 720}) {
+    std::vector<float> expected(v);
+    for (size_t i = 0; i < expected.size(); i += blockSize) {
+      std::reverse(expected.begin() + i, expected.begin() + i + blockSize);
+    }
+
+    for (uint32_t mask : {(uint32_t) CPUFeatures::NONE, (uint32_t) CPUFeatures::SSE2,
+      (uint32_t) CPUFeatures::ALL}) {
+      CPUFeatures::setMask(mask);
+      std::vector<float> reversed(v);
+      VectorTools::blockReverse(blockSize, reversed);
+      ASSERT_EQ(reversed, expected) << "blockSize " << blockSize << " kernel "
+        << VectorTools::blockReverseKernelName();
+    }
+  }
+  CPUFeatures::setMask(CPUFeatures::ALL);
+
+  ASSERT_THROW(VectorTools::blockReverse(7, v), std::exception);
+  ASSERT_THROW(VectorTools::blockReverse(0, v), std::exception);
+}
@@ -12,6 +12,7 @@
  * This software may not be modified or distributed in any form, except as described in the LICENSE file.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <iostream>
 #include <random>
@@ -20,6 +21,7 @@
 #include <stdlib.h>
 
 #include "viterbi.hpp"
+#include "cpuFeatures.hpp"
 #include "viterbi-utils.h"
 
 using namespace std;
@@ -224,3 +226,157 @@ TEST(Viterbi, Cassini)
     TestViterbiCodecAutomatic(codec);
 }
 #endif
+
+TEST(Viterbi, DecodeParallel)
+{
+  /* ----------------------------------------------------------------------
+   * Confirm overlapped block decoding of a long input matches the serial
+   * decoder, independent of the block length and number of threads
+   * ----------------------------------------------------------------------
+   */
+    ViterbiCodec codec(7, {121, 91});
+
+    std::srand(27);
+    auto message = _gen_message(20000);
+    auto encoded = codec.encode(message);
+
+    // Error free, including inputs shorter than one block
+    ASSERT_EQ(codec.decodeParallel(encoded, 1024, 4), message);
+    ASSERT_EQ(codec.decodeParallel(encoded, 0, 4), message);
+    auto shortMessage = _gen_message(100);
+    ASSERT_EQ(codec.decodeParallel(codec.encode(shortMessage), 1024, 4), shortMessage);
+    ASSERT_EQ(codec.decodeParallel(ViterbiCodec::bitarr_t()).size(), 0);
+
+    // add 3% errors
+    unsigned int nerr = encoded.size() * 0.03;
+    for (size_t i = 0; i < nerr; i++) {
+        int idx = rand() % encoded.size();
+        encoded[idx] = (encoded[idx] == 0) ? (1) : (0);
+    }
+
+    auto serial = codec.decode(encoded);
+    for (unsigned int blockLength : {512, 1024, 4096}) {
+      for (unsigned int numThreads : {1, 2, 4}) {
+        auto parallel = codec.decodeParallel(encoded, blockLength, numThreads);
+        ASSERT_EQ(parallel.size(), serial.size());
+        EXPECT_EQ(parallel, serial) << "blockLength " << blockLength << " numThreads " << numThreads;
+      }
+    }
+}
+
+TEST(Viterbi, ACSKernels)
+{
+  /* ----------------------------------------------------------------------
+   * Confirm every add-compare-select implementation available on this CPU
+   * gives the same result as the scalar one, including for erased bits and
+   * state counts too small for the SIMD kernels
+   * ----------------------------------------------------------------------
+   */
+    std::srand(28);
+    for (int k : {3, 6, 7, 9}) {
+      ViterbiCodec codec(k, {(1 << k) - 1, (1 << (k - 1)) + 1});
+      auto encoded = codec.encode(_gen_message(4000));
+
+      // add 4% errors and 5% erasures
+      for (size_t i = 0; i < encoded.size(); i++) {
+        int r = rand() % 100;
+        if (r < 4) {
+          encoded[i] = (encoded[i] == 0) ? (1) : (0);
+        }
+        else if (r < 9) {
+          encoded[i] = ViterbiCodec::ERASED_BIT;
+        }
+      }
+
+      CPUFeatures::setMask(CPUFeatures::NONE);
+      ASSERT_STREQ(ViterbiCodec::acsKernelName(), "scalar");
+      auto scalar = codec.decode(encoded);
+      auto scalarTruncated = codec.decodeTruncated(encoded);
+
+      for (uint32_t mask : {(uint32_t) CPUFeatures::SSE2, (uint32_t) CPUFeatures::ALL}) {
+        CPUFeatures::setMask(mask);
+#if QA_VITERBI_DEBUG
+        printf("K = %d ACS kernel %s\n", k, ViterbiCodec::acsKernelName());
+#endif
+        ASSERT_EQ(codec.decode(encoded), scalar);
+        ASSERT_EQ(codec.decodeTruncated(encoded), scalarTruncated);
+      }
+    }
+    CPUFeatures::setMask(CPUFeatures::ALL);
+}
+
+/*!
+ * @brief Confirm encoding packed bits matches encoding one bit per byte, for
+ * messages that are not a whole number of bytes
+ */
+TEST(Viterbi, EncodeBits)
+{
+  std::srand(38);
+  ViterbiCodec codec(7, {109, 79});
+  for (int numBits : {0, 1, 8, 13, 324, 1000}) {
+    ViterbiCodec::bitarr_t message = _gen_message(numBits);
+    ViterbiCodec::bitarr_t encoded = codec.encode(message);
+
+    BitBuffer packedMessage;
+    for (auto bit : message) {
+      packedMessage.append((bool) bit);
+    }
+    BitBuffer packedEncoded = codec.encodeBits(packedMessage);
+    ASSERT_EQ(packedEncoded.size(), encoded.size());
+    for (size_t i = 0; i < encoded.size(); i++) {
+      ASSERT_EQ(packedEncoded[i], encoded[i] != 0) << numBits << " bits, bit " << i;
+    }
+    if (numBits % 8 == 0) {
+      ASSERT_EQ(codec.encodePacked(packedMessage.bytes()), packedEncoded.bytes());
+    }
+  }
+}
+
+/*!
+ * @brief Confirm the list decoder puts the maximum likelihood path first,
+ * returns distinct alternatives, and that an alternative is the message when
+ * the most likely path is not
+ */
+TEST(Viterbi, DecodeList)
+{
+  std::srand(42);
+  ViterbiCodec codec(7, {121, 91});
+
+  // Error free; the alternatives are distinct and all wrong
+  auto message = _gen_message(400);
+  auto encoded = codec.encode(message);
+  auto decodedList = codec.decodeList(encoded, 8);
+  ASSERT_EQ(decodedList.size(), 8);
+  ASSERT_EQ(decodedList.front(), message);
+  for (size_t a = 1; a < decodedList.size(); a++) {
+    ASSERT_EQ(decodedList[a].size(), message.size());
+    for (size_t b = 0; b < a; b++) {
+      ASSERT_NE(decodedList[a], decodedList[b]);
+    }
+  }
+  ASSERT_EQ(codec.decodeList(encoded, 0).size(), 1);
+  ASSERT_EQ(codec.decodeList(ViterbiCodec::bitarr_t(), 8).size(), 1);
+
+  // With errors, the first is the same as the full traceback decoder
+  unsigned int recovered = 0;
+  for (int trial = 0; trial < 200; trial++) {
+    message = _gen_message(200);
+    encoded = codec.encode(message);
+    // add 7% errors
+    for (size_t i = 0; i < encoded.size(); i++) {
+      if (rand() % 100 < 7) {
+        encoded[i] = (encoded[i] == 0) ? (1) : (0);
+      }
+    }
+    decodedList = codec.decodeList(encoded, 8);
+    ASSERT_EQ(decodedList.front(), codec.decode(encoded));
+    if (decodedList.front() != message &&
+      std::find(decodedList.begin(), decodedList.end(), message) != decodedList.end()) {
+      recovered++;
+    }
+  }
+#if QA_VITERBI_DEBUG
+  printf("recovered %u of 200\n", recovered);
+#endif
+  ASSERT_GT(recovered, 0u);
+}